@@ -0,0 +1,10 @@
+// Read-only lookups - array indexing, indexOf and named member access
+
+var a = [];
+for (i=0;i<200;i++) a.push("item"+i);
+var o = { alpha:1, beta:2, gamma:3, delta:4, epsilon:5 };
+
+var n = 0;
+for (i=0;i<200;i++) {
+  n += a[i].length + a.indexOf("item"+(199-i)) + o.epsilon;
+}
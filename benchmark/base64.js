@@ -0,0 +1,9 @@
+// base64 and URI encoding of a few KB of binary data
+
+var data = new Uint8Array(3000);
+for (i=0;i<data.length;i++) data[i] = i*7;
+var s = E.toString(data);
+
+var b = btoa(s);
+var d = atob(b);
+var u = encodeURIComponent(s.substr(0,1000).replace("\xff",""));
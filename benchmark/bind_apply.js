@@ -0,0 +1,13 @@
+// Callback-style code - calling bound native and JS functions, and apply/call
+
+var o = { n:0, add:function(a,b) { this.n += a+b; } };
+var add = o.add.bind(o, 1);
+var push = [].push.bind([]);
+var args = [1,2];
+
+for (i=0;i<500;i++) {
+  add(i);
+  push(i, i);
+  o.add.apply(o, args);
+  Math.max.apply(null, args);
+}
@@ -0,0 +1,10 @@
+// Lots of small calls into builtins, so the cost is mostly argument conversion and dispatch.
+// The functions are looked up once, so symbol table searches don't dominate.
+
+var sin = Math.sin, pow = Math.pow, abs = Math.abs, clip = E.clip;
+var read = digitalRead, nan = isNaN, pi = parseInt;
+var n = 0;
+for (var i=0;i<20000;i++) {
+  n += sin(i) + pow(2, 3) + abs(-i) + clip(i, 0, 100);
+  n += read(D1) + nan(n) + pi("12", 10);
+}
@@ -0,0 +1,9 @@
+// Built-in methods called directly on an object, so each call has to find the method first.
+// Previously a function variable was allocated (and freed) for every call.
+
+var a = [], s = "Hello World", n = 0;
+for (var i=0;i<10000;i++) {
+  a.push(i);
+  n += Math.abs(-i) + Math.floor(i/2) + s.indexOf("W") + s.charCodeAt(1);
+  a.pop();
+}
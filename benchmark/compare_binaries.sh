@@ -0,0 +1,42 @@
+#!/bin/bash
+# This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# ----------------------------------------------------------------------------------------
+# Time every benchmark in this directory with two different Linux builds, eg:
+#
+#   make && cp espruino /tmp/espruino_blocks
+#   rm src/jsvar.o && make MMAP_JSVARS=1 && cp espruino /tmp/espruino_mmap
+#   benchmark/compare_binaries.sh /tmp/espruino_blocks /tmp/espruino_mmap
+# ----------------------------------------------------------------------------------------
+
+if [ $# -ne 2 ]; then
+  echo "USAGE: $0 espruino_a espruino_b"
+  exit 1
+fi
+
+DIR=`dirname $0`
+RUNS=${RUNS:-3}
+
+# Best of $RUNS, in milliseconds
+function run_benchmark {
+  BEST=""
+  for i in `seq $RUNS`; do
+    START=`date +%s%N`
+    $1 $2 < /dev/null > /dev/null 2>&1
+    END=`date +%s%N`
+    T=$(( (END - START) / 1000000 ))
+    if [ -z "$BEST" ] || [ $T -lt $BEST ]; then BEST=$T; fi
+  done
+  echo $BEST
+}
+
+printf "%-24s %16s %16s\n" "Benchmark (ms)" `basename $1` `basename $2`
+for BENCH in $DIR/*.js; do
+  A=`run_benchmark $1 $BENCH`
+  B=`run_benchmark $2 $BENCH`
+  printf "%-24s %16d %16d\n" `basename $BENCH` $A $B
+done
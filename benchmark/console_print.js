@@ -0,0 +1,5 @@
+// Log lots of lines to the console. On Linux, console output is buffered and
+// flushed when idle rather than for every character.
+
+for (var i=0;i<2000;i++)
+  console.log("Reading", i, "temperature", 21.5, "status ok");
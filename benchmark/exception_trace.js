@@ -0,0 +1,57 @@
+// Validation with try/catch, where the exception unwinds through a few large functions.
+// Each frame used to search its function's source for line numbers as it unwound, even though the trace is never printed.
+
+function check(v) {
+  if (typeof v != "number") throw new Error("not a number");
+  return v;
+}
+
+function parseRecord(rec) {
+  // a reasonably large function, as you'd have in a real application
+  var out = {};
+  out.a = check(rec.a); // field a
+  out.b = check(rec.b); // field b
+  out.c = check(rec.c); // field c
+  out.d = check(rec.d); // field d
+  out.e = check(rec.e); // field e
+  out.f = check(rec.f); // field f
+  out.g = check(rec.g); // field g
+  out.h = check(rec.h); // field h
+  out.i = check(rec.i); // field i
+  out.j = check(rec.j); // field j
+  out.k = check(rec.k); // field k
+  out.l = check(rec.l); // field l
+  out.m = check(rec.m); // field m
+  out.n = check(rec.n); // field n
+  out.o = check(rec.o); // field o
+  out.p = check(rec.p); // field p
+  out.q = check(rec.q); // field q
+  out.r = check(rec.r); // field r
+  out.s = check(rec.s); // field s
+  out.t = check(rec.t); // field t
+  out.u = check(rec.u); // field u
+  out.v = check(rec.v); // field v
+  out.w = check(rec.w); // field w
+  out.x = check(rec.x); // field x
+  out.y = check(rec.y); // field y
+  out.z = check(rec.z); // field z - this one is missing in bad records
+  return out;
+}
+
+function parseAll(recs) {
+  var good = 0;
+  for (var i in recs) {
+    try {
+      parseRecord(recs[i]);
+      good++;
+    } catch (e) {
+      // invalid record - just skip it
+    }
+  }
+  return good;
+}
+
+var rec = {a:1,b:2,c:3,d:4,e:5,f:6,g:7,h:8,i:9,j:10,k:11,l:12,m:13,n:14,o:15,p:16,q:17,r:18,s:19,t:20,u:21,v:22,w:23,x:24,y:25};
+var recs = [];
+for (var i=0;i<200;i++) recs.push(rec);
+var good = parseAll(recs);
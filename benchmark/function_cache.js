@@ -0,0 +1,14 @@
+// Building the same function repeatedly from received/concatenated text, like a rule engine would.
+// The Function cache only saves memory here (the functions share one copy of the code) - it
+// doesn't make building or calling them any faster.
+
+var body = "";
+for (i=0;i<20;i++) body += "a*2+b*3-(a+b)/2+";
+body = "return " + body + "1";
+
+var fns = [], n = 0;
+for (i=0;i<200;i++) {
+  var f = new Function("a","b", body.substr(0,7) + body.substr(7));
+  if (fns.length<50) fns.push(f);
+  n += f(i, 4);
+}
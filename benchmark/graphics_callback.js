@@ -0,0 +1,38 @@
+// Draw text, lines and polygons on a display whose driver is written in JS.
+// Like most LCD controllers, the driver sends one 'fill window' command per
+// call - compare calling JS for every pixel with batched 'fillRects' callbacks.
+
+var W = 128, H = 64;
+var cmd = new Uint8Array(5), commands = 0;
+function fillWindow(x1,y1,x2,y2,col) {
+  cmd[0]=x1; cmd[1]=y1; cmd[2]=x2; cmd[3]=y2; cmd[4]=col; // eg. SPI1.write(cmd)
+  commands++;
+}
+
+function draw(g) {
+  for (var i=0;i<10;i++) {
+    g.clear();
+    g.drawString("Temperature 21.5C", 2, 2);
+    g.drawString("Humidity 48%", 2, 10);
+    g.drawLine(0, 20, 127, 63);
+    g.fillPoly([64,20, 120,40, 80,60]);
+    g.fillRect(2, 30, 40, 50);
+  }
+}
+
+var perPixel = Graphics.createCallback(W,H,1,{
+  setPixel:function(x,y,c) { fillWindow(x,y,x,y,c); },
+  fillRect:function(x1,y1,x2,y2,c) { fillWindow(x1,y1,x2,y2,c); }
+});
+var batched = Graphics.createCallback(W,H,1,{fillRects:function(r,n) {
+  for (var i=0;i<n*5;i+=5)
+    fillWindow(r[i],r[i+1],r[i+2],r[i+3],r[i+4]);
+}});
+
+var t = getTime();
+draw(perPixel);
+console.log("setPixel  ", Math.round((getTime()-t)*1000), "ms", commands, "commands");
+commands = 0;
+t = getTime();
+draw(batched);
+console.log("fillRects ", Math.round((getTime()-t)*1000), "ms", commands, "commands");
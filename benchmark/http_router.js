@@ -0,0 +1,22 @@
+// An HTTP server with several small endpoints, routed natively with httpSrv.route.
+// Requests are made one after the other, and the request fields are only created
+// if a handler uses them.
+
+var http = require("http");
+var server = http.createServer();
+server.route("GET", "/", function(req, res) { res.end("index"); });
+server.route("GET", "/status", function(req, res) { res.end("ok"); });
+server.route("GET", "/led/:state", function(req, res) { res.end(req.params.state); });
+server.route("GET", "/temp", function(req, res) { res.end("21"); });
+server.route("POST", "/config", function(req, res) { res.end("saved"); });
+server.listen(8080);
+
+var paths = ["/", "/status", "/led/on", "/temp", "/led/off"];
+var count = 0;
+function next() {
+  if (count >= 200) { server.close(); return; }
+  http.get("http://localhost:8080"+paths[count++ % paths.length], function(res) {
+    res.on('close', next);
+  });
+}
+next();
@@ -0,0 +1,20 @@
+// Functions that build the same shaped objects and constant tables each time they're called.
+// Constant literals are copied from a cached template, and other object literals reuse a cached key list.
+
+function point(x, y) {
+  return { x: x, y: y, visible: true, colour: "red", size: 2 };
+}
+
+function table() {
+  return [0, 0.38, 0.71, 0.92, 1, 0.92, 0.71, 0.38, 0, -0.38, -0.71, -0.92, -1, -0.92, -0.71, -0.38];
+}
+
+function config() {
+  return { mode: "fast", retries: 3, pins: [1, 2, 3], flags: { a: true, b: false } };
+}
+
+var sum = 0;
+for (var i=0;i<5000;i++) {
+  var p = point(i, i*2);
+  sum += p.x + p.y + table()[i&15] + config().pins.length;
+}
@@ -0,0 +1,43 @@
+// Map/Set compared with the Object and Array.indexOf emulations people use without them.
+// Each test adds N string keys, then looks every one of them up again.
+
+function time(name, n, fn) {
+  var t = getTime();
+  fn(n);
+  print(name+" x"+n+": "+Math.round((getTime()-t)*1000)+"ms");
+}
+
+function useMap(n) {
+  var m = new Map();
+  for (var i=0;i<n;i++) m.set("k"+i, i);
+  var sum = 0;
+  for (var i=0;i<n;i++) sum += m.get("k"+i);
+}
+
+function useObject(n) {
+  var m = {};
+  for (var i=0;i<n;i++) m["k"+i] = i;
+  var sum = 0;
+  for (var i=0;i<n;i++) sum += m["k"+i];
+}
+
+function useSet(n) {
+  var s = new Set();
+  for (var i=0;i<n;i++) s.add("k"+i);
+  var found = 0;
+  for (var i=0;i<n;i++) if (s.has("k"+i)) found++;
+}
+
+function useArray(n) {
+  var s = [];
+  for (var i=0;i<n;i++) if (s.indexOf("k"+i)<0) s.push("k"+i);
+  var found = 0;
+  for (var i=0;i<n;i++) if (s.indexOf("k"+i)>=0) found++;
+}
+
+[100,1000,10000].forEach(function(n) {
+  time("Map   ", n, useMap);
+  time("Object", n, useObject);
+  time("Set   ", n, useSet);
+  time("Array ", n, useArray);
+});
@@ -0,0 +1,33 @@
+// Open 1000 loopback connections at once and wait until every one has been
+// accepted and answered. The server drains all waiting connections (up to
+// its maxAccept budget) each time round the idle loop, and the listen
+// backlog is big enough that the kernel doesn't refuse any of them.
+
+var net = require("net");
+var COUNT = 1000;
+var answered = 0, failed = 0;
+var start = Date.now();
+
+var server = net.createServer(function(c) {
+  c.write("ok");
+  c.end();
+});
+server.listen(4450, {backlog:1024, maxAccept:256});
+
+function connect() {
+  var client = net.connect({host:"127.0.0.1", port:4450}, function() {
+    client.on('data', function(data) {
+      if (++answered + failed == COUNT) finish();
+    });
+  });
+  client.on('error', function() {
+    if (answered + ++failed == COUNT) finish();
+  });
+}
+
+function finish() {
+  server.close();
+  console.log(answered+" answered, "+failed+" failed in "+(Date.now()-start)+"ms");
+}
+
+for (var i=0;i<COUNT;i++) connect();
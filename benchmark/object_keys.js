@@ -0,0 +1,7 @@
+// Object.keys on a large lookup table
+
+var o = {};
+for (i=0;i<300;i++) o["key"+i] = i;
+
+var n = 0;
+for (i=0;i<5;i++) n += Object.keys(o).length;
@@ -0,0 +1,8 @@
+// Template rendering - lots of '+' chains on temporary strings
+
+function row(i) {
+  return "<tr><td>" + i + "</td><td>" + (i*i) + "</td><td>" + "Some text for row " + i + "</td></tr>\n";
+}
+
+var s = "";
+for (i=0;i<200;i++) s += row(i);
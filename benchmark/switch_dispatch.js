@@ -0,0 +1,45 @@
+// A protocol decoder style switch with lots of literal case labels.
+// Each dispatch used to evaluate every label before the match, and lex the rest of the body after it.
+
+function decode(cmd) {
+  var n = 0;
+  switch (cmd) {
+    case 0: n += 0; break;
+    case 1: n += 1; break;
+    case 2: n += 2; break;
+    case 3: n += 3; break;
+    case 4: n += 4; break;
+    case 5: n += 5; break;
+    case 6: n += 6; break;
+    case 7: n += 0; break;
+    case 8: n += 1; break;
+    case 9: n += 2; break;
+    case 10: n += 3; break;
+    case 11: n += 4; break;
+    case 12: n += 5; break;
+    case 13: n += 6; break;
+    case 14: n += 0; break;
+    case 15: n += 1; break;
+    case 16: n += 2; break;
+    case 17: n += 3; break;
+    case 18: n += 4; break;
+    case 19: n += 5; break;
+    case 20: n += 6; break;
+    case 21: n += 0; break;
+    case 22: n += 1; break;
+    case 23: n += 2; break;
+    case 24: n += 3; break;
+    case 25: n += 4; break;
+    case 26: n += 5; break;
+    case 27: n += 6; break;
+    case 28: n += 0; break;
+    case 29: n += 1; break;
+    case 30: n += 2; break;
+    case 31: n += 3; break;
+    default: n = -1;
+  }
+  return n;
+}
+
+var total = 0;
+for (var i=0;i<3000;i++) total += decode(i&31);
@@ -0,0 +1,12 @@
+// Copying and converting between typed arrays - set(), construction from another typed array, and slice()
+
+var f = new Float32Array(2000);
+for (var i=0;i<f.length;i++) f[i] = Math.sin(i)*300;
+var u = new Uint8ClampedArray(2000);
+var w = new Int16Array(2000);
+for (var n=0;n<200;n++) {
+  u.set(f);
+  w.set(u);
+  var c = new Float64Array(w);
+  var s = w.slice(100, 1900);
+}
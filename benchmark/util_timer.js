@@ -0,0 +1,34 @@
+// Util timer accuracy and throughput on a host: edges are scheduled with digitalPulse
+// and timestamped by setWatch, so the error is how late each task ran.
+
+var PULSES = 200;
+var edges = [];
+setWatch(function(e) { edges.push(e.time); }, D3, {repeat:true, edge:"both"});
+
+function report(name, width) {
+  var worst = 0, total = 0;
+  for (var i=1;i<edges.length;i++) {
+    var err = Math.abs((edges[i]-edges[i-1])*1000 - width);
+    total += err;
+    if (err>worst) worst = err;
+  }
+  print(name+": "+edges.length+" edges, mean error "+(total*1000/(edges.length-1)).toFixed(1)+
+        "us, worst "+(worst*1000).toFixed(1)+"us");
+  edges = [];
+}
+
+// jitter: 1ms pulses
+var t = new Array(PULSES);
+t.fill(1);
+digitalPulse(D3, 1, t);
+setTimeout(function() {
+  report("1ms pulses", 1);
+  // throughput: pulses as short as the timer can manage
+  var start = getTime();
+  t.fill(0.02);
+  digitalPulse(D3, 1, t);
+  digitalPulse(D3, 1, 0);
+  var took = getTime()-start;
+  print("20us pulses: "+PULSES+" tasks in "+(took*1000).toFixed(1)+"ms, "+(PULSES/took).toFixed(0)+" tasks/sec");
+  setTimeout(function() { report("20us pulses", 0.02); clearWatch(); }, 50);
+}, PULSES+50);
@@ -0,0 +1,2832 @@
+// Automatically generated wrapper file 
+// Generated by scripts/build_jswrapper.py
+
+#include "jswrapper.h"
+#include "jsnative.h"
+#include "src/jswrap_array.h"
+#include "src/jswrap_arraybuffer.h"
+#include "src/jswrap_date.h"
+#include "src/jswrap_error.h"
+#include "src/jswrap_espruino.h"
+#include "src/jswrap_flash.h"
+#include "src/jswrap_functions.h"
+#include "src/jswrap_interactive.h"
+#include "src/jswrap_io.h"
+#include "src/jswrap_json.h"
+#include "src/jswrap_map.h"
+#include "src/jswrap_modules.h"
+#include "src/jswrap_pin.h"
+#include "src/jswrap_number.h"
+#include "src/jswrap_object.h"
+#include "src/jswrap_onewire.h"
+#include "src/jswrap_pipe.h"
+#include "src/jswrap_process.h"
+#include "src/jswrap_promise.h"
+#include "src/jswrap_serial.h"
+#include "src/jswrap_spi_i2c.h"
+#include "src/jswrap_stream.h"
+#include "src/jswrap_string.h"
+#include "src/jswrap_waveform.h"
+#include "libs/filesystem/jswrap_fs.h"
+#include "libs/filesystem/jswrap_file.h"
+#include "libs/math/jswrap_math.h"
+#include "libs/graphics/jswrap_graphics.h"
+#include "libs/network/jswrap_net.h"
+#include "libs/network/http/jswrap_http.h"
+#include "libs/network/js/jswrap_jsnetwork.h"
+#include "libs/network/telnet/jswrap_telnet.h"
+#include "libs/hashlib/jswrap_hashlib.h"
+#include "libs/crypto/jswrap_crypto.h"
+
+
+// -----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------- AUTO-GENERATED WRAPPERS
+// -----------------------------------------------------------------------------------------
+
+static JsVar* gen_jswrap_Array_pop(JsVar *parent) {
+  return jsvArrayPop(parent);
+}
+
+static bool gen_jswrap_Array_isArray(JsVar* var) {
+  return jsvIsArray(var);
+}
+
+static JsVar* gen_jswrap_Uint8Array_Uint8Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint8ClampedArray_Uint8ClampedArray(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int8Array_Int8Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT8, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint16Array_Uint16Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT16, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int16Array_Int16Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT16, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint32Array_Uint32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int32Array_Int32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Float32Array_Float32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_FLOAT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Float64Array_Float64Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_FLOAT64, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_ArrayBufferView_buffer(JsVar *parent) {
+  return jsvLock(jsvGetFirstChild(parent));
+}
+
+static JsVarInt gen_jswrap_ArrayBufferView_byteLength(JsVar *parent) {
+  return (JsVarInt)(parent->varData.arraybuffer.length * JSV_ARRAYBUFFER_GET_SIZE(parent->varData.arraybuffer.type));
+}
+
+static JsVarInt gen_jswrap_ArrayBufferView_byteOffset(JsVar *parent) {
+  return parent->varData.arraybuffer.byteOffset;
+}
+
+static JsVarFloat gen_jswrap_E_getTemperature() {
+  return jshReadTemperature();
+}
+
+static JsVarFloat gen_jswrap_E_getAnalogVRef() {
+  return jshReadVRef();
+}
+
+static JsVar* gen_jswrap_global() {
+  return jsvLockAgain(execInfo.root);
+}
+
+static void gen_jswrap_dump() {
+  jsiDumpState((vcbprintf_callback)jsiConsolePrintString, 0);
+}
+
+static void gen_jswrap_load() {
+  jsiStatus|=JSIS_TODO_FLASH_LOAD;;
+}
+
+static void gen_jswrap_save() {
+  jsiStatus|=JSIS_TODO_FLASH_SAVE;;
+}
+
+static void gen_jswrap_reset() {
+  jsiStatus|=JSIS_TODO_RESET;;
+}
+
+static JsVarFloat gen_jswrap_getTime() {
+  return (JsVarFloat)jshGetSystemTime() / (JsVarFloat)jshGetTimeFromMilliseconds(1000);
+}
+
+static JsVar* gen_jswrap_peek8(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,1);
+}
+
+static void gen_jswrap_poke8(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,1);
+}
+
+static JsVar* gen_jswrap_peek16(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,2);
+}
+
+static void gen_jswrap_poke16(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,2);
+}
+
+static JsVar* gen_jswrap_peek32(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,4);
+}
+
+static void gen_jswrap_poke32(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,4);
+}
+
+static JsVarFloat gen_jswrap_NaN() {
+  return NAN;
+}
+
+static JsVarFloat gen_jswrap_Infinity() {
+  return INFINITY;
+}
+
+static JsVarFloat gen_jswrap_Number_NaN() {
+  return NAN;
+}
+
+static JsVarFloat gen_jswrap_Number_MAX_VALUE() {
+  return DBL_MAX;
+}
+
+static JsVarFloat gen_jswrap_Number_MIN_VALUE() {
+  return DBL_MIN;
+}
+
+static JsVarFloat gen_jswrap_Number_NEGATIVE_INFINITY() {
+  return -INFINITY;
+}
+
+static JsVarFloat gen_jswrap_Number_POSITIVE_INFINITY() {
+  return INFINITY;
+}
+
+static int gen_jswrap_HIGH() {
+  return 1;
+}
+
+static int gen_jswrap_LOW() {
+  return 0;
+}
+
+static JsVar* gen_jswrap_Object_keys(JsVar* object) {
+  return jswrap_object_keys_or_property_names(object, false, false);
+}
+
+static JsVar* gen_jswrap_Object_getOwnPropertyNames(JsVar* object) {
+  return jswrap_object_keys_or_property_names(object, true, false);
+}
+
+static JsVar* gen_jswrap_process_version() {
+  return jsvNewFromString(JS_VERSION);
+}
+
+static JsVar* gen_jswrap_Serial_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_USART1, JSH_USARTMAX, pin);
+}
+
+static JsVar* gen_jswrap_USB() {
+  return jspNewObject("USB", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial1() {
+  return jspNewObject("Serial1", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial2() {
+  return jspNewObject("Serial2", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial3() {
+  return jspNewObject("Serial3", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial4() {
+  return jspNewObject("Serial4", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial5() {
+  return jspNewObject("Serial5", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial6() {
+  return jspNewObject("Serial6", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_LoopbackA() {
+  return jspNewObject("LoopbackA", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_LoopbackB() {
+  return jspNewObject("LoopbackB", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Telnet() {
+  return jspNewObject("Telnet", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static void gen_jswrap_Serial_setConsole(JsVar *parent, bool force) {
+  jsiSetConsoleDevice(jsiGetDeviceFromClass(parent), force);
+}
+
+static JsVarInt gen_jswrap_Serial_getDropped(JsVar *parent) {
+  return (JsVarInt)jshGetTxDroppedCount(jsiGetDeviceFromClass(parent));
+}
+
+static JsVar* gen_jswrap_SPI1() {
+  return jspNewObject("SPI1", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI2() {
+  return jspNewObject("SPI2", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI3() {
+  return jspNewObject("SPI3", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_SPI1, JSH_SPIMAX, pin);
+}
+
+static JsVar* gen_jswrap_I2C_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_I2C1, JSH_I2CMAX, pin);
+}
+
+static JsVar* gen_jswrap_I2C1() {
+  return jspNewObject("I2C1", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_I2C2() {
+  return jspNewObject("I2C2", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_I2C3() {
+  return jspNewObject("I2C3", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static int gen_jswrap_String_indexOf(JsVar *parent, JsVar* substring, JsVar* fromIndex) {
+  return jswrap_string_indexOf(parent, substring, fromIndex, false);
+}
+
+static int gen_jswrap_String_lastIndexOf(JsVar *parent, JsVar* substring, JsVar* fromIndex) {
+  return jswrap_string_indexOf(parent, substring, fromIndex, true);
+}
+
+static JsVar* gen_jswrap_String_toLowerCase(JsVar *parent) {
+  return jswrap_string_toUpperLowerCase(parent, false);
+}
+
+static JsVar* gen_jswrap_String_toUpperCase(JsVar *parent) {
+  return jswrap_string_toUpperLowerCase(parent, true);
+}
+
+static bool gen_jswrap_fs_writeFile(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, false);
+}
+
+static bool gen_jswrap_fs_writeFileSync(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, false);
+}
+
+static bool gen_jswrap_fs_appendFile(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, true);
+}
+
+static bool gen_jswrap_fs_appendFileSync(JsVar* path, JsVar* data) {
+  return jswrap_fs_writeOrAppendFile(path, data, true);
+}
+
+static void gen_jswrap_File_close(JsVar *parent) {
+  jswrap_file_close(parent);
+}
+
+static void gen_jswrap_File_skip(JsVar *parent, int nBytes) {
+  jswrap_file_skip_or_seek(parent,nBytes,true);
+}
+
+static void gen_jswrap_File_seek(JsVar *parent, int nBytes) {
+  jswrap_file_skip_or_seek(parent,nBytes,false);
+}
+
+static JsVarFloat gen_jswrap_Math_E() {
+  return 2.718281828459045;
+}
+
+static JsVarFloat gen_jswrap_Math_PI() {
+  return PI;
+}
+
+static JsVarFloat gen_jswrap_Math_LN2() {
+  return 0.6931471805599453;
+}
+
+static JsVarFloat gen_jswrap_Math_LN10() {
+  return 2.302585092994046;
+}
+
+static JsVarFloat gen_jswrap_Math_LOG2E() {
+  return 1.4426950408889634;
+}
+
+static JsVarFloat gen_jswrap_Math_LOG10E() {
+  return 0.4342944819032518;
+}
+
+static JsVarFloat gen_jswrap_Math_SQRT2() {
+  return 1.4142135623730951;
+}
+
+static JsVarFloat gen_jswrap_Math_SQRT1_2() {
+  return 0.7071067811865476;
+}
+
+static JsVarFloat gen_jswrap_Math_acos(JsVarFloat x) {
+  return jswrap_math_atan(jswrap_math_sqrt(1-x*x) / x);
+}
+
+static JsVarFloat gen_jswrap_Math_asin(JsVarFloat x) {
+  return jswrap_math_atan(x / jswrap_math_sqrt(1-x*x));
+}
+
+static JsVarFloat gen_jswrap_Math_cos(JsVarFloat theta) {
+  return jswrap_math_sin(theta + (PI/2));
+}
+
+static JsVarFloat gen_jswrap_Math_random() {
+  return (JsVarFloat)rand() / (JsVarFloat)RAND_MAX;
+}
+
+static JsVarFloat gen_jswrap_Math_tan(JsVarFloat theta) {
+  return jswrap_math_sin(theta) / jswrap_math_sin(theta+(PI/2));
+}
+
+static JsVarFloat gen_jswrap_Math_min(JsVar* args) {
+  return jswrap_math_minmax(args, false);
+}
+
+static JsVarFloat gen_jswrap_Math_max(JsVar* args) {
+  return jswrap_math_minmax(args, true);
+}
+
+static JsVarInt gen_jswrap_Graphics_getWidth(JsVar *parent) {
+  return jswrap_graphics_getWidthOrHeight(parent, false);
+}
+
+static JsVarInt gen_jswrap_Graphics_getHeight(JsVar *parent) {
+  return jswrap_graphics_getWidthOrHeight(parent, true);
+}
+
+static void gen_jswrap_Graphics_setColor(JsVar *parent, JsVar* r, JsVar* g, JsVar* b) {
+  jswrap_graphics_setColorX(parent, r,g,b, true);
+}
+
+static void gen_jswrap_Graphics_setBgColor(JsVar *parent, JsVar* r, JsVar* g, JsVar* b) {
+  jswrap_graphics_setColorX(parent, r,g,b, false);
+}
+
+static JsVarInt gen_jswrap_Graphics_getColor(JsVar *parent) {
+  return jswrap_graphics_getColorX(parent, true);
+}
+
+static JsVarInt gen_jswrap_Graphics_getBgColor(JsVar *parent) {
+  return jswrap_graphics_getColorX(parent, false);
+}
+
+static void gen_jswrap_Graphics_setFontBitmap(JsVar *parent) {
+  jswrap_graphics_setFontSizeX(parent, JSGRAPHICS_FONTSIZE_4X6, false);
+}
+
+static void gen_jswrap_Graphics_setFontVector(JsVar *parent, int size) {
+  jswrap_graphics_setFontSizeX(parent, size, true);
+}
+
+static JsVar* gen_jswrap_net_connect(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_NORMAL);
+}
+
+static JsVar* gen_jswrap_tls_connect(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_NORMAL | ST_TLS);
+}
+
+static JsVar* gen_jswrap_http_request(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_HTTP);
+}
+
+static JsVar* gen_jswrap_crypto_AES() {
+  return jspNewBuiltin("AES");;
+}
+
+static JsVar* gen_jswrap_crypto_SHA1(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 1);
+}
+
+static JsVar* gen_jswrap_crypto_SHA224(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 224);
+}
+
+static JsVar* gen_jswrap_crypto_SHA256(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 256);
+}
+
+static JsVar* gen_jswrap_crypto_SHA384(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 384);
+}
+
+static JsVar* gen_jswrap_crypto_SHA512(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 512);
+}
+
+static JsVar* gen_jswrap_ArrayBufferView_ArrayBufferView() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_E_E() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Flash_Flash() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_console_console() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_JSON_JSON() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Modules_Modules() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_fs_fs() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_process_process() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Serial_Serial() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_I2C_I2C() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_File_File() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Math_Math() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Graphics_Graphics() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_url_url() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_net_net() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Server_Server() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Socket_Socket() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_tls_tls() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_http_http() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_httpSrv_httpSrv() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_httpSRq_httpSRq() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_httpSRs_httpSRs() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_httpCRq_httpCRq() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_httpCRs_httpCRs() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_NetworkJS_NetworkJS() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_Telnet_Telnet() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_hashlib_hashlib() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_HASH_HASH() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_crypto_crypto() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+static JsVar* gen_jswrap_AES_AES() {
+  return jsvNewWithFlags(JSV_OBJECT);
+}
+
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+
+#ifndef SAVE_ON_FLASH
+static JsVar *jswThunk_0x0(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  ((void (*)(void))function)();
+  return 0;
+}
+static JsVar *jswThunk_0x1(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVar* r = ((JsVar* (*)(void))function)();
+  return r;
+}
+static JsVar *jswThunk_0x4(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarInt r = ((JsVarInt (*)(void))function)();
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x6(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarFloat r = ((JsVarFloat (*)(void))function)();
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  ((void (*)(JsVar*))function)(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x9(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar* r = ((JsVar* (*)(JsVar*))function)(a0);
+  return r;
+}
+static JsVar *jswThunk_0xb(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  bool r = ((bool (*)(JsVar*))function)(a0);
+  return jsvNewFromBool(r);
+}
+static JsVar *jswThunk_0xc(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt r = ((JsVarInt (*)(JsVar*))function)(a0);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0xe(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*))function)(a0);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x10(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  ((void (*)(JsVar*))function)(a0);
+  jsvUnLock(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x11(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  JsVar* r = ((JsVar* (*)(JsVar*))function)(a0);
+  jsvUnLock(a0);
+  return r;
+}
+static JsVar *jswThunk_0x16(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*))function)(a0);
+  jsvUnLock(a0);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x18(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  bool a0 = jsvGetBool(jsnGetArg(paramData, paramCount, 0));
+  ((void (*)(bool))function)(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x20(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  ((void (*)(JsVarInt))function)(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x21(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar* r = ((JsVar* (*)(JsVarInt))function)(a0);
+  return r;
+}
+static JsVar *jswThunk_0x24(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt r = ((JsVarInt (*)(JsVarInt))function)(a0);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x29(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  JsVar* r = ((JsVar* (*)(Pin))function)(a0);
+  return r;
+}
+static JsVar *jswThunk_0x2e(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat r = ((JsVarFloat (*)(Pin))function)(a0);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x30(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  ((void (*)(JsVarFloat))function)(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x31(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  JsVar* r = ((JsVar* (*)(JsVarFloat))function)(a0);
+  return r;
+}
+static JsVar *jswThunk_0x36(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat r = ((JsVarFloat (*)(JsVarFloat))function)(a0);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x48(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  ((void (*)(JsVar*,JsVar*))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x49(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*))function)(a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x4b(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  bool r = ((bool (*)(JsVar*,JsVar*))function)(a0, a1);
+  return jsvNewFromBool(r);
+}
+static JsVar *jswThunk_0x60(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  ((void (*)(JsVarInt,JsVar*))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x61(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar* r = ((JsVar* (*)(JsVarInt,JsVar*))function)(a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x68(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  ((void (*)(Pin,JsVar*))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0xc8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  bool a1 = jsvGetBool(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,bool))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0xc9(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  bool a1 = jsvGetBool(jsnGetArg(paramData, paramCount, 1));
+  JsVar* r = ((JsVar* (*)(JsVar*,bool))function)(a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x108(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVarInt))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x109(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarInt))function)(a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x121(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar* r = ((JsVar* (*)(JsVarInt,JsVarInt))function)(a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x148(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  Pin a1 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,Pin))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x188(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVarFloat))function)(a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x18e(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*,JsVarFloat))function)(a0, a1);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x1b6(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVarFloat r = ((JsVarFloat (*)(JsVarFloat,JsVarFloat))function)(a0, a1);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x248(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(JsVar*,JsVar*,JsVar*))function)(a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x249(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,JsVar*))function)(a0, a1, a2);
+  return r;
+}
+static JsVar *jswThunk_0x261(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVarInt,JsVar*,JsVar*))function)(a0, a1, a2);
+  return r;
+}
+static JsVar *jswThunk_0x2e8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  bool a1 = jsvGetBool(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(Pin,bool,JsVar*))function)(a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x349(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  Pin a1 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVar*,Pin,JsVar*))function)(a0, a1, a2);
+  return r;
+}
+static JsVar *jswThunk_0x3a8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(Pin,JsVarFloat,JsVar*))function)(a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x589(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnNewArgumentArray(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarFloat,JsVar*))function)(a0, a1, a2);
+  jsvUnLock(a2);
+  return r;
+}
+static JsVar *jswThunk_0x648(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  bool a2 = jsvGetBool(jsnGetArg(paramData, paramCount, 2));
+  ((void (*)(JsVar*,JsVar*,bool))function)(a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x84e(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*,JsVar*,JsVarInt))function)(a0, a1, a2);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x909(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarInt,JsVarInt))function)(a0, a1, a2);
+  return r;
+}
+static JsVar *jswThunk_0xdb4(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVarFloat a2 = jsvGetFloat(jsnGetArg(paramData, paramCount, 2));
+  JsVarInt r = ((JsVarInt (*)(JsVarFloat,JsVarFloat,JsVarFloat))function)(a0, a1, a2);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0xdb6(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarFloat a0 = jsvGetFloat(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVarFloat a2 = jsvGetFloat(jsnGetArg(paramData, paramCount, 2));
+  JsVarFloat r = ((JsVarFloat (*)(JsVarFloat,JsVarFloat,JsVarFloat))function)(a0, a1, a2);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x1921(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  JsVar *a3 = jsnGetArg(paramData, paramCount, 3);
+  JsVar* r = ((JsVar* (*)(JsVarInt,JsVarInt,JsVarInt,JsVar*))function)(a0, a1, a2, a3);
+  return r;
+}
+static JsVar *jswThunk_0x4248(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVarInt a3 = jsvGetInteger(jsnGetArg(paramData, paramCount, 3));
+  ((void (*)(JsVar*,JsVar*,JsVar*,JsVarInt))function)(a0, a1, a2, a3);
+  return 0;
+}
+static JsVar *jswThunk_0x6d0e(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarFloat a2 = jsvGetFloat(jsnGetArg(paramData, paramCount, 2));
+  JsVarFloat a3 = jsvGetFloat(jsnGetArg(paramData, paramCount, 3));
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*,JsVarInt,JsVarFloat,JsVarFloat))function)(a0, a1, a2, a3);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x7001(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVar* r = ((JsVar* (*)(void))function)();
+  return r;
+}
+static JsVar *jswThunk_0x7004(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarInt r = ((JsVarInt (*)(void))function)();
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x7006(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(thisParam);
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarFloat r = ((JsVarFloat (*)(void))function)();
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x8000(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  ((void (*)(JsVar*))function)(thisParam);
+  return 0;
+}
+static JsVar *jswThunk_0x8001(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVar* r = ((JsVar* (*)(JsVar*))function)(thisParam);
+  return r;
+}
+static JsVar *jswThunk_0x8003(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  bool r = ((bool (*)(JsVar*))function)(thisParam);
+  return jsvNewFromBool(r);
+}
+static JsVar *jswThunk_0x8004(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarInt r = ((JsVarInt (*)(JsVar*))function)(thisParam);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8006(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarFloat r = ((JsVarFloat (*)(JsVar*))function)(thisParam);
+  return jsvNewFromFloat(r);
+}
+static JsVar *jswThunk_0x8008(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  ((void (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  return 0;
+}
+static JsVar *jswThunk_0x8009(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  return r;
+}
+static JsVar *jswThunk_0x800b(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  bool r = ((bool (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  return jsvNewFromBool(r);
+}
+static JsVar *jswThunk_0x800c(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt r = ((JsVarInt (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8010(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  ((void (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  jsvUnLock(a0);
+  return 0;
+}
+static JsVar *jswThunk_0x8011(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  jsvUnLock(a0);
+  return r;
+}
+static JsVar *jswThunk_0x8014(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnNewArgumentArray(paramData, paramCount, 0);
+  JsVarInt r = ((JsVarInt (*)(JsVar*,JsVar*))function)(thisParam, a0);
+  jsvUnLock(a0);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8018(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  bool a0 = jsvGetBool(jsnGetArg(paramData, paramCount, 0));
+  ((void (*)(JsVar*,bool))function)(thisParam, a0);
+  return 0;
+}
+static JsVar *jswThunk_0x8019(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  bool a0 = jsvGetBool(jsnGetArg(paramData, paramCount, 0));
+  JsVar* r = ((JsVar* (*)(JsVar*,bool))function)(thisParam, a0);
+  return r;
+}
+static JsVar *jswThunk_0x8020(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  ((void (*)(JsVar*,JsVarInt))function)(thisParam, a0);
+  return 0;
+}
+static JsVar *jswThunk_0x8021(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarInt))function)(thisParam, a0);
+  return r;
+}
+static JsVar *jswThunk_0x8024(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt r = ((JsVarInt (*)(JsVar*,JsVarInt))function)(thisParam, a0);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8048(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  ((void (*)(JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8049(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x804c(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVarInt r = ((JsVarInt (*)(JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8060(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  ((void (*)(JsVar*,JsVarInt,JsVar*))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8061(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarInt,JsVar*))function)(thisParam, a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x8088(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnNewArgumentArray(paramData, paramCount, 1);
+  ((void (*)(JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1);
+  jsvUnLock(a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8089(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnNewArgumentArray(paramData, paramCount, 1);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1);
+  jsvUnLock(a1);
+  return r;
+}
+static JsVar *jswThunk_0x80c8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  bool a1 = jsvGetBool(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVar*,bool))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x80e0(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  bool a1 = jsvGetBool(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVarInt,bool))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8108(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVar*,JsVarInt))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8109(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,JsVarInt))function)(thisParam, a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x8120(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,JsVarInt,JsVarInt))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8124(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt r = ((JsVarInt (*)(JsVar*,JsVarInt,JsVarInt))function)(thisParam, a0, a1);
+  return jsvNewFromInteger(r);
+}
+static JsVar *jswThunk_0x8149(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  Pin a1 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 1));
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,Pin))function)(thisParam, a0, a1);
+  return r;
+}
+static JsVar *jswThunk_0x8198(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  bool a0 = jsvGetBool(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  ((void (*)(JsVar*,bool,JsVarFloat))function)(thisParam, a0, a1);
+  return 0;
+}
+static JsVar *jswThunk_0x8248(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(JsVar*,JsVar*,JsVar*,JsVar*))function)(thisParam, a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x8309(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVar*,JsVarInt,JsVar*))function)(thisParam, a0, a1, a2);
+  return r;
+}
+static JsVar *jswThunk_0x8320(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(JsVar*,JsVarInt,JsVarInt,JsVar*))function)(thisParam, a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x83a8(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  Pin a0 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 0));
+  JsVarFloat a1 = jsvGetFloat(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  ((void (*)(JsVar*,Pin,JsVarFloat,JsVar*))function)(thisParam, a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0x8461(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVar *a1 = jsnGetArg(paramData, paramCount, 1);
+  JsVar *a2 = jsnNewArgumentArray(paramData, paramCount, 2);
+  JsVar* r = ((JsVar* (*)(JsVar*,JsVarInt,JsVar*,JsVar*))function)(thisParam, a0, a1, a2);
+  jsvUnLock(a2);
+  return r;
+}
+static JsVar *jswThunk_0x8908(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  ((void (*)(JsVar*,JsVar*,JsVarInt,JsVarInt))function)(thisParam, a0, a1, a2);
+  return 0;
+}
+static JsVar *jswThunk_0xc308(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVar *a2 = jsnGetArg(paramData, paramCount, 2);
+  JsVarInt a3 = jsvGetInteger(jsnGetArg(paramData, paramCount, 3));
+  ((void (*)(JsVar*,JsVar*,JsVarInt,JsVar*,JsVarInt))function)(thisParam, a0, a1, a2, a3);
+  return 0;
+}
+static JsVar *jswThunk_0xc920(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVarInt a0 = jsvGetInteger(jsnGetArg(paramData, paramCount, 0));
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  JsVarInt a3 = jsvGetInteger(jsnGetArg(paramData, paramCount, 3));
+  ((void (*)(JsVar*,JsVarInt,JsVarInt,JsVarInt,JsVarInt))function)(thisParam, a0, a1, a2, a3);
+  return 0;
+}
+static JsVar *jswThunk_0xd908(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  JsVar *a0 = jsnGetArg(paramData, paramCount, 0);
+  JsVarInt a1 = jsvGetInteger(jsnGetArg(paramData, paramCount, 1));
+  JsVarInt a2 = jsvGetInteger(jsnGetArg(paramData, paramCount, 2));
+  Pin a3 = jshGetPinFromVar(jsnGetArg(paramData, paramCount, 3));
+  ((void (*)(JsVar*,JsVar*,JsVarInt,JsVarInt,Pin))function)(thisParam, a0, a1, a2, a3);
+  return 0;
+}
+static JsVar *jswThunk_0xf001(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVar* r = ((JsVar* (*)(JsVar*))function)(thisParam);
+  return r;
+}
+static JsVar *jswThunk_0xf004(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {
+  NOT_USED(paramData);
+  NOT_USED(paramCount);
+  JsVarInt r = ((JsVarInt (*)(JsVar*))function)(thisParam);
+  return jsvNewFromInteger(r);
+}
+#endif
+
+JsVar *jswCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar *thisParam, JsVar **paramData, int paramCount) {
+#ifndef SAVE_ON_FLASH
+  switch ((int)argumentSpecifier) {
+    case 0x0: return jswThunk_0x0(function, thisParam, paramData, paramCount);
+    case 0x1: return jswThunk_0x1(function, thisParam, paramData, paramCount);
+    case 0x4: return jswThunk_0x4(function, thisParam, paramData, paramCount);
+    case 0x6: return jswThunk_0x6(function, thisParam, paramData, paramCount);
+    case 0x8: return jswThunk_0x8(function, thisParam, paramData, paramCount);
+    case 0x9: return jswThunk_0x9(function, thisParam, paramData, paramCount);
+    case 0xb: return jswThunk_0xb(function, thisParam, paramData, paramCount);
+    case 0xc: return jswThunk_0xc(function, thisParam, paramData, paramCount);
+    case 0xe: return jswThunk_0xe(function, thisParam, paramData, paramCount);
+    case 0x10: return jswThunk_0x10(function, thisParam, paramData, paramCount);
+    case 0x11: return jswThunk_0x11(function, thisParam, paramData, paramCount);
+    case 0x16: return jswThunk_0x16(function, thisParam, paramData, paramCount);
+    case 0x18: return jswThunk_0x18(function, thisParam, paramData, paramCount);
+    case 0x20: return jswThunk_0x20(function, thisParam, paramData, paramCount);
+    case 0x21: return jswThunk_0x21(function, thisParam, paramData, paramCount);
+    case 0x24: return jswThunk_0x24(function, thisParam, paramData, paramCount);
+    case 0x29: return jswThunk_0x29(function, thisParam, paramData, paramCount);
+    case 0x2e: return jswThunk_0x2e(function, thisParam, paramData, paramCount);
+    case 0x30: return jswThunk_0x30(function, thisParam, paramData, paramCount);
+    case 0x31: return jswThunk_0x31(function, thisParam, paramData, paramCount);
+    case 0x36: return jswThunk_0x36(function, thisParam, paramData, paramCount);
+    case 0x48: return jswThunk_0x48(function, thisParam, paramData, paramCount);
+    case 0x49: return jswThunk_0x49(function, thisParam, paramData, paramCount);
+    case 0x4b: return jswThunk_0x4b(function, thisParam, paramData, paramCount);
+    case 0x60: return jswThunk_0x60(function, thisParam, paramData, paramCount);
+    case 0x61: return jswThunk_0x61(function, thisParam, paramData, paramCount);
+    case 0x68: return jswThunk_0x68(function, thisParam, paramData, paramCount);
+    case 0xc8: return jswThunk_0xc8(function, thisParam, paramData, paramCount);
+    case 0xc9: return jswThunk_0xc9(function, thisParam, paramData, paramCount);
+    case 0x108: return jswThunk_0x108(function, thisParam, paramData, paramCount);
+    case 0x109: return jswThunk_0x109(function, thisParam, paramData, paramCount);
+    case 0x121: return jswThunk_0x121(function, thisParam, paramData, paramCount);
+    case 0x148: return jswThunk_0x148(function, thisParam, paramData, paramCount);
+    case 0x188: return jswThunk_0x188(function, thisParam, paramData, paramCount);
+    case 0x18e: return jswThunk_0x18e(function, thisParam, paramData, paramCount);
+    case 0x1b6: return jswThunk_0x1b6(function, thisParam, paramData, paramCount);
+    case 0x248: return jswThunk_0x248(function, thisParam, paramData, paramCount);
+    case 0x249: return jswThunk_0x249(function, thisParam, paramData, paramCount);
+    case 0x261: return jswThunk_0x261(function, thisParam, paramData, paramCount);
+    case 0x2e8: return jswThunk_0x2e8(function, thisParam, paramData, paramCount);
+    case 0x349: return jswThunk_0x349(function, thisParam, paramData, paramCount);
+    case 0x3a8: return jswThunk_0x3a8(function, thisParam, paramData, paramCount);
+    case 0x589: return jswThunk_0x589(function, thisParam, paramData, paramCount);
+    case 0x648: return jswThunk_0x648(function, thisParam, paramData, paramCount);
+    case 0x84e: return jswThunk_0x84e(function, thisParam, paramData, paramCount);
+    case 0x909: return jswThunk_0x909(function, thisParam, paramData, paramCount);
+    case 0xdb4: return jswThunk_0xdb4(function, thisParam, paramData, paramCount);
+    case 0xdb6: return jswThunk_0xdb6(function, thisParam, paramData, paramCount);
+    case 0x1921: return jswThunk_0x1921(function, thisParam, paramData, paramCount);
+    case 0x4248: return jswThunk_0x4248(function, thisParam, paramData, paramCount);
+    case 0x6d0e: return jswThunk_0x6d0e(function, thisParam, paramData, paramCount);
+    case 0x7001: return jswThunk_0x7001(function, thisParam, paramData, paramCount);
+    case 0x7004: return jswThunk_0x7004(function, thisParam, paramData, paramCount);
+    case 0x7006: return jswThunk_0x7006(function, thisParam, paramData, paramCount);
+    case 0x8000: return jswThunk_0x8000(function, thisParam, paramData, paramCount);
+    case 0x8001: return jswThunk_0x8001(function, thisParam, paramData, paramCount);
+    case 0x8003: return jswThunk_0x8003(function, thisParam, paramData, paramCount);
+    case 0x8004: return jswThunk_0x8004(function, thisParam, paramData, paramCount);
+    case 0x8006: return jswThunk_0x8006(function, thisParam, paramData, paramCount);
+    case 0x8008: return jswThunk_0x8008(function, thisParam, paramData, paramCount);
+    case 0x8009: return jswThunk_0x8009(function, thisParam, paramData, paramCount);
+    case 0x800b: return jswThunk_0x800b(function, thisParam, paramData, paramCount);
+    case 0x800c: return jswThunk_0x800c(function, thisParam, paramData, paramCount);
+    case 0x8010: return jswThunk_0x8010(function, thisParam, paramData, paramCount);
+    case 0x8011: return jswThunk_0x8011(function, thisParam, paramData, paramCount);
+    case 0x8014: return jswThunk_0x8014(function, thisParam, paramData, paramCount);
+    case 0x8018: return jswThunk_0x8018(function, thisParam, paramData, paramCount);
+    case 0x8019: return jswThunk_0x8019(function, thisParam, paramData, paramCount);
+    case 0x8020: return jswThunk_0x8020(function, thisParam, paramData, paramCount);
+    case 0x8021: return jswThunk_0x8021(function, thisParam, paramData, paramCount);
+    case 0x8024: return jswThunk_0x8024(function, thisParam, paramData, paramCount);
+    case 0x8048: return jswThunk_0x8048(function, thisParam, paramData, paramCount);
+    case 0x8049: return jswThunk_0x8049(function, thisParam, paramData, paramCount);
+    case 0x804c: return jswThunk_0x804c(function, thisParam, paramData, paramCount);
+    case 0x8060: return jswThunk_0x8060(function, thisParam, paramData, paramCount);
+    case 0x8061: return jswThunk_0x8061(function, thisParam, paramData, paramCount);
+    case 0x8088: return jswThunk_0x8088(function, thisParam, paramData, paramCount);
+    case 0x8089: return jswThunk_0x8089(function, thisParam, paramData, paramCount);
+    case 0x80c8: return jswThunk_0x80c8(function, thisParam, paramData, paramCount);
+    case 0x80e0: return jswThunk_0x80e0(function, thisParam, paramData, paramCount);
+    case 0x8108: return jswThunk_0x8108(function, thisParam, paramData, paramCount);
+    case 0x8109: return jswThunk_0x8109(function, thisParam, paramData, paramCount);
+    case 0x8120: return jswThunk_0x8120(function, thisParam, paramData, paramCount);
+    case 0x8124: return jswThunk_0x8124(function, thisParam, paramData, paramCount);
+    case 0x8149: return jswThunk_0x8149(function, thisParam, paramData, paramCount);
+    case 0x8198: return jswThunk_0x8198(function, thisParam, paramData, paramCount);
+    case 0x8248: return jswThunk_0x8248(function, thisParam, paramData, paramCount);
+    case 0x8309: return jswThunk_0x8309(function, thisParam, paramData, paramCount);
+    case 0x8320: return jswThunk_0x8320(function, thisParam, paramData, paramCount);
+    case 0x83a8: return jswThunk_0x83a8(function, thisParam, paramData, paramCount);
+    case 0x8461: return jswThunk_0x8461(function, thisParam, paramData, paramCount);
+    case 0x8908: return jswThunk_0x8908(function, thisParam, paramData, paramCount);
+    case 0xc308: return jswThunk_0xc308(function, thisParam, paramData, paramCount);
+    case 0xc920: return jswThunk_0xc920(function, thisParam, paramData, paramCount);
+    case 0xd908: return jswThunk_0xd908(function, thisParam, paramData, paramCount);
+    case 0xf001: return jswThunk_0xf001(function, thisParam, paramData, paramCount);
+    case 0xf004: return jswThunk_0xf004(function, thisParam, paramData, paramCount);
+    default: return jsnCallFunction(function, argumentSpecifier, thisParam, paramData, paramCount);
+  }
+#else
+  return jsnCallFunction(function, argumentSpecifier, thisParam, paramData, paramCount);
+#endif
+}
+
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+
+
+// Binary search coded to allow for JswSyms to be in flash on the esp8266 where they require
+// word accesses
+bool jswBinarySearchSymbol(const JswSymList *symbolsPtr, const char *name, JswBuiltInSymbol *symbol) {
+  uint8_t symbolCount = READ_FLASH_UINT8(&symbolsPtr->symbolCount);
+  int searchMin = 0;
+  int searchMax = symbolCount - 1;
+  while (searchMin <= searchMax) {
+    int idx = (searchMin+searchMax) >> 1;
+    const JswSymPtr *sym = &symbolsPtr->symbols[idx];
+    unsigned short strOffset = READ_FLASH_UINT16(&sym->strOffset);
+    int cmp = FLASH_STRCMP(name, &symbolsPtr->symbolChars[strOffset]);
+    if (cmp==0) {
+      symbol->functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
+      symbol->functionPtr = sym->functionPtr;
+      return true;
+    } else {
+      if (cmp<0) {
+        // searchMin is the same
+        searchMax = idx-1;
+      } else {
+        searchMin = idx+1;
+        // searchMax is the same
+      }
+    }
+  }
+  return false;
+}
+
+JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name) {
+  JswBuiltInSymbol symbol;
+  if (!jswBinarySearchSymbol(symbolsPtr, name, &symbol)) return 0;
+  if ((symbol.functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
+    return jswCallFunction(symbol.functionPtr, symbol.functionSpec, parent, 0, 0);
+  return jswGetNativeFunction(&symbol);
+}
+
+/* Functions for built-in symbols are kept in a small cache in hiddenRoot when
+ * they're used as values, so using the same one again (and comparing them)
+ * works as it would for a normal function. The cache is emptied on reset or
+ * if memory gets low (see jspCodeCacheFlush) */
+JsVar *jswGetNativeFunction(const JswBuiltInSymbol *symbol) {
+#ifndef SAVE_ON_FLASH
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, JSW_NATIVE_FUNCTION_CACHE_NAME, JSV_ARRAY);
+  if (cache) {
+    JsVarRef childref = jsvGetFirstChild(cache);
+    while (childref) {
+      JsVar *child = jsvGetAddressOfBorrowed(childref);
+      JsVar *fn = jsvGetAddressOfBorrowed(jsvGetFirstChild(child));
+      if (fn->varData.native.ptr==symbol->functionPtr && fn->varData.native.argTypes==symbol->functionSpec) {
+        jsvUnLock(cache);
+        return jsvLockAgain(fn);
+      }
+      childref = jsvGetNextSibling(child);
+    }
+  }
+#endif
+  JsVar *fn = jsvNewNativeFunction(symbol->functionPtr, symbol->functionSpec);
+#ifndef SAVE_ON_FLASH
+  if (cache && fn) {
+    // Throw out the oldest entry if we're full
+    if (jsvGetChildren(cache) >= JSW_NATIVE_FUNCTION_CACHE_SIZE)
+      jsvUnLock(jsvArrayPopFirst(cache));
+    jsvArrayPush(cache, fn);
+  }
+  jsvUnLock(cache);
+#endif
+  return fn;
+}
+
+
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+
+
+#ifdef ESP8266
+#define FLASH_SECT __attribute__((section(".irom.literal2"))) __attribute__((aligned(4)))
+#else
+#define FLASH_SECT
+#endif
+
+static const JswSymPtr jswSymbols_global[] FLASH_SECT = {
+  {0, JSWAT_JSVAR, (void (*)(void))gen_jswrap_AES_AES},
+  {4, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_constructor},
+  {10, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_arraybuffer_constructor},
+  {22, JSWAT_JSVAR, (void (*)(void))gen_jswrap_ArrayBufferView_ArrayBufferView},
+  {38, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_boolean_constructor},
+  {46, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_date_constructor},
+  {51, JSWAT_JSVAR, (void (*)(void))gen_jswrap_E_E},
+  {53, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_error_constructor},
+  {59, JSWAT_JSVAR, (void (*)(void))gen_jswrap_File_File},
+  {64, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Float32Array_Float32Array},
+  {77, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Float64Array_Float64Array},
+  {90, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_function_constructor},
+  {99, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Graphics_Graphics},
+  {108, JSWAT_JSVAR, (void (*)(void))gen_jswrap_HASH_HASH},
+  {113, JSWAT_INT32 | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_HIGH},
+  {118, JSWAT_JSVAR, (void (*)(void))gen_jswrap_I2C_I2C},
+  {122, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_I2C1},
+  {127, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_I2C2},
+  {132, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_I2C3},
+  {137, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Infinity},
+  {146, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Int16Array_Int16Array},
+  {157, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Int32Array_Int32Array},
+  {168, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Int8Array_Int8Array},
+  {178, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_internalerror_constructor},
+  {192, JSWAT_JSVAR, (void (*)(void))gen_jswrap_JSON_JSON},
+  {197, JSWAT_INT32 | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_LOW},
+  {201, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_LoopbackA},
+  {211, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_LoopbackB},
+  {221, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_constructor},
+  {225, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Math_Math},
+  {230, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Modules_Modules},
+  {238, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_NaN},
+  {242, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_number_constructor},
+  {249, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_constructor},
+  {256, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))jswrap_onewire_constructor},
+  {264, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_pin_constructor},
+  {268, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_constructor},
+  {276, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_referenceerror_constructor},
+  {291, JSWAT_VOID, (void (*)(void))jswrap_spi_constructor},
+  {295, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_SPI1},
+  {300, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_SPI2},
+  {305, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_SPI3},
+  {310, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Serial_Serial},
+  {317, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial1},
+  {325, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial2},
+  {333, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial3},
+  {341, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial4},
+  {349, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial5},
+  {357, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Serial6},
+  {365, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Server_Server},
+  {372, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_set_constructor},
+  {376, JSWAT_JSVAR, (void (*)(void))gen_jswrap_Socket_Socket},
+  {383, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_string_constructor},
+  {390, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_syntaxerror_constructor},
+  {402, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_typeerror_constructor},
+  {412, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_USB},
+  {416, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Uint16Array_Uint16Array},
+  {428, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Uint32Array_Uint32Array},
+  {440, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Uint8Array_Uint8Array},
+  {451, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Uint8ClampedArray_Uint8ClampedArray},
+  {469, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_waveform_constructor},
+  {478, JSWAT_JSVARFLOAT | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))jshPinAnalog},
+  {489, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_io_analogWrite},
+  {501, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_arguments},
+  {511, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_atob},
+  {516, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_btoa},
+  {521, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))jswrap_interface_changeInterval},
+  {536, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_clearInterval},
+  {550, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_clearTimeout},
+  {563, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_clearWatch},
+  {574, JSWAT_JSVAR, (void (*)(void))gen_jswrap_console_console},
+  {582, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_decodeURIComponent},
+  {601, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_io_digitalPulse},
+  {614, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_io_digitalRead},
+  {626, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_io_digitalWrite},
+  {639, JSWAT_VOID, (void (*)(void))gen_jswrap_dump},
+  {644, JSWAT_VOID | (JSWAT_BOOL << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_echo},
+  {649, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_edit},
+  {654, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_encodeURIComponent},
+  {673, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_eval},
+  {678, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))jswrap_io_getPinMode},
+  {689, JSWAT_JSVAR, (void (*)(void))jswrap_interface_getSerial},
+  {699, JSWAT_JSVARFLOAT, (void (*)(void))gen_jswrap_getTime},
+  {707, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_global},
+  {714, JSWAT_JSVAR, (void (*)(void))gen_jswrap_httpCRq_httpCRq},
+  {722, JSWAT_JSVAR, (void (*)(void))gen_jswrap_httpCRs_httpCRs},
+  {730, JSWAT_JSVAR, (void (*)(void))gen_jswrap_httpSRq_httpSRq},
+  {738, JSWAT_JSVAR, (void (*)(void))gen_jswrap_httpSRs_httpSRs},
+  {746, JSWAT_JSVAR, (void (*)(void))gen_jswrap_httpSrv_httpSrv},
+  {754, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_isNaN},
+  {760, JSWAT_VOID, (void (*)(void))gen_jswrap_load},
+  {765, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_parseFloat},
+  {776, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_parseInt},
+  {785, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_peek16},
+  {792, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_peek32},
+  {799, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_peek8},
+  {805, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_io_pinMode},
+  {813, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_poke16},
+  {820, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_poke32},
+  {827, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_poke8},
+  {833, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_print},
+  {839, JSWAT_JSVAR, (void (*)(void))gen_jswrap_process_process},
+  {847, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_require},
+  {855, JSWAT_VOID, (void (*)(void))gen_jswrap_reset},
+  {861, JSWAT_VOID, (void (*)(void))gen_jswrap_save},
+  {866, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_setBusyIndicator},
+  {883, JSWAT_VOID | (JSWAT_BOOL << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_setDeepSleep},
+  {896, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void (*)(void))jswrap_interface_setInterval},
+  {908, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_setSleepIndicator},
+  {926, JSWAT_VOID | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_interactive_setTime},
+  {934, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void (*)(void))jswrap_interface_setTimeout},
+  {945, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_interface_setWatch},
+  {954, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_io_shiftOut},
+  {963, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_trace},
+  {969, JSWAT_JSVAR, (void (*)(void))gen_jswrap_url_url}
+};
+static const unsigned char jswSymbolIndex_global = 0;
+static const JswSymPtr jswSymbols_Array_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_concat},
+  {7, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_every},
+  {13, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_array_fill},
+  {18, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_filter},
+  {25, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_forEach},
+  {33, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_indexOf},
+  {41, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_join},
+  {46, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_object_length},
+  {53, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_map},
+  {57, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Array_pop},
+  {61, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_push},
+  {66, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_reduce},
+  {73, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_array_reverse},
+  {81, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_array_shift},
+  {87, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_slice},
+  {93, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_some},
+  {98, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_sort},
+  {103, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void (*)(void))jswrap_array_splice},
+  {110, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_toString},
+  {119, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_unshift}
+};
+static const unsigned char jswSymbolIndex_Array_proto = 1;
+static const JswSymPtr jswSymbols_Array[] FLASH_SECT = {
+  {0, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Array_isArray}
+};
+static const unsigned char jswSymbolIndex_Array = 2;
+static const JswSymPtr jswSymbols_ArrayBufferView_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_ArrayBufferView_buffer},
+  {7, JSWAT_INT32 | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_ArrayBufferView_byteLength},
+  {18, JSWAT_INT32 | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_ArrayBufferView_byteOffset},
+  {29, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_array_fill},
+  {34, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_forEach},
+  {42, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_indexOf},
+  {50, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_join},
+  {55, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_arraybufferview_map},
+  {59, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_array_reduce},
+  {66, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_array_reverse},
+  {74, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_arraybufferview_set},
+  {78, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_arraybufferview_slice},
+  {84, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_array_sort}
+};
+static const unsigned char jswSymbolIndex_ArrayBufferView_proto = 3;
+static const JswSymPtr jswSymbols_Date[] FLASH_SECT = {
+  {0, JSWAT_JSVARFLOAT, (void (*)(void))jswrap_date_now},
+  {4, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_date_parse}
+};
+static const unsigned char jswSymbolIndex_Date = 4;
+static const JswSymPtr jswSymbols_Date_proto[] FLASH_SECT = {
+  {0, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getDate},
+  {8, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getDay},
+  {15, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getFullYear},
+  {27, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getHours},
+  {36, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getMilliseconds},
+  {52, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getMinutes},
+  {63, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getMonth},
+  {72, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getSeconds},
+  {83, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getTime},
+  {91, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getTimezoneOffset},
+  {109, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_toString},
+  {118, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_toUTCString},
+  {130, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void (*)(void))jswrap_date_getTime}
+};
+static const unsigned char jswSymbolIndex_Date_proto = 5;
+static const JswSymPtr jswSymbols_Error_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_error_toString}
+};
+static const unsigned char jswSymbolIndex_Error_proto = 6;
+static const JswSymPtr jswSymbols_SyntaxError_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_error_toString}
+};
+static const unsigned char jswSymbolIndex_SyntaxError_proto = 7;
+static const JswSymPtr jswSymbols_TypeError_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_error_toString}
+};
+static const unsigned char jswSymbolIndex_TypeError_proto = 8;
+static const JswSymPtr jswSymbols_InternalError_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_error_toString}
+};
+static const unsigned char jswSymbolIndex_InternalError_proto = 9;
+static const JswSymPtr jswSymbols_ReferenceError_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_error_toString}
+};
+static const unsigned char jswSymbolIndex_ReferenceError_proto = 10;
+static const JswSymPtr jswSymbols_E[] FLASH_SECT = {
+  {0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void (*)(void))jswrap_espruino_FFT},
+  {4, JSWAT_INT32 | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)), (void (*)(void))jswrap_espruino_HSBtoRGB},
+  {13, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)), (void (*)(void))jswrap_espruino_clip},
+  {18, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)), (void (*)(void))jswrap_E_connectSDCard},
+  {32, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))jswrap_espruino_convolve},
+  {41, JSWAT_JSVAR, (void (*)(void))jswrap_e_dumpStr},
+  {49, JSWAT_VOID, (void (*)(void))jswrap_espruino_dumpTimers},
+  {60, JSWAT_VOID | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_enableWatchdog},
+  {75, JSWAT_JSVARFLOAT, (void (*)(void))gen_jswrap_E_getAnalogVRef},
+  {89, JSWAT_JSVAR, (void (*)(void))jswrap_espruino_getErrorFlags},
+  {103, JSWAT_JSVAR, (void (*)(void))jswrap_function_cache_getStats},
+  {125, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_espruino_getSizeOf},
+  {135, JSWAT_JSVARFLOAT, (void (*)(void))gen_jswrap_E_getTemperature},
+  {150, JSWAT_INT32, (void (*)(void))jshGetRandomNumber},
+  {157, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))jswrap_espruino_interpolate},
+  {169, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*4)), (void (*)(void))jswrap_espruino_interpolate2d},
+  {183, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void (*)(void))jswrap_espruino_mapInPlace},
+  {194, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_espruino_memoryArea},
+  {205, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_espruino_nativeCall},
+  {216, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_E_openFile},
+  {225, JSWAT_INT32 | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_reverseByte},
+  {237, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void (*)(void))jswrap_espruino_setBootCode},
+  {249, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_setClock},
+  {258, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_setLowMemoryThresholds},
+  {281, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))srand},
+  {287, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_sum},
+  {291, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_toArrayBuffer},
+  {305, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_toString},
+  {314, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_espruino_toUint8Array},
+  {327, JSWAT_VOID, (void (*)(void))jswrap_E_unmountSD},
+  {337, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))jswrap_espruino_variance}
+};
+static const unsigned char jswSymbolIndex_E = 11;
+static const JswSymPtr jswSymbols_Flash[] FLASH_SECT = {
+  {0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_flash_erasePage},
+  {10, JSWAT_JSVAR, (void (*)(void))jswrap_flash_getFree},
+  {18, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_flash_getPage},
+  {26, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_flash_read},
+  {31, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_flash_write}
+};
+static const unsigned char jswSymbolIndex_Flash = 12;
+static const JswSymPtr jswSymbols_console[] FLASH_SECT = {
+  {0, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_interface_print}
+};
+static const unsigned char jswSymbolIndex_console = 13;
+static const JswSymPtr jswSymbols_JSON[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_json_parse},
+  {6, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_json_stringify}
+};
+static const unsigned char jswSymbolIndex_JSON = 14;
+static const JswSymPtr jswSymbols_Map_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_clear},
+  {6, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_delete},
+  {13, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_entries},
+  {21, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_map_forEach},
+  {29, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_get},
+  {33, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_has},
+  {37, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_keys},
+  {42, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_map_set},
+  {46, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_map_size},
+  {51, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_values}
+};
+static const unsigned char jswSymbolIndex_Map_proto = 15;
+static const JswSymPtr jswSymbols_Set_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_set_add},
+  {4, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_clear},
+  {10, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_delete},
+  {17, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_entries},
+  {25, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_map_forEach},
+  {33, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_map_has},
+  {37, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_keys},
+  {42, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_map_size},
+  {47, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_map_values}
+};
+static const unsigned char jswSymbolIndex_Set_proto = 16;
+static const JswSymPtr jswSymbols_Modules[] FLASH_SECT = {
+  {0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_modules_addCached},
+  {10, JSWAT_JSVAR, (void (*)(void))jswrap_modules_getCached},
+  {20, JSWAT_VOID, (void (*)(void))jswrap_modules_removeAllCached},
+  {36, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_modules_removeCached}
+};
+static const unsigned char jswSymbolIndex_Modules = 17;
+static const JswSymPtr jswSymbols_Pin_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_pin_getInfo},
+  {8, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_pin_getMode},
+  {16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_pin_mode},
+  {21, JSWAT_BOOL | JSWAT_THIS_ARG, (void (*)(void))jswrap_pin_read},
+  {26, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_pin_reset},
+  {32, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_pin_set},
+  {36, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void (*)(void))jswrap_pin_write},
+  {42, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))jswrap_pin_writeAtTime}
+};
+static const unsigned char jswSymbolIndex_Pin_proto = 18;
+static const JswSymPtr jswSymbols_Number[] FLASH_SECT = {
+  {0, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Number_MAX_VALUE},
+  {10, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Number_MIN_VALUE},
+  {20, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Number_NEGATIVE_INFINITY},
+  {38, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Number_NaN},
+  {42, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Number_POSITIVE_INFINITY}
+};
+static const unsigned char jswSymbolIndex_Number = 19;
+static const JswSymPtr jswSymbols_Number_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_number_toFixed}
+};
+static const unsigned char jswSymbolIndex_Number_proto = 20;
+static const JswSymPtr jswSymbols_Object_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_object_clone},
+  {6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_emit},
+  {11, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_hasOwnProperty},
+  {26, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_object_length},
+  {33, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_on},
+  {36, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_removeAllListeners},
+  {55, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_removeListener},
+  {70, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_toString},
+  {79, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_object_valueOf}
+};
+static const unsigned char jswSymbolIndex_Object_proto = 21;
+static const JswSymPtr jswSymbols_Object[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_create},
+  {7, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_defineProperties},
+  {24, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_object_defineProperty},
+  {39, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_getOwnPropertyDescriptor},
+  {64, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Object_getOwnPropertyNames},
+  {84, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_object_getPrototypeOf},
+  {99, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Object_keys},
+  {104, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_object_setPrototypeOf}
+};
+static const unsigned char jswSymbolIndex_Object = 22;
+static const JswSymPtr jswSymbols_Function_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_function_apply_or_call},
+  {6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void (*)(void))jswrap_function_bind},
+  {11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void (*)(void))jswrap_function_apply_or_call},
+  {16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_function_replaceWith}
+};
+static const unsigned char jswSymbolIndex_Function_proto = 23;
+static const JswSymPtr jswSymbols_OneWire_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_onewire_read},
+  {5, JSWAT_BOOL | JSWAT_THIS_ARG, (void (*)(void))jswrap_onewire_reset},
+  {11, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_onewire_search},
+  {18, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_onewire_search},
+  {25, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_onewire_select},
+  {32, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_onewire_skip},
+  {37, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void (*)(void))jswrap_onewire_write}
+};
+static const unsigned char jswSymbolIndex_OneWire_proto = 24;
+static const JswSymPtr jswSymbols_fs[] FLASH_SECT = {
+  {0, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_fs_appendFile},
+  {11, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_fs_appendFileSync},
+  {26, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_pipe},
+  {31, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_readFile},
+  {40, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_readFile},
+  {53, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_readdir},
+  {61, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_readdir},
+  {73, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_stat},
+  {82, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_unlink},
+  {89, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_fs_unlink},
+  {100, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_fs_writeFile},
+  {110, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_fs_writeFileSync}
+};
+static const unsigned char jswSymbolIndex_fs = 25;
+static const JswSymPtr jswSymbols_process[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_process_env},
+  {4, JSWAT_JSVAR, (void (*)(void))jswrap_process_memory},
+  {11, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_process_version}
+};
+static const unsigned char jswSymbolIndex_process = 26;
+static const JswSymPtr jswSymbols_Promise[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_all},
+  {4, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_reject},
+  {11, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_resolve}
+};
+static const unsigned char jswSymbolIndex_Promise = 27;
+static const JswSymPtr jswSymbols_Promise_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_catch},
+  {6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_promise_then}
+};
+static const unsigned char jswSymbolIndex_Promise_proto = 28;
+static const JswSymPtr jswSymbols_Serial[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Serial_find}
+};
+static const unsigned char jswSymbolIndex_Serial = 29;
+static const JswSymPtr jswSymbols_Serial_proto[] FLASH_SECT = {
+  {0, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_stream_available},
+  {10, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Serial_getDropped},
+  {21, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_serial_onData},
+  {28, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_pipe},
+  {33, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_serial_print},
+  {39, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_serial_println},
+  {47, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_stream_read},
+  {52, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Serial_setConsole},
+  {63, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_serial_setup},
+  {69, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_serial_write}
+};
+static const unsigned char jswSymbolIndex_Serial_proto = 30;
+static const JswSymPtr jswSymbols_SPI[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_SPI_find}
+};
+static const unsigned char jswSymbolIndex_SPI = 31;
+static const JswSymPtr jswSymbols_SPI_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)), (void (*)(void))jswrap_spi_send},
+  {5, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_PIN << (JSWAT_BITS*4)), (void (*)(void))jswrap_spi_send4bit},
+  {14, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_PIN << (JSWAT_BITS*4)), (void (*)(void))jswrap_spi_send8bit},
+  {23, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_spi_setup},
+  {29, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_spi_write}
+};
+static const unsigned char jswSymbolIndex_SPI_proto = 32;
+static const JswSymPtr jswSymbols_I2C[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_I2C_find}
+};
+static const unsigned char jswSymbolIndex_I2C = 33;
+static const JswSymPtr jswSymbols_I2C_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_i2c_readFrom},
+  {9, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_i2c_setup},
+  {15, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void (*)(void))jswrap_i2c_writeTo}
+};
+static const unsigned char jswSymbolIndex_I2C_proto = 34;
+static const JswSymPtr jswSymbols_String_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_string_charAt},
+  {7, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_string_charCodeAt},
+  {18, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_String_indexOf},
+  {26, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_String_lastIndexOf},
+  {38, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))jswrap_object_length},
+  {45, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_string_replace},
+  {53, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_string_slice},
+  {59, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_string_split},
+  {65, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_string_substr},
+  {72, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_string_substring},
+  {82, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_String_toLowerCase},
+  {94, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_String_toUpperCase},
+  {106, JSWAT_JSVAR | JSWAT_THIS_ARG, (void (*)(void))jswrap_string_trim}
+};
+static const unsigned char jswSymbolIndex_String_proto = 35;
+static const JswSymPtr jswSymbols_String[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))jswrap_string_fromCharCode}
+};
+static const unsigned char jswSymbolIndex_String = 36;
+static const JswSymPtr jswSymbols_Waveform_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_waveform_startInput},
+  {11, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_waveform_startOutput},
+  {23, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_waveform_stop}
+};
+static const unsigned char jswSymbolIndex_Waveform_proto = 37;
+static const JswSymPtr jswSymbols_File_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_File_close},
+  {6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_pipe},
+  {11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_file_read},
+  {16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_File_seek},
+  {21, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_File_skip},
+  {26, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_file_write}
+};
+static const unsigned char jswSymbolIndex_File_proto = 38;
+static const JswSymPtr jswSymbols_Math[] FLASH_SECT = {
+  {0, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_E},
+  {2, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_LN10},
+  {7, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_LN2},
+  {11, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_LOG10E},
+  {18, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_LOG2E},
+  {24, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_PI},
+  {27, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_SQRT1_2},
+  {35, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_Math_SQRT2},
+  {41, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_math_abs},
+  {45, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_acos},
+  {50, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_asin},
+  {55, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_math_atan},
+  {60, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))atan2},
+  {66, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))ceil},
+  {71, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)), (void (*)(void))jswrap_math_clip},
+  {76, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_cos},
+  {80, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))exp},
+  {84, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))floor},
+  {90, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))log},
+  {94, JSWAT_JSVARFLOAT | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_max},
+  {98, JSWAT_JSVARFLOAT | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_min},
+  {102, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))jswrap_math_pow},
+  {106, JSWAT_JSVARFLOAT, (void (*)(void))gen_jswrap_Math_random},
+  {113, JSWAT_JSVAR | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_math_round},
+  {119, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_math_sin},
+  {123, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))jswrap_math_sqrt},
+  {128, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Math_tan},
+  {132, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void (*)(void))wrapAround}
+};
+static const unsigned char jswSymbolIndex_Math = 39;
+static const JswSymPtr jswSymbols_Graphics[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_createArrayBuffer},
+  {18, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_createCallback}
+};
+static const unsigned char jswSymbolIndex_Graphics = 40;
+static const JswSymPtr jswSymbols_Graphics_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_graphics_clear},
+  {6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))jswrap_graphics_drawImage},
+  {16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_drawLine},
+  {25, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_drawRect},
+  {34, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void (*)(void))jswrap_graphics_drawString},
+  {45, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_graphics_fillPoly},
+  {54, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_fillRect},
+  {63, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Graphics_getBgColor},
+  {74, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Graphics_getColor},
+  {83, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Graphics_getHeight},
+  {93, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void (*)(void))jswrap_graphics_getModified},
+  {105, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_graphics_getPixel},
+  {114, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Graphics_getWidth},
+  {123, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_graphics_lineTo},
+  {130, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void (*)(void))jswrap_graphics_moveTo},
+  {137, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Graphics_setBgColor},
+  {148, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))gen_jswrap_Graphics_setColor},
+  {157, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))gen_jswrap_Graphics_setFontBitmap},
+  {171, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void (*)(void))jswrap_graphics_setFontCustom},
+  {185, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_Graphics_setFontVector},
+  {199, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_graphics_setPixel},
+  {208, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void (*)(void))jswrap_graphics_setRotation},
+  {220, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_graphics_stringWidth}
+};
+static const unsigned char jswSymbolIndex_Graphics_proto = 41;
+static const JswSymPtr jswSymbols_url[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void (*)(void))jswrap_url_parse}
+};
+static const unsigned char jswSymbolIndex_url = 42;
+static const JswSymPtr jswSymbols_Socket[] FLASH_SECT = {
+  
+};
+static const unsigned char jswSymbolIndex_Socket = 43;
+static const JswSymPtr jswSymbols_Socket_proto[] FLASH_SECT = {
+  {0, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_stream_available},
+  {10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_net_socket_end},
+  {14, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_pipe},
+  {19, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_stream_read},
+  {24, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_net_socket_write}
+};
+static const unsigned char jswSymbolIndex_Socket_proto = 44;
+static const JswSymPtr jswSymbols_net[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_net_connect},
+  {8, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_net_createServer}
+};
+static const unsigned char jswSymbolIndex_net = 45;
+static const JswSymPtr jswSymbols_tls[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_tls_connect}
+};
+static const unsigned char jswSymbolIndex_tls = 46;
+static const JswSymPtr jswSymbols_Server_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_net_server_close},
+  {6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_net_server_listen}
+};
+static const unsigned char jswSymbolIndex_Server_proto = 47;
+static const JswSymPtr jswSymbols_httpSrv_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG, (void (*)(void))jswrap_net_server_close},
+  {6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_net_server_listen},
+  {13, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_httpSrv_route}
+};
+static const unsigned char jswSymbolIndex_httpSrv_proto = 48;
+static const JswSymPtr jswSymbols_httpSRq[] FLASH_SECT = {
+  
+};
+static const unsigned char jswSymbolIndex_httpSRq = 49;
+static const JswSymPtr jswSymbols_httpSRq_proto[] FLASH_SECT = {
+  {0, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_stream_available},
+  {10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_pipe},
+  {15, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_stream_read}
+};
+static const unsigned char jswSymbolIndex_httpSRq_proto = 50;
+static const JswSymPtr jswSymbols_httpSRs[] FLASH_SECT = {
+  
+};
+static const unsigned char jswSymbolIndex_httpSRs = 51;
+static const JswSymPtr jswSymbols_httpCRq[] FLASH_SECT = {
+  
+};
+static const unsigned char jswSymbolIndex_httpCRq = 52;
+static const JswSymPtr jswSymbols_httpCRs[] FLASH_SECT = {
+  
+};
+static const unsigned char jswSymbolIndex_httpCRs = 53;
+static const JswSymPtr jswSymbols_httpCRs_proto[] FLASH_SECT = {
+  {0, JSWAT_INT32 | JSWAT_THIS_ARG, (void (*)(void))jswrap_stream_available},
+  {10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_pipe},
+  {15, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void (*)(void))jswrap_stream_read}
+};
+static const unsigned char jswSymbolIndex_httpCRs_proto = 54;
+static const JswSymPtr jswSymbols_http[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_http_createServer},
+  {13, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_http_get},
+  {17, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))gen_jswrap_http_request}
+};
+static const unsigned char jswSymbolIndex_http = 55;
+static const JswSymPtr jswSymbols_httpSRs_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_httpSRs_end},
+  {4, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_httpSRs_write},
+  {10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void (*)(void))jswrap_httpSRs_writeHead}
+};
+static const unsigned char jswSymbolIndex_httpSRs_proto = 56;
+static const JswSymPtr jswSymbols_httpCRq_proto[] FLASH_SECT = {
+  {0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_net_socket_end},
+  {4, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_net_socket_write}
+};
+static const unsigned char jswSymbolIndex_httpCRq_proto = 57;
+static const JswSymPtr jswSymbols_NetworkJS[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_networkjs_create}
+};
+static const unsigned char jswSymbolIndex_NetworkJS = 58;
+static const JswSymPtr jswSymbols_Telnet[] FLASH_SECT = {
+  {0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_telnet_setOptions}
+};
+static const unsigned char jswSymbolIndex_Telnet = 59;
+static const JswSymPtr jswSymbols_hashlib[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_hashlib_sha224},
+  {7, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_hashlib_sha256}
+};
+static const unsigned char jswSymbolIndex_hashlib = 60;
+static const JswSymPtr jswSymbols_HASH_proto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_hashlib_hash_digest},
+  {7, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_hashlib_hash_hexdigest},
+  {17, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))jswrap_hashlib_hash_update}
+};
+static const unsigned char jswSymbolIndex_HASH_proto = 61;
+static const JswSymPtr jswSymbols_crypto[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void (*)(void))gen_jswrap_crypto_AES},
+  {4, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_crypto_PBKDF2},
+  {11, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_crypto_SHA1},
+  {16, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_crypto_SHA224},
+  {23, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_crypto_SHA256},
+  {30, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_crypto_SHA384},
+  {37, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void (*)(void))gen_jswrap_crypto_SHA512}
+};
+static const unsigned char jswSymbolIndex_crypto = 62;
+static const JswSymPtr jswSymbols_AES[] FLASH_SECT = {
+  {0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_crypto_AES_decrypt},
+  {8, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void (*)(void))jswrap_crypto_AES_encrypt}
+};
+static const unsigned char jswSymbolIndex_AES = 63;
+
+
+FLASH_STR(jswSymbols_global_str, "AES\0Array\0ArrayBuffer\0ArrayBufferView\0Boolean\0Date\0E\0Error\0File\0Float32Array\0Float64Array\0Function\0Graphics\0HASH\0HIGH\0I2C\0I2C1\0I2C2\0I2C3\0Infinity\0Int16Array\0Int32Array\0Int8Array\0InternalError\0JSON\0LOW\0LoopbackA\0LoopbackB\0Map\0Math\0Modules\0NaN\0Number\0Object\0OneWire\0Pin\0Promise\0ReferenceError\0SPI\0SPI1\0SPI2\0SPI3\0Serial\0Serial1\0Serial2\0Serial3\0Serial4\0Serial5\0Serial6\0Server\0Set\0Socket\0String\0SyntaxError\0TypeError\0USB\0Uint16Array\0Uint32Array\0Uint8Array\0Uint8ClampedArray\0Waveform\0analogRead\0analogWrite\0arguments\0atob\0btoa\0changeInterval\0clearInterval\0clearTimeout\0clearWatch\0console\0decodeURIComponent\0digitalPulse\0digitalRead\0digitalWrite\0dump\0echo\0edit\0encodeURIComponent\0eval\0getPinMode\0getSerial\0getTime\0global\0httpCRq\0httpCRs\0httpSRq\0httpSRs\0httpSrv\0isNaN\0load\0parseFloat\0parseInt\0peek16\0peek32\0peek8\0pinMode\0poke16\0poke32\0poke8\0print\0process\0require\0reset\0save\0setBusyIndicator\0setDeepSleep\0setInterval\0setSleepIndicator\0setTime\0setTimeout\0setWatch\0shiftOut\0trace\0url\0");
+FLASH_STR(jswSymbols_Array_proto_str, "concat\0every\0fill\0filter\0forEach\0indexOf\0join\0length\0map\0pop\0push\0reduce\0reverse\0shift\0slice\0some\0sort\0splice\0toString\0unshift\0");
+FLASH_STR(jswSymbols_Array_str, "isArray\0");
+FLASH_STR(jswSymbols_ArrayBufferView_proto_str, "buffer\0byteLength\0byteOffset\0fill\0forEach\0indexOf\0join\0map\0reduce\0reverse\0set\0slice\0sort\0");
+FLASH_STR(jswSymbols_Date_str, "now\0parse\0");
+FLASH_STR(jswSymbols_Date_proto_str, "getDate\0getDay\0getFullYear\0getHours\0getMilliseconds\0getMinutes\0getMonth\0getSeconds\0getTime\0getTimezoneOffset\0toString\0toUTCString\0valueOf\0");
+FLASH_STR(jswSymbols_Error_proto_str, "toString\0");
+FLASH_STR(jswSymbols_SyntaxError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_TypeError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_InternalError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_ReferenceError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_E_str, "FFT\0HSBtoRGB\0clip\0connectSDCard\0convolve\0dumpStr\0dumpTimers\0enableWatchdog\0getAnalogVRef\0getErrorFlags\0getFunctionCacheStats\0getSizeOf\0getTemperature\0hwRand\0interpolate\0interpolate2d\0mapInPlace\0memoryArea\0nativeCall\0openFile\0reverseByte\0setBootCode\0setClock\0setLowMemoryThresholds\0srand\0sum\0toArrayBuffer\0toString\0toUint8Array\0unmountSD\0variance\0");
+FLASH_STR(jswSymbols_Flash_str, "erasePage\0getFree\0getPage\0read\0write\0");
+FLASH_STR(jswSymbols_console_str, "log\0");
+FLASH_STR(jswSymbols_JSON_str, "parse\0stringify\0");
+FLASH_STR(jswSymbols_Map_proto_str, "clear\0delete\0entries\0forEach\0get\0has\0keys\0set\0size\0values\0");
+FLASH_STR(jswSymbols_Set_proto_str, "add\0clear\0delete\0entries\0forEach\0has\0keys\0size\0values\0");
+FLASH_STR(jswSymbols_Modules_str, "addCached\0getCached\0removeAllCached\0removeCached\0");
+FLASH_STR(jswSymbols_Pin_proto_str, "getInfo\0getMode\0mode\0read\0reset\0set\0write\0writeAtTime\0");
+FLASH_STR(jswSymbols_Number_str, "MAX_VALUE\0MIN_VALUE\0NEGATIVE_INFINITY\0NaN\0POSITIVE_INFINITY\0");
+FLASH_STR(jswSymbols_Number_proto_str, "toFixed\0");
+FLASH_STR(jswSymbols_Object_proto_str, "clone\0emit\0hasOwnProperty\0length\0on\0removeAllListeners\0removeListener\0toString\0valueOf\0");
+FLASH_STR(jswSymbols_Object_str, "create\0defineProperties\0defineProperty\0getOwnPropertyDescriptor\0getOwnPropertyNames\0getPrototypeOf\0keys\0setPrototypeOf\0");
+FLASH_STR(jswSymbols_Function_proto_str, "apply\0bind\0call\0replaceWith\0");
+FLASH_STR(jswSymbols_OneWire_proto_str, "read\0reset\0search\0search\0select\0skip\0write\0");
+FLASH_STR(jswSymbols_fs_str, "appendFile\0appendFileSync\0pipe\0readFile\0readFileSync\0readdir\0readdirSync\0statSync\0unlink\0unlinkSync\0writeFile\0writeFileSync\0");
+FLASH_STR(jswSymbols_process_str, "env\0memory\0version\0");
+FLASH_STR(jswSymbols_Promise_str, "all\0reject\0resolve\0");
+FLASH_STR(jswSymbols_Promise_proto_str, "catch\0then\0");
+FLASH_STR(jswSymbols_Serial_str, "find\0");
+FLASH_STR(jswSymbols_Serial_proto_str, "available\0getDropped\0onData\0pipe\0print\0println\0read\0setConsole\0setup\0write\0");
+FLASH_STR(jswSymbols_SPI_str, "find\0");
+FLASH_STR(jswSymbols_SPI_proto_str, "send\0send4bit\0send8bit\0setup\0write\0");
+FLASH_STR(jswSymbols_I2C_str, "find\0");
+FLASH_STR(jswSymbols_I2C_proto_str, "readFrom\0setup\0writeTo\0");
+FLASH_STR(jswSymbols_String_proto_str, "charAt\0charCodeAt\0indexOf\0lastIndexOf\0length\0replace\0slice\0split\0substr\0substring\0toLowerCase\0toUpperCase\0trim\0");
+FLASH_STR(jswSymbols_String_str, "fromCharCode\0");
+FLASH_STR(jswSymbols_Waveform_proto_str, "startInput\0startOutput\0stop\0");
+FLASH_STR(jswSymbols_File_proto_str, "close\0pipe\0read\0seek\0skip\0write\0");
+FLASH_STR(jswSymbols_Math_str, "E\0LN10\0LN2\0LOG10E\0LOG2E\0PI\0SQRT1_2\0SQRT2\0abs\0acos\0asin\0atan\0atan2\0ceil\0clip\0cos\0exp\0floor\0log\0max\0min\0pow\0random\0round\0sin\0sqrt\0tan\0wrap\0");
+FLASH_STR(jswSymbols_Graphics_str, "createArrayBuffer\0createCallback\0");
+FLASH_STR(jswSymbols_Graphics_proto_str, "clear\0drawImage\0drawLine\0drawRect\0drawString\0fillPoly\0fillRect\0getBgColor\0getColor\0getHeight\0getModified\0getPixel\0getWidth\0lineTo\0moveTo\0setBgColor\0setColor\0setFontBitmap\0setFontCustom\0setFontVector\0setPixel\0setRotation\0stringWidth\0");
+FLASH_STR(jswSymbols_url_str, "parse\0");
+FLASH_STR(jswSymbols_Socket_str, "");
+FLASH_STR(jswSymbols_Socket_proto_str, "available\0end\0pipe\0read\0write\0");
+FLASH_STR(jswSymbols_net_str, "connect\0createServer\0");
+FLASH_STR(jswSymbols_tls_str, "connect\0");
+FLASH_STR(jswSymbols_Server_proto_str, "close\0listen\0");
+FLASH_STR(jswSymbols_httpSrv_proto_str, "close\0listen\0route\0");
+FLASH_STR(jswSymbols_httpSRq_str, "");
+FLASH_STR(jswSymbols_httpSRq_proto_str, "available\0pipe\0read\0");
+FLASH_STR(jswSymbols_httpSRs_str, "");
+FLASH_STR(jswSymbols_httpCRq_str, "");
+FLASH_STR(jswSymbols_httpCRs_str, "");
+FLASH_STR(jswSymbols_httpCRs_proto_str, "available\0pipe\0read\0");
+FLASH_STR(jswSymbols_http_str, "createServer\0get\0request\0");
+FLASH_STR(jswSymbols_httpSRs_proto_str, "end\0write\0writeHead\0");
+FLASH_STR(jswSymbols_httpCRq_proto_str, "end\0write\0");
+FLASH_STR(jswSymbols_NetworkJS_str, "create\0");
+FLASH_STR(jswSymbols_Telnet_str, "setOptions\0");
+FLASH_STR(jswSymbols_hashlib_str, "sha224\0sha256\0");
+FLASH_STR(jswSymbols_HASH_proto_str, "digest\0hexdigest\0update\0");
+FLASH_STR(jswSymbols_crypto_str, "AES\0PBKDF2\0SHA1\0SHA224\0SHA256\0SHA384\0SHA512\0");
+FLASH_STR(jswSymbols_AES_str, "decrypt\0encrypt\0");
+
+const JswSymList jswSymbolTables[] FLASH_SECT = {
+  {jswSymbols_global, jswSymbols_global_str, 115},
+  {jswSymbols_Array_proto, jswSymbols_Array_proto_str, 20},
+  {jswSymbols_Array, jswSymbols_Array_str, 1},
+  {jswSymbols_ArrayBufferView_proto, jswSymbols_ArrayBufferView_proto_str, 13},
+  {jswSymbols_Date, jswSymbols_Date_str, 2},
+  {jswSymbols_Date_proto, jswSymbols_Date_proto_str, 13},
+  {jswSymbols_Error_proto, jswSymbols_Error_proto_str, 1},
+  {jswSymbols_SyntaxError_proto, jswSymbols_SyntaxError_proto_str, 1},
+  {jswSymbols_TypeError_proto, jswSymbols_TypeError_proto_str, 1},
+  {jswSymbols_InternalError_proto, jswSymbols_InternalError_proto_str, 1},
+  {jswSymbols_ReferenceError_proto, jswSymbols_ReferenceError_proto_str, 1},
+  {jswSymbols_E, jswSymbols_E_str, 31},
+  {jswSymbols_Flash, jswSymbols_Flash_str, 5},
+  {jswSymbols_console, jswSymbols_console_str, 1},
+  {jswSymbols_JSON, jswSymbols_JSON_str, 2},
+  {jswSymbols_Map_proto, jswSymbols_Map_proto_str, 10},
+  {jswSymbols_Set_proto, jswSymbols_Set_proto_str, 9},
+  {jswSymbols_Modules, jswSymbols_Modules_str, 4},
+  {jswSymbols_Pin_proto, jswSymbols_Pin_proto_str, 8},
+  {jswSymbols_Number, jswSymbols_Number_str, 5},
+  {jswSymbols_Number_proto, jswSymbols_Number_proto_str, 1},
+  {jswSymbols_Object_proto, jswSymbols_Object_proto_str, 9},
+  {jswSymbols_Object, jswSymbols_Object_str, 8},
+  {jswSymbols_Function_proto, jswSymbols_Function_proto_str, 4},
+  {jswSymbols_OneWire_proto, jswSymbols_OneWire_proto_str, 7},
+  {jswSymbols_fs, jswSymbols_fs_str, 12},
+  {jswSymbols_process, jswSymbols_process_str, 3},
+  {jswSymbols_Promise, jswSymbols_Promise_str, 3},
+  {jswSymbols_Promise_proto, jswSymbols_Promise_proto_str, 2},
+  {jswSymbols_Serial, jswSymbols_Serial_str, 1},
+  {jswSymbols_Serial_proto, jswSymbols_Serial_proto_str, 10},
+  {jswSymbols_SPI, jswSymbols_SPI_str, 1},
+  {jswSymbols_SPI_proto, jswSymbols_SPI_proto_str, 5},
+  {jswSymbols_I2C, jswSymbols_I2C_str, 1},
+  {jswSymbols_I2C_proto, jswSymbols_I2C_proto_str, 3},
+  {jswSymbols_String_proto, jswSymbols_String_proto_str, 13},
+  {jswSymbols_String, jswSymbols_String_str, 1},
+  {jswSymbols_Waveform_proto, jswSymbols_Waveform_proto_str, 3},
+  {jswSymbols_File_proto, jswSymbols_File_proto_str, 6},
+  {jswSymbols_Math, jswSymbols_Math_str, 28},
+  {jswSymbols_Graphics, jswSymbols_Graphics_str, 2},
+  {jswSymbols_Graphics_proto, jswSymbols_Graphics_proto_str, 23},
+  {jswSymbols_url, jswSymbols_url_str, 1},
+  {jswSymbols_Socket, jswSymbols_Socket_str, 0},
+  {jswSymbols_Socket_proto, jswSymbols_Socket_proto_str, 5},
+  {jswSymbols_net, jswSymbols_net_str, 2},
+  {jswSymbols_tls, jswSymbols_tls_str, 1},
+  {jswSymbols_Server_proto, jswSymbols_Server_proto_str, 2},
+  {jswSymbols_httpSrv_proto, jswSymbols_httpSrv_proto_str, 3},
+  {jswSymbols_httpSRq, jswSymbols_httpSRq_str, 0},
+  {jswSymbols_httpSRq_proto, jswSymbols_httpSRq_proto_str, 3},
+  {jswSymbols_httpSRs, jswSymbols_httpSRs_str, 0},
+  {jswSymbols_httpCRq, jswSymbols_httpCRq_str, 0},
+  {jswSymbols_httpCRs, jswSymbols_httpCRs_str, 0},
+  {jswSymbols_httpCRs_proto, jswSymbols_httpCRs_proto_str, 3},
+  {jswSymbols_http, jswSymbols_http_str, 3},
+  {jswSymbols_httpSRs_proto, jswSymbols_httpSRs_proto_str, 3},
+  {jswSymbols_httpCRq_proto, jswSymbols_httpCRq_proto_str, 2},
+  {jswSymbols_NetworkJS, jswSymbols_NetworkJS_str, 1},
+  {jswSymbols_Telnet, jswSymbols_Telnet_str, 1},
+  {jswSymbols_hashlib, jswSymbols_hashlib_str, 2},
+  {jswSymbols_HASH_proto, jswSymbols_HASH_proto_str, 3},
+  {jswSymbols_crypto, jswSymbols_crypto_str, 7},
+  {jswSymbols_AES, jswSymbols_AES_str, 2},
+};
+
+
+JsVar *jswFindBuiltInFunction(JsVar *parent, const char *name) {
+  JsVar *v;
+  if (parent && !jsvIsRoot(parent)) {
+    // ------------------------------------------ INSTANCE + STATIC METHODS
+    if (jsvIsNativeFunction(parent)) {
+      if ((void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Array], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_date_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Date], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_E_E) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_E], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Flash_Flash) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Flash], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_console_console) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_console], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_JSON_JSON) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_JSON], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Modules_Modules) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Modules], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Number], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_object_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Object], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_fs_fs) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_fs], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_process_process) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_process], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_promise_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Promise], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Serial_Serial) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Serial], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_spi_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_SPI], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_I2C_I2C) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_I2C], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_String], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Math_Math) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Math], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Graphics_Graphics) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Graphics], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_url_url) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_url], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Socket_Socket) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Socket], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_net_net) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_net], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_tls_tls) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_tls], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRq_httpSRq) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpSRq], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRs_httpSRs) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpSRs], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRq_httpCRq) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpCRq], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRs_httpCRs) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpCRs], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_http_http) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_http], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_NetworkJS_NetworkJS) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_NetworkJS], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Telnet_Telnet) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Telnet], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_hashlib_hashlib) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_hashlib], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_crypto_crypto) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_crypto], parent, name);
+        if (v) return v;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_AES_AES) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_AES], parent, name);
+        if (v) return v;
+      }
+    }
+    if (jsvIsArray(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Array_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type!=ARRAYBUFFERVIEW_ARRAYBUFFER) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsPin(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Pin_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsInt(parent) || jsvIsFloat(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Number_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsFunction(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Function_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsString(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_String_proto], parent, name);
+      if (v) return v;
+    }
+    // ------------------------------------------ INSTANCE METHODS WE MUST CHECK CONSTRUCTOR FOR
+    JsVar *proto = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_INHERITS_VAR, false)):0;
+    JsVar *constructor = jsvIsObject(proto)?jsvSkipNameAndUnLock(jsvFindChildFromString(proto, JSPARSE_CONSTRUCTOR_VAR, false)):0;
+    jsvUnLock(proto);
+    if (constructor && jsvIsNativeFunction(constructor)) {
+      void *constructorPtr = constructor->varData.native.ptr;
+      jsvUnLock(constructor);
+      if (constructorPtr==(void*)jswrap_date_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Date_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_error_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Error_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_syntaxerror_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_SyntaxError_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_typeerror_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_TypeError_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_internalerror_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_InternalError_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_referenceerror_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_ReferenceError_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_map_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Map_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_set_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Set_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_onewire_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_OneWire_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_promise_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Promise_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_Serial_Serial) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Serial_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_spi_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_SPI_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_I2C_I2C) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_I2C_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)jswrap_waveform_constructor) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Waveform_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_File_File) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_File_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_Graphics_Graphics) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Graphics_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_Socket_Socket) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Socket_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_Server_Server) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Server_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSrv_httpSrv) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpSrv_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSRq_httpSRq) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpSRq_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_httpCRs_httpCRs) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpCRs_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSRs_httpSRs) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpSRs_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_httpCRq_httpCRq) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_httpCRq_proto], parent, name);
+        if (v) return v;
+      } else if (constructorPtr==(void*)gen_jswrap_HASH_HASH) {
+        v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_HASH_proto], parent, name);
+        if (v) return v;
+      }
+    } else {
+      jsvUnLock(constructor);
+    }
+    // ------------------------------------------ METHODS ON OBJECT
+    v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Object_proto], parent, name);
+    if (v) return v;
+  } else { /* if (!parent) */
+    // ------------------------------------------ FUNCTIONS
+    // Handle pin names - eg LED1 or D5 (this is hardcoded in build_jsfunctions.py)
+    Pin pin = jshGetPinFromString(name);
+    if (pin != PIN_UNDEFINED) {
+      return jsvNewFromPin(pin);
+    }
+    return jswBinarySearch(&jswSymbolTables[jswSymbolIndex_global], parent, name);
+  }
+  return 0;
+}
+
+
+#ifndef SAVE_ON_FLASH
+bool jswFindBuiltInSymbol(JsVar *parent, const char *name, JswBuiltInSymbol *symbol) {
+  if (!parent || jsvIsRoot(parent)) return false;
+    // ------------------------------------------ INSTANCE + STATIC METHODS
+    if (jsvIsNativeFunction(parent)) {
+      if ((void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Array], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_date_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Date], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_E_E) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_E], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Flash_Flash) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Flash], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_console_console) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_console], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_JSON_JSON) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_JSON], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Modules_Modules) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Modules], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Number], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_object_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Object], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_fs_fs) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_fs], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_process_process) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_process], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_promise_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Promise], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Serial_Serial) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Serial], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_spi_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_SPI], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_I2C_I2C) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_I2C], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_String], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Math_Math) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Math], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Graphics_Graphics) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Graphics], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_url_url) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_url], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Socket_Socket) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Socket], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_net_net) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_net], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_tls_tls) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_tls], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRq_httpSRq) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpSRq], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRs_httpSRs) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpSRs], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRq_httpCRq) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpCRq], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRs_httpCRs) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpCRs], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_http_http) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_http], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_NetworkJS_NetworkJS) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_NetworkJS], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Telnet_Telnet) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Telnet], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_hashlib_hashlib) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_hashlib], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_crypto_crypto) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_crypto], name, symbol)) return true;
+      } else if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_AES_AES) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_AES], name, symbol)) return true;
+      }
+    }
+    if (jsvIsArray(parent)) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Array_proto], name, symbol)) return true;
+    }
+    if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type!=ARRAYBUFFERVIEW_ARRAYBUFFER) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto], name, symbol)) return true;
+    }
+    if (jsvIsPin(parent)) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Pin_proto], name, symbol)) return true;
+    }
+    if (jsvIsInt(parent) || jsvIsFloat(parent)) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Number_proto], name, symbol)) return true;
+    }
+    if (jsvIsFunction(parent)) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Function_proto], name, symbol)) return true;
+    }
+    if (jsvIsString(parent)) {
+      if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_String_proto], name, symbol)) return true;
+    }
+    // ------------------------------------------ INSTANCE METHODS WE MUST CHECK CONSTRUCTOR FOR
+    JsVar *proto = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_INHERITS_VAR, false)):0;
+    JsVar *constructor = jsvIsObject(proto)?jsvSkipNameAndUnLock(jsvFindChildFromString(proto, JSPARSE_CONSTRUCTOR_VAR, false)):0;
+    jsvUnLock(proto);
+    if (constructor && jsvIsNativeFunction(constructor)) {
+      void *constructorPtr = constructor->varData.native.ptr;
+      jsvUnLock(constructor);
+      if (constructorPtr==(void*)jswrap_date_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Date_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_error_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Error_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_syntaxerror_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_SyntaxError_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_typeerror_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_TypeError_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_internalerror_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_InternalError_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_referenceerror_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_ReferenceError_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_map_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Map_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_set_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Set_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_onewire_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_OneWire_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_promise_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Promise_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_Serial_Serial) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Serial_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_spi_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_SPI_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_I2C_I2C) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_I2C_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)jswrap_waveform_constructor) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Waveform_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_File_File) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_File_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_Graphics_Graphics) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Graphics_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_Socket_Socket) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Socket_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_Server_Server) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Server_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSrv_httpSrv) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpSrv_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSRq_httpSRq) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpSRq_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_httpCRs_httpCRs) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpCRs_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_httpSRs_httpSRs) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpSRs_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_httpCRq_httpCRq) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_httpCRq_proto], name, symbol)) return true;
+      } else if (constructorPtr==(void*)gen_jswrap_HASH_HASH) {
+        if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_HASH_proto], name, symbol)) return true;
+      }
+    } else {
+      jsvUnLock(constructor);
+    }
+    // ------------------------------------------ METHODS ON OBJECT
+    if (jswBinarySearchSymbol(&jswSymbolTables[jswSymbolIndex_Object_proto], name, symbol)) return true;
+  return false;
+}
+#endif
+
+
+const JswSymList *jswGetSymbolListForObject(JsVar *parent) {
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) return &jswSymbolTables[jswSymbolIndex_Array];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_date_constructor) return &jswSymbolTables[jswSymbolIndex_Date];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_E_E) return &jswSymbolTables[jswSymbolIndex_E];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Flash_Flash) return &jswSymbolTables[jswSymbolIndex_Flash];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_console_console) return &jswSymbolTables[jswSymbolIndex_console];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_JSON_JSON) return &jswSymbolTables[jswSymbolIndex_JSON];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Modules_Modules) return &jswSymbolTables[jswSymbolIndex_Modules];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) return &jswSymbolTables[jswSymbolIndex_Number];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_object_constructor) return &jswSymbolTables[jswSymbolIndex_Object];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_fs_fs) return &jswSymbolTables[jswSymbolIndex_fs];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_process_process) return &jswSymbolTables[jswSymbolIndex_process];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_promise_constructor) return &jswSymbolTables[jswSymbolIndex_Promise];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Serial_Serial) return &jswSymbolTables[jswSymbolIndex_Serial];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_spi_constructor) return &jswSymbolTables[jswSymbolIndex_SPI];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_I2C_I2C) return &jswSymbolTables[jswSymbolIndex_I2C];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) return &jswSymbolTables[jswSymbolIndex_String];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Math_Math) return &jswSymbolTables[jswSymbolIndex_Math];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Graphics_Graphics) return &jswSymbolTables[jswSymbolIndex_Graphics];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_url_url) return &jswSymbolTables[jswSymbolIndex_url];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Socket_Socket) return &jswSymbolTables[jswSymbolIndex_Socket];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_net_net) return &jswSymbolTables[jswSymbolIndex_net];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_tls_tls) return &jswSymbolTables[jswSymbolIndex_tls];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRq_httpSRq) return &jswSymbolTables[jswSymbolIndex_httpSRq];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRs_httpSRs) return &jswSymbolTables[jswSymbolIndex_httpSRs];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRq_httpCRq) return &jswSymbolTables[jswSymbolIndex_httpCRq];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRs_httpCRs) return &jswSymbolTables[jswSymbolIndex_httpCRs];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_http_http) return &jswSymbolTables[jswSymbolIndex_http];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_NetworkJS_NetworkJS) return &jswSymbolTables[jswSymbolIndex_NetworkJS];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_Telnet_Telnet) return &jswSymbolTables[jswSymbolIndex_Telnet];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_hashlib_hashlib) return &jswSymbolTables[jswSymbolIndex_hashlib];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_crypto_crypto) return &jswSymbolTables[jswSymbolIndex_crypto];
+  if (jsvIsNativeFunction(parent) && (void*)parent->varData.native.ptr==(void*)gen_jswrap_AES_AES) return &jswSymbolTables[jswSymbolIndex_AES];
+  if (parent==execInfo.root) return &jswSymbolTables[jswSymbolIndex_global];
+  return 0;
+}
+
+
+const JswSymList *jswGetSymbolListForObjectProto(JsVar *parent) {
+  if (jsvIsNativeFunction(parent)) {
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) return &jswSymbolTables[jswSymbolIndex_Array_proto];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_ArrayBufferView_ArrayBufferView) return &jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_pin_constructor) return &jswSymbolTables[jswSymbolIndex_Pin_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) return &jswSymbolTables[jswSymbolIndex_Number_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_function_constructor) return &jswSymbolTables[jswSymbolIndex_Function_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) return &jswSymbolTables[jswSymbolIndex_String_proto];
+  }
+  JsVar *constructor = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_CONSTRUCTOR_VAR, false)):0;
+  if (constructor && jsvIsNativeFunction(constructor)) {
+    void *constructorPtr = constructor->varData.native.ptr;
+   jsvUnLock(constructor);
+    if (constructorPtr==(void*)jswrap_date_constructor) return &jswSymbolTables[jswSymbolIndex_Date_proto];
+    if (constructorPtr==(void*)jswrap_error_constructor) return &jswSymbolTables[jswSymbolIndex_Error_proto];
+    if (constructorPtr==(void*)jswrap_syntaxerror_constructor) return &jswSymbolTables[jswSymbolIndex_SyntaxError_proto];
+    if (constructorPtr==(void*)jswrap_typeerror_constructor) return &jswSymbolTables[jswSymbolIndex_TypeError_proto];
+    if (constructorPtr==(void*)jswrap_internalerror_constructor) return &jswSymbolTables[jswSymbolIndex_InternalError_proto];
+    if (constructorPtr==(void*)jswrap_referenceerror_constructor) return &jswSymbolTables[jswSymbolIndex_ReferenceError_proto];
+    if (constructorPtr==(void*)jswrap_map_constructor) return &jswSymbolTables[jswSymbolIndex_Map_proto];
+    if (constructorPtr==(void*)jswrap_set_constructor) return &jswSymbolTables[jswSymbolIndex_Set_proto];
+    if (constructorPtr==(void*)jswrap_onewire_constructor) return &jswSymbolTables[jswSymbolIndex_OneWire_proto];
+    if (constructorPtr==(void*)jswrap_promise_constructor) return &jswSymbolTables[jswSymbolIndex_Promise_proto];
+    if (constructorPtr==(void*)gen_jswrap_Serial_Serial) return &jswSymbolTables[jswSymbolIndex_Serial_proto];
+    if (constructorPtr==(void*)jswrap_spi_constructor) return &jswSymbolTables[jswSymbolIndex_SPI_proto];
+    if (constructorPtr==(void*)gen_jswrap_I2C_I2C) return &jswSymbolTables[jswSymbolIndex_I2C_proto];
+    if (constructorPtr==(void*)jswrap_waveform_constructor) return &jswSymbolTables[jswSymbolIndex_Waveform_proto];
+    if (constructorPtr==(void*)gen_jswrap_File_File) return &jswSymbolTables[jswSymbolIndex_File_proto];
+    if (constructorPtr==(void*)gen_jswrap_Graphics_Graphics) return &jswSymbolTables[jswSymbolIndex_Graphics_proto];
+    if (constructorPtr==(void*)gen_jswrap_Socket_Socket) return &jswSymbolTables[jswSymbolIndex_Socket_proto];
+    if (constructorPtr==(void*)gen_jswrap_Server_Server) return &jswSymbolTables[jswSymbolIndex_Server_proto];
+    if (constructorPtr==(void*)gen_jswrap_httpSrv_httpSrv) return &jswSymbolTables[jswSymbolIndex_httpSrv_proto];
+    if (constructorPtr==(void*)gen_jswrap_httpSRq_httpSRq) return &jswSymbolTables[jswSymbolIndex_httpSRq_proto];
+    if (constructorPtr==(void*)gen_jswrap_httpCRs_httpCRs) return &jswSymbolTables[jswSymbolIndex_httpCRs_proto];
+    if (constructorPtr==(void*)gen_jswrap_httpSRs_httpSRs) return &jswSymbolTables[jswSymbolIndex_httpSRs_proto];
+    if (constructorPtr==(void*)gen_jswrap_httpCRq_httpCRq) return &jswSymbolTables[jswSymbolIndex_httpCRq_proto];
+    if (constructorPtr==(void*)gen_jswrap_HASH_HASH) return &jswSymbolTables[jswSymbolIndex_HASH_proto];
+  }
+    if (jsvIsArray(parent)) return &jswSymbolTables[jswSymbolIndex_Array_proto];
+    if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type!=ARRAYBUFFERVIEW_ARRAYBUFFER) return &jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto];
+    if (jsvIsPin(parent)) return &jswSymbolTables[jswSymbolIndex_Pin_proto];
+    if (jsvIsInt(parent) || jsvIsFloat(parent)) return &jswSymbolTables[jswSymbolIndex_Number_proto];
+    if (jsvIsFunction(parent)) return &jswSymbolTables[jswSymbolIndex_Function_proto];
+    if (jsvIsString(parent)) return &jswSymbolTables[jswSymbolIndex_String_proto];
+  return &jswSymbolTables[jswSymbolIndex_Object_proto];
+}
+
+
+bool jswIsBuiltInObject(const char *name) {
+  return
+strcmp(name, "Array")==0 ||
+    strcmp(name, "ArrayBuffer")==0 ||
+    strcmp(name, "ArrayBufferView")==0 ||
+    strcmp(name, "Uint8Array")==0 ||
+    strcmp(name, "Uint8ClampedArray")==0 ||
+    strcmp(name, "Int8Array")==0 ||
+    strcmp(name, "Uint16Array")==0 ||
+    strcmp(name, "Int16Array")==0 ||
+    strcmp(name, "Uint32Array")==0 ||
+    strcmp(name, "Int32Array")==0 ||
+    strcmp(name, "Float32Array")==0 ||
+    strcmp(name, "Float64Array")==0 ||
+    strcmp(name, "Date")==0 ||
+    strcmp(name, "Error")==0 ||
+    strcmp(name, "SyntaxError")==0 ||
+    strcmp(name, "TypeError")==0 ||
+    strcmp(name, "InternalError")==0 ||
+    strcmp(name, "ReferenceError")==0 ||
+    strcmp(name, "E")==0 ||
+    strcmp(name, "Function")==0 ||
+    strcmp(name, "console")==0 ||
+    strcmp(name, "JSON")==0 ||
+    strcmp(name, "Map")==0 ||
+    strcmp(name, "Set")==0 ||
+    strcmp(name, "Modules")==0 ||
+    strcmp(name, "Pin")==0 ||
+    strcmp(name, "Number")==0 ||
+    strcmp(name, "Object")==0 ||
+    strcmp(name, "Boolean")==0 ||
+    strcmp(name, "OneWire")==0 ||
+    strcmp(name, "process")==0 ||
+    strcmp(name, "Promise")==0 ||
+    strcmp(name, "Serial")==0 ||
+    strcmp(name, "SPI")==0 ||
+    strcmp(name, "I2C")==0 ||
+    strcmp(name, "String")==0 ||
+    strcmp(name, "Waveform")==0 ||
+    strcmp(name, "File")==0 ||
+    strcmp(name, "Math")==0 ||
+    strcmp(name, "Graphics")==0 ||
+    strcmp(name, "url")==0 ||
+    strcmp(name, "Server")==0 ||
+    strcmp(name, "Socket")==0 ||
+    strcmp(name, "httpSrv")==0 ||
+    strcmp(name, "httpSRq")==0 ||
+    strcmp(name, "httpSRs")==0 ||
+    strcmp(name, "httpCRq")==0 ||
+    strcmp(name, "httpCRs")==0 ||
+    strcmp(name, "HASH")==0 ||
+    strcmp(name, "AES")==0;
+}
+
+
+void *jswGetBuiltInLibrary(const char *name) {
+if (strcmp(name, "Flash")==0) return (void*)gen_jswrap_Flash_Flash;
+if (strcmp(name, "fs")==0) return (void*)gen_jswrap_fs_fs;
+if (strcmp(name, "net")==0) return (void*)gen_jswrap_net_net;
+if (strcmp(name, "tls")==0) return (void*)gen_jswrap_tls_tls;
+if (strcmp(name, "http")==0) return (void*)gen_jswrap_http_http;
+if (strcmp(name, "NetworkJS")==0) return (void*)gen_jswrap_NetworkJS_NetworkJS;
+if (strcmp(name, "Telnet")==0) return (void*)gen_jswrap_Telnet_Telnet;
+if (strcmp(name, "hashlib")==0) return (void*)gen_jswrap_hashlib_hashlib;
+if (strcmp(name, "crypto")==0) return (void*)gen_jswrap_crypto_crypto;
+  return 0;
+}
+
+
+/** Given a variable, return the basic object name of it */
+const char *jswGetBasicObjectName(JsVar *var) {
+  if (jsvIsArray(var)) return "Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_ARRAYBUFFER) return "ArrayBuffer";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT8) return "Uint8Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==(ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED)) return "Uint8ClampedArray";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT8) return "Int8Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT16) return "Uint16Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT16) return "Int16Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT32) return "Uint32Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT32) return "Int32Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_FLOAT32) return "Float32Array";
+  if (jsvIsArrayBuffer(var) && var->varData.arraybuffer.type==ARRAYBUFFERVIEW_FLOAT64) return "Float64Array";
+  if (jsvIsPin(var)) return "Pin";
+  if (jsvIsNumeric(var)) return "Number";
+  if (jsvIsObject(var)) return "Object";
+  if (jsvIsFunction(var)) return "Function";
+  if (jsvIsString(var)) return "String";
+  return 0;
+}
+
+
+/** Given the name of a Basic Object, eg, Uint8Array, String, etc. Return the prototype object's name - or 0. */
+const char *jswGetBasicObjectPrototypeName(const char *objectName) {
+  if (!strcmp(objectName, "Uint8Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint8ClampedArray")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int8Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint16Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int16Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Float32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Float64Array")) return "ArrayBufferView";
+  return strcmp(objectName,"Object") ? "Object" : 0;
+}
+
+
+/** Native state for built-in classes - see JSW_NATIVE_STATE */
+JswMapState *jswNewState_Map(JsVar *parent) {
+  return (JswMapState*)jsvObjectNewNativeState(parent, sizeof(JswMapState), 1);
+}
+JswMapState *jswGetState_Map(JsVar *parent) {
+  return (JswMapState*)jsvObjectGetNativeState(parent, sizeof(JswMapState), 1);
+}
+JswMapState *jswNewState_Set(JsVar *parent) {
+  return (JswMapState*)jsvObjectNewNativeState(parent, sizeof(JswMapState), 1);
+}
+JswMapState *jswGetState_Set(JsVar *parent) {
+  return (JswMapState*)jsvObjectGetNativeState(parent, sizeof(JswMapState), 1);
+}
+JswOneWireState *jswNewState_OneWire(JsVar *parent) {
+  return (JswOneWireState*)jsvObjectNewNativeState(parent, sizeof(JswOneWireState), 2);
+}
+JswOneWireState *jswGetState_OneWire(JsVar *parent) {
+  return (JswOneWireState*)jsvObjectGetNativeState(parent, sizeof(JswOneWireState), 2);
+}
+JswWaveformState *jswNewState_Waveform(JsVar *parent) {
+  return (JswWaveformState*)jsvObjectNewNativeState(parent, sizeof(JswWaveformState), 3);
+}
+JswWaveformState *jswGetState_Waveform(JsVar *parent) {
+  return (JswWaveformState*)jsvObjectGetNativeState(parent, sizeof(JswWaveformState), 3);
+}
+/** Called by jsvCopy once 'dst' has its own copy of src's native state block */
+void jswCopyState(JsVar *src, JsVar *dst, unsigned char typeId) {
+  switch (typeId) {
+    case 1: jswrap_map_copyState(src, dst); break;
+    default: break; // the block is all the state there is
+  }
+}
+
+
+/** Tasks to run on Idle. Returns true if either one of the tasks returned true (eg. they're doing something and want to avoid sleeping) */
+bool jswIdle() {
+  bool wasBusy = false;
+  if (jswrap_pipe_idle()) wasBusy = true;
+  if (jswrap_waveform_idle()) wasBusy = true;
+  if (jswrap_graphics_idle()) wasBusy = true;
+  if (jswrap_net_idle()) wasBusy = true;
+  if (jswrap_telnet_idle()) wasBusy = true;
+  return wasBusy;
+}
+
+
+/** Tasks to run on Initialisation */
+void jswInit() {
+  jswrap_graphics_init();
+  jswrap_net_init();
+  jswrap_telnet_init();
+}
+
+
+/** Tasks to run on Deinitialisation */
+void jswKill() {
+  jswrap_function_cache_kill();
+  jswrap_pipe_kill();
+  jswrap_waveform_kill();
+  jswrap_file_kill();
+  jswrap_net_kill();
+  jswrap_telnet_kill();
+}
+
+
@@ -67,6 +67,8 @@ bool graphicsGetFromVar(JsGraphics *gfx, JsVar *parent) {
     gfx->setPixel = graphicsFallbackSetPixel;
     gfx->getPixel = graphicsFallbackGetPixel;
     gfx->fillRect = graphicsFallbackFillRect;
+    gfx->batch = 0;
+    gfx->batchCount = 0;
 #ifdef USE_LCD_SDL
     if (gfx->data.type == JSGRAPHICSTYPE_SDL) {
       lcdSetCallbacks_SDL(gfx);
@@ -102,6 +104,8 @@ void graphicsSetVar(JsGraphics *gfx) {
   assert(data);
   jsvSetString(data, (char*)&gfx->data, sizeof(JsGraphicsData));
   jsvUnLock(data);
+  // graphicsSetVar is called when each drawing operation finishes, so send anything that was batched up to JS
+  if (gfx->batchCount) lcdFlush_JS(gfx);
 }
 
 // ----------------------------------------------------------------------------------------------
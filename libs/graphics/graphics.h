@@ -71,6 +71,9 @@ typedef struct JsGraphics {
   void (*setPixel)(struct JsGraphics *gfx, short x, short y, unsigned int col);
   void (*fillRect)(struct JsGraphics *gfx, short x1, short y1, short x2, short y2);
   unsigned int (*getPixel)(struct JsGraphics *gfx, short x, short y);
+
+  unsigned int *batch; ///< JSGRAPHICSTYPE_JS: rectangles waiting to be sent to the 'fillRects' callback (see lcd_js.c)
+  unsigned short batchCount; ///< number of rectangles in 'batch'
 } PACKED_FLAGS JsGraphics;
 
 static inline void graphicsStructInit(JsGraphics *gfx) {
@@ -85,6 +88,8 @@ static inline void graphicsStructInit(JsGraphics *gfx) {
   gfx->data.modMaxY = -32768;
   gfx->data.modMinX = 32767;
   gfx->data.modMinY = 32767;
+  gfx->batch = 0;
+  gfx->batchCount = 0;
 }
 
 // ---------------------------------- these are in graphics.c
@@ -165,12 +165,20 @@ JsVar *jswrap_graphics_createArrayBuffer(int width, int height, int bpp, JsVar *
     ["width","int32","Pixels wide"],
     ["height","int32","Pixels high"],
     ["bpp","int32","Number of bits per pixel"],
-    ["callback","JsVar","A function of the form ```function(x,y,col)``` that is called whenever a pixel needs to be drawn, or an object with: ```{setPixel:function(x,y,col),fillRect:function(x1,y1,x2,y2,col)}```. All arguments are already bounds checked."]
+    ["callback","JsVar","A function of the form ```function(x,y,col)``` that is called whenever a pixel needs to be drawn, or an object with: ```{setPixel:function(x,y,col),fillRect:function(x1,y1,x2,y2,col),fillRects:function(rects,count)}```. All arguments are already bounds checked."]
   ],
   "return" : ["JsVar","The new Graphics object"],
   "return_object" : "Graphics"
 }
 Create a Graphics object that renders by calling a JavaScript callback function to draw pixels
+
+Calling JavaScript for every pixel is slow, so if `fillRects` is supplied it is
+used instead of `setPixel` and `fillRect`. Pixels and rectangles are collected
+as each drawing operation runs (runs of pixels of the same colour are joined into
+one rectangle), and `fillRects` is called when the operation finishes (or after
+32 rectangles). `rects` is a `Uint32Array` of `[x1,y1,x2,y2,col, x1,y1,x2,y2,col, ...]`
+and `count` is how many rectangles are in it. The same array is reused for every
+call, so copy anything you want to keep.
 */
 JsVar *jswrap_graphics_createCallback(int width, int height, int bpp, JsVar *callback) {
   if (width<=0 || height<=0 || width>1023 || height>1023) {
@@ -183,25 +191,35 @@ JsVar *jswrap_graphics_createCallback(int width, int height, int bpp, JsVar *cal
   }
   JsVar *callbackSetPixel = 0;
   JsVar *callbackFillRect = 0;
+  JsVar *callbackFillRects = 0;
   if (jsvIsObject(callback)) {
     jsvUnLock(callbackSetPixel);
     callbackSetPixel = jsvObjectGetChild(callback, "setPixel", 0);
     callbackFillRect = jsvObjectGetChild(callback, "fillRect", 0);
+    callbackFillRects = jsvObjectGetChild(callback, "fillRects", 0);
   } else
     callbackSetPixel = jsvLockAgain(callback);
-  if (!jsvIsFunction(callbackSetPixel)) {
+  if (!jsvIsFunction(callbackSetPixel) && !(jsvIsUndefined(callbackSetPixel) && jsvIsFunction(callbackFillRects))) {
     jsExceptionHere(JSET_ERROR, "Expecting Callback Function or an Object but got %t", callbackSetPixel);
-    jsvUnLock2(callbackSetPixel, callbackFillRect);
+    jsvUnLock3(callbackSetPixel, callbackFillRect, callbackFillRects);
     return 0;
   }
   if (!jsvIsUndefined(callbackFillRect) && !jsvIsFunction(callbackFillRect)) {
     jsExceptionHere(JSET_ERROR, "Expecting Callback Function or an Object but got %t", callbackFillRect);
-    jsvUnLock2(callbackSetPixel, callbackFillRect);
+    jsvUnLock3(callbackSetPixel, callbackFillRect, callbackFillRects);
+    return 0;
+  }
+  if (!jsvIsUndefined(callbackFillRects) && !jsvIsFunction(callbackFillRects)) {
+    jsExceptionHere(JSET_ERROR, "Expecting Callback Function or an Object but got %t", callbackFillRects);
+    jsvUnLock3(callbackSetPixel, callbackFillRect, callbackFillRects);
     return 0;
   }
 
   JsVar *parent = jspNewObject(0, "Graphics");
-  if (!parent) return 0; // low memory
+  if (!parent) {
+    jsvUnLock3(callbackSetPixel, callbackFillRect, callbackFillRects);
+    return 0; // low memory
+  }
 
   JsGraphics gfx;
   graphicsStructInit(&gfx);
@@ -210,9 +228,9 @@ JsVar *jswrap_graphics_createCallback(int width, int height, int bpp, JsVar *cal
   gfx.data.width = (unsigned short)width;
   gfx.data.height = (unsigned short)height;
   gfx.data.bpp = (unsigned char)bpp;
-  lcdInit_JS(&gfx, callbackSetPixel, callbackFillRect);
+  lcdInit_JS(&gfx, callbackSetPixel, callbackFillRect, callbackFillRects);
   graphicsSetVar(&gfx);
-  jsvUnLock2(callbackSetPixel, callbackFillRect);
+  jsvUnLock3(callbackSetPixel, callbackFillRect, callbackFillRects);
   return parent;
 }
 
@@ -13,9 +13,11 @@
  */
 
 #include "lcd_arraybuffer.h"
+#include "lcd_js.h"
 #include "jsvar.h"
 #include "jsparse.h"
 #include "jsinteractive.h"
+#include "jswrap_arraybuffer.h"
 
 
 void lcdSetPixel_JS(JsGraphics *gfx, short x, short y, unsigned int col) {
@@ -52,12 +54,94 @@ void  lcdFillRect_JS(struct JsGraphics *gfx, short x1, short y1, short x2, short
     graphicsFallbackFillRect(gfx, x1,y1,x2,y2);
 }
 
-void lcdInit_JS(JsGraphics *gfx, JsVar *setPixelCallback, JsVar *fillRectCallback) {
+// ----------------------------------------------------------------------------
+// Batched mode - rectangles (pixels are just 1x1 rectangles) are stored in a
+// Uint32Array of LCD_JS_BATCH_RECTS*[x1,y1,x2,y2,col] and 'fillRects' is called
+// with all of them when the drawing operation finishes or the array is full.
+
+/// Call 'fillRects' with everything in the batch
+void lcdFlush_JS(JsGraphics *gfx) {
+  JsVar *fillRects = jsvObjectGetChild(gfx->graphicsVar, "iFillRects", 0);
+  JsVar *args[2];
+  args[0] = jsvObjectGetChild(gfx->graphicsVar, "iRects", 0);
+  args[1] = jsvNewFromInteger(gfx->batchCount);
+  // JS could do anything, so get the pointer again next time
+  gfx->batch = 0;
+  gfx->batchCount = 0;
+  if (fillRects && args[0])
+    jsvUnLock(jspExecuteFunction(fillRects, gfx->graphicsVar, 2, args));
+  jsvUnLockMany(2, args);
+  jsvUnLock(fillRects);
+}
+
+static void lcdBatchRect_JS(JsGraphics *gfx, short x1, short y1, short x2, short y2, unsigned int col) {
+  if (gfx->batch && gfx->batchCount) {
+    // Try and join this on to the last rectangle - this turns pixels into runs
+    unsigned int *last = &gfx->batch[(gfx->batchCount-1)*5];
+    if (last[4]==col) {
+      if (last[1]==(unsigned int)y1 && last[3]==(unsigned int)y2 && last[2]+1==(unsigned int)x1) {
+        last[2] = (unsigned int)x2;
+        return;
+      }
+      if (last[0]==(unsigned int)x1 && last[2]==(unsigned int)x2 && last[3]+1==(unsigned int)y1) {
+        last[3] = (unsigned int)y2;
+        return;
+      }
+    }
+  }
+  if (gfx->batchCount >= LCD_JS_BATCH_RECTS)
+    lcdFlush_JS(gfx);
+  if (!gfx->batch) {
+    JsVar *rects = jsvObjectGetChild(gfx->graphicsVar, "iRects", 0);
+    JsVar *str = jsvIsArrayBuffer(rects) ? jsvGetArrayBufferBackingString(rects) : 0;
+    if (jsvIsFlatString(str))
+      gfx->batch = (unsigned int*)jsvGetFlatStringPointer(str);
+    jsvUnLock2(str, rects);
+    if (!gfx->batch) return; // someone removed our array
+  }
+  unsigned int *r = &gfx->batch[gfx->batchCount*5];
+  r[0] = (unsigned int)x1;
+  r[1] = (unsigned int)y1;
+  r[2] = (unsigned int)x2;
+  r[3] = (unsigned int)y2;
+  r[4] = col;
+  gfx->batchCount++;
+}
+
+static void lcdSetPixel_JSBatch(JsGraphics *gfx, short x, short y, unsigned int col) {
+  lcdBatchRect_JS(gfx, x, y, x, y, col);
+}
+
+static void lcdFillRect_JSBatch(struct JsGraphics *gfx, short x1, short y1, short x2, short y2) {
+  lcdBatchRect_JS(gfx, x1, y1, x2, y2, gfx->data.fgColor);
+}
+
+// ----------------------------------------------------------------------------
+
+void lcdInit_JS(JsGraphics *gfx, JsVar *setPixelCallback, JsVar *fillRectCallback, JsVar *fillRectsCallback) {
   jsvObjectSetChild(gfx->graphicsVar, "iSetPixel", setPixelCallback);
   jsvObjectSetChild(gfx->graphicsVar, "iFillRect", fillRectCallback);
+  if (fillRectsCallback) {
+    // the array is reused for every batch, so it must be flat so we can write to it directly
+    char *ptr = 0;
+    JsVar *buf = jsvNewArrayBufferWithPtr(LCD_JS_BATCH_RECTS*5*sizeof(unsigned int), &ptr);
+    JsVar *rects = buf ? jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT32, buf, 0, 0) : 0;
+    if (rects) {
+      jsvObjectSetChild(gfx->graphicsVar, "iFillRects", fillRectsCallback);
+      jsvObjectSetChild(gfx->graphicsVar, "iRects", rects);
+    }
+    jsvUnLock2(rects, buf);
+  }
 }
 
 void lcdSetCallbacks_JS(JsGraphics *gfx) {
-  gfx->setPixel = lcdSetPixel_JS;
-  gfx->fillRect = lcdFillRect_JS;
+  JsVar *rects = jsvObjectGetChild(gfx->graphicsVar, "iRects", 0);
+  if (rects) {
+    gfx->setPixel = lcdSetPixel_JSBatch;
+    gfx->fillRect = lcdFillRect_JSBatch;
+  } else {
+    gfx->setPixel = lcdSetPixel_JS;
+    gfx->fillRect = lcdFillRect_JS;
+  }
+  jsvUnLock(rects);
 }
@@ -13,5 +13,11 @@
  */
 #include "graphics.h"
 
-void lcdInit_JS(JsGraphics *gfx, JsVar *setPixelCallback, JsVar *fillRectCallback);
+/// How many rectangles are sent to a 'fillRects' callback at once
+#ifndef LCD_JS_BATCH_RECTS
+#define LCD_JS_BATCH_RECTS 32
+#endif
+
+void lcdInit_JS(JsGraphics *gfx, JsVar *setPixelCallback, JsVar *fillRectCallback, JsVar *fillRectsCallback);
 void lcdSetCallbacks_JS(JsGraphics *gfx);
+void lcdFlush_JS(JsGraphics *gfx);
@@ -40,12 +40,58 @@ The HTTP server created by `require('http').createServer`
 */
 // there is a 'connect' event on httpSrv, but it's used by createServer and isn't node-compliant
 
+/*JSON{
+  "type" : "method",
+  "class" : "httpSrv",
+  "name" : "route",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_httpSrv_route",
+  "params" : [
+    ["method","JsVar","The HTTP method to handle, eg. `\"GET\"` (converted to upper case, so `\"get\"` works too). `undefined` or `\"*\"` handles any method"],
+    ["path","JsVar","The path to handle, eg. `\"/index.html\"`. `:name` matches one part of the path (which is put in `req.params.name`, with `%XX` escapes decoded) and a `*` at the end matches anything"],
+    ["callback","JsVar","A function(request,response) that will be called for matching requests"]
+  ]
+}
+Handle requests for the given method and path with their own callback. Routes are
+matched natively, in the order they were added, against the path of the URL (the query
+string is ignored). Requests that don't match any route are handled by the callback given
+to `createServer`, or are sent a 404 if there isn't one.
+
+```
+var server = require("http").createServer();
+server.route("GET", "/", function(req, res) { res.end("Hello"); });
+server.route("GET", "/led/:state", function(req, res) {
+  LED1.write(req.params.state=="on");
+  res.end("OK");
+});
+server.listen(80);
+```
+*/
+void jswrap_httpSrv_route(JsVar *parent, JsVar *method, JsVar *path, JsVar *callback) {
+  if (!jsvIsUndefined(method) && !jsvIsString(method)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting method to be a String or undefined, got %t", method);
+    return;
+  }
+  if (!jsvIsString(path)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting path to be a String, got %t", path);
+    return;
+  }
+  if (!jsvIsFunction(callback)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting Callback Function but got %t", callback);
+    return;
+  }
+  serverAddRoute(parent, method, path, callback);
+}
+
 /*JSON{
   "type" : "class",
   "library" : "http",
   "class" : "httpSRq"
 }
-The HTTP server request
+The HTTP server request. Before its handler is called it is given `method` (eg. `"GET"`),
+`url` (eg. `"/foo.html?a=b"`), `headers` (an object containing the request's headers) and
+`query` (the query string of the URL decoded into an object - the same as
+`url.parse(req.url,true).query` except that this is an empty object if there's no query string).
 */
 /*JSON{
   "type" : "event",
@@ -220,7 +266,7 @@ Pipe this to a stream (an object with a 'write' method)
   "name" : "createServer",
   "generate" : "jswrap_http_createServer",
   "params" : [
-    ["callback","JsVar","A function(request,response) that will be called when a connection is made"]
+    ["callback","JsVar","A function(request,response) that will be called when a connection is made. This can be left out if `httpSrv.route` is used"]
   ],
   "return" : ["JsVar","Returns a new httpSrv object"],
   "return_object" : "httpSrv"
@@ -228,11 +274,13 @@ Pipe this to a stream (an object with a 'write' method)
 Create an HTTP Server
 
 When a request to the server is made, the callback is called. In the callback you can use the methods on the response (httpSRs) to send data. You can also add `request.on('data',function() { ... })` to listen for POSTed data
+
+Requests can also be handled by method and path with `httpSrv.route`.
 */
 
 JsVar *jswrap_http_createServer(JsVar *callback) {
   JsVar *skippedCallback = jsvSkipName(callback);
-  if (!jsvIsFunction(skippedCallback)) {
+  if (!jsvIsUndefined(skippedCallback) && !jsvIsFunction(skippedCallback)) {
     jsError("Expecting Callback Function but got %t", skippedCallback);
     jsvUnLock(skippedCallback);
     return 0;
@@ -339,7 +387,8 @@ JsVar *jswrap_http_get(JsVar *options, JsVar *callback) {
   "name" : "listen",
   "generate" : "jswrap_net_server_listen",
   "params" : [
-    ["port","int32","The port to listen on"]
+    ["port","int32","The port to listen on"],
+    ["options","JsVar","[optional] An object of options, as for `Server.listen`: `{backlog, maxAccept}`"]
   ]
 }
 Start listening for new HTTP connections on the given port
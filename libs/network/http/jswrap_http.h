@@ -14,6 +14,7 @@
 #include "jsvar.h"
 
 JsVar *jswrap_http_createServer(JsVar *callback);
+void jswrap_httpSrv_route(JsVar *parent, JsVar *method, JsVar *path, JsVar *callback);
 
 JsVar *jswrap_http_request(JsVar *options, JsVar *callback);
 JsVar *jswrap_http_get(JsVar *options, JsVar *callback);
@@ -152,55 +152,13 @@ JsVar *jswrap_url_parse(JsVar *url, bool parseQuery) {
 
   jsvObjectSetChildAndUnLock(obj, "port", (portNumber<=0 || portNumber>65535) ? jsvNewWithFlags(JSV_NULL) : jsvNewFromInteger(portNumber));
 
-  JsVar *query = (searchStart>=0)?jsvNewFromStringVar(url, (size_t)(searchStart+1), JSVAPPENDSTRINGVAR_MAXLENGTH):jsvNewNull();
-  if (parseQuery && !jsvIsNull(query)) {
-    JsVar *queryStr = query;
-    jsvStringIteratorNew(&it, query, 0);
-    query = jsvNewObject();
-
-    JsVar *key = jsvNewFromEmptyString();
-    JsVar *val = jsvNewFromEmptyString();
-    bool hadEquals = false;
-
-    while (jsvStringIteratorHasChar(&it)) {
-      char ch = jsvStringIteratorGetChar(&it);
-      if (ch=='&') {
-        if (jsvGetStringLength(key)>0 || jsvGetStringLength(val)>0) {
-          key = jsvAsArrayIndexAndUnLock(key); // make sure "0" gets made into 0
-          jsvMakeIntoVariableName(key, val);
-          jsvAddName(query, key);
-          jsvUnLock2(key, val);
-          key = jsvNewFromEmptyString();
-          val = jsvNewFromEmptyString();
-          hadEquals = false;
-        }
-      } else if (!hadEquals && ch=='=') {
-        hadEquals = true;
-      } else {
-        // decode percent escape chars
-        if (ch=='%') {
-          jsvStringIteratorNext(&it);
-          ch = jsvStringIteratorGetChar(&it);
-          jsvStringIteratorNext(&it);
-          ch = (char)((chtod(ch)<<4) | chtod(jsvStringIteratorGetChar(&it)));
-        }
-
-        if (hadEquals) jsvAppendCharacter(val, ch);
-        else jsvAppendCharacter(key, ch);
-      }
-      jsvStringIteratorNext(&it);
-      charIdx++;
-    }
-    jsvStringIteratorFree(&it);
-    jsvUnLock(queryStr);
-
-    if (jsvGetStringLength(key)>0 || jsvGetStringLength(val)>0) {
-      key = jsvAsArrayIndexAndUnLock(key); // make sure "0" gets made into 0
-      jsvMakeIntoVariableName(key, val);
-      jsvAddName(query, key);
-    }
-    jsvUnLock2(key, val);
-  }
+  JsVar *query;
+  if (searchStart<0)
+    query = jsvNewNull();
+  else if (parseQuery)
+    query = httpParseQuery(url, (size_t)(searchStart+1), (size_t)charIdx);
+  else
+    query = jsvNewFromStringVar(url, (size_t)(searchStart+1), JSVAPPENDSTRINGVAR_MAXLENGTH);
   jsvObjectSetChildAndUnLock(obj, "query", query);
 
   return obj;
@@ -481,17 +439,23 @@ https://engineering.circle.com/https-authorized-certs-with-node-js/
   "name" : "listen",
   "generate" : "jswrap_net_server_listen",
   "params" : [
-    ["port","int32","The port to listen on"]
+    ["port","int32","The port to listen on"],
+    ["options","JsVar","[optional] An object of options - see below"]
   ]
 }
-Start listening for new connections on the given port
+Start listening for new connections on the given port.
+
+`options` can contain:
+
+* `backlog` - how many connections can wait to be accepted before new ones are refused (default is 10, and may be ignored by some network devices)
+* `maxAccept` - the most connections that will be accepted in one pass of the idle loop (default 16)
 */
 
-void jswrap_net_server_listen(JsVar *parent, int port) {
+void jswrap_net_server_listen(JsVar *parent, int port, JsVar *options) {
   JsNetwork net;
   if (!networkGetFromVarIfOnline(&net)) return;
 
-  serverListen(&net, parent, port);
+  serverListen(&net, parent, port, options);
   networkFree(&net);
 }
 
@@ -23,7 +23,7 @@ JsVar *jswrap_url_parse(JsVar *url, bool parseQuery);
 JsVar *jswrap_net_createServer(JsVar *callback);
 JsVar *jswrap_net_connect(JsVar *options, JsVar *callback, SocketType socketType);
 
-void jswrap_net_server_listen(JsVar *parent, int port);
+void jswrap_net_server_listen(JsVar *parent, int port, JsVar *options);
 void jswrap_net_server_close(JsVar *parent);
 
 bool jswrap_net_socket_write(JsVar *parent, JsVar *data);
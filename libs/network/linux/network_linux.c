@@ -13,6 +13,7 @@
  */
 #include "network.h"
 #include "network_linux.h"
+#include "socketerrors.h"
 
 #include <string.h> // for memset
 
@@ -26,6 +27,7 @@
 #else
  #include <sys/socket.h>
  #include <sys/select.h>
+ #include <poll.h>
  #include <arpa/inet.h>
  #include <netdb.h>
  #include <netinet/in.h>
@@ -33,6 +35,7 @@
  #include <fcntl.h>
  #include <stdio.h>
  #include <resolv.h>
+ #include <pthread.h>
  typedef struct sockaddr_in sockaddr_in;
  typedef int SOCKET;
 #endif
@@ -40,17 +43,238 @@
  #define closesocket(SOCK) close(SOCK)
 
 
-/// Get an IP address from a name. Sets out_ip_addr to 0 on failure
+/// How long (in ms) we remember a name that resolved
+#define DNS_CACHE_TTL 60000
+/// How long (in ms) we remember a name that failed to resolve
+#define DNS_CACHE_FAIL_TTL 5000
+#define DNS_CACHE_SIZE 8
+
+/// Name lookups are done on another thread (getaddrinfo) and remembered here
+typedef struct {
+  char name[128];
+  uint32_t ip;         ///< 0 if the name couldn't be resolved
+  JsSysTime expires;   ///< after this time the entry must be looked up again
+  bool pending;        ///< a thread is still resolving this name
+  bool resolved;       ///< the thread has finished, but 'expires' hasn't been set yet
+  unsigned char sockets; ///< how many sockets are waiting on this entry (it can't be reused until 0)
+} DnsCacheEntry;
+
+static DnsCacheEntry dnsCache[DNS_CACHE_SIZE];
+static pthread_mutex_t dnsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** While a name is still being looked up, gethostbyname returns the address
+ * 0.0.0.(entry+1) so createsocket knows which dnsCache entry to wait for.
+ * Nothing can connect to 0.0.0.0/8 so these can't be mistaken for a real host. */
+#define DNS_PENDING_ADDR(ENTRY) htonl((uint32_t)(ENTRY)+1)
+/// The dnsCache entry a DNS_PENDING_ADDR refers to, or -1 if it's a real address
+static int net_linux_dnsPendingEntry(uint32_t host) {
+  uint32_t h = ntohl(host);
+  return (h>=1 && h<=DNS_CACHE_SIZE) ? (int)h-1 : -1;
+}
+
+/// What state each client socket is in while it connects
+typedef enum {
+  LSS_NONE,       ///< connected, a server, or accepted - just use it
+  LSS_RESOLVING,  ///< waiting for dnsCache[dnsEntry] to be resolved before we connect
+  LSS_CONNECTING, ///< connect() returned EINPROGRESS
+  LSS_FAILED,     ///< connecting failed with 'error' - returned until the socket is closed
+} LinuxSocketState;
+
+typedef struct {
+  LinuxSocketState state;
+  signed char error;
+  unsigned char dnsEntry;
+  unsigned short port;
+} LinuxSocket;
+
+/// Client sockets numbered above this can't be created (server connections have no limit)
+#define LINUX_MAX_SOCKETS 4096
+static LinuxSocket linuxSockets[LINUX_MAX_SOCKETS];
+
+/// Check without blocking if a socket can be read from (or written to). Returns >0 if it can (or has an error), 0 if not, <0 on failure
+static int net_linux_poll(int sckt, bool forWrite) {
+#ifdef WIN32
+  fd_set s;
+  FD_ZERO(&s);
+  FD_SET(sckt,&s);
+  struct timeval timeout;
+  timeout.tv_sec = 0;
+  timeout.tv_usec = 0;
+  return select(sckt+1, forWrite?NULL:&s, forWrite?&s:NULL, NULL, &timeout);
+#else
+  // poll rather than select, as select can't handle sockets numbered FD_SETSIZE (1024) or more
+  struct pollfd p;
+  p.fd = sckt;
+  p.events = forWrite ? POLLOUT : POLLIN;
+  p.revents = 0;
+  return poll(&p, 1, 0);
+#endif
+}
+
+/// Resolve dnsCache[arg] with getaddrinfo - run on its own thread
+static void *net_linux_dnsThread(void *arg) {
+  DnsCacheEntry *e = &dnsCache[(intptr_t)arg];
+  char name[sizeof(e->name)];
+  pthread_mutex_lock(&dnsMutex);
+  memcpy(name, e->name, sizeof(name));
+  pthread_mutex_unlock(&dnsMutex);
+
+  uint32_t ip = 0;
+  struct addrinfo hints, *res = 0;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(name, 0, &hints, &res)==0 && res) {
+    ip = (uint32_t)((struct sockaddr_in*)res->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(res);
+  }
+
+  pthread_mutex_lock(&dnsMutex);
+  e->ip = ip;
+  e->pending = false;
+  e->resolved = true; // the main thread sets 'expires' - see net_linux_dnsCollect
+  pthread_mutex_unlock(&dnsMutex);
+  return 0;
+}
+
+/// Start the lifetime of any entries the DNS threads have finished. Call with dnsMutex held
+static void net_linux_dnsCollect(JsSysTime now) {
+  int i;
+  for (i=0;i<DNS_CACHE_SIZE;i++) {
+    DnsCacheEntry *e = &dnsCache[i];
+    if (e->resolved) {
+      e->resolved = false;
+      e->expires = now + jshGetTimeFromMilliseconds(e->ip ? DNS_CACHE_TTL : DNS_CACHE_FAIL_TTL);
+    }
+  }
+}
+
+/// Get an IP address from a name. Sets out_ip_addr to 0 on failure, or a DNS_PENDING_ADDR if it is still being looked up
 void net_linux_gethostbyname(JsNetwork *net, char * hostName, uint32_t* out_ip_addr) {
   NOT_USED(net);
+  JsSysTime now = jshGetSystemTime();
+  int i, entry = -1, freeEntry = -1;
+  pthread_mutex_lock(&dnsMutex);
+  net_linux_dnsCollect(now);
+  for (i=0;i<DNS_CACHE_SIZE;i++) {
+    DnsCacheEntry *e = &dnsCache[i];
+    if (e->name[0] && strncmp(e->name, hostName, sizeof(e->name))==0) {
+      entry = i;
+      break;
+    }
+    // otherwise pick something unused, or that will expire soonest
+    if (!e->pending && !e->sockets &&
+        (freeEntry<0 || !e->name[0] || (dnsCache[freeEntry].name[0] && e->expires < dnsCache[freeEntry].expires)))
+      freeEntry = i;
+  }
+  if (entry>=0 && (dnsCache[entry].pending || dnsCache[entry].expires > now)) {
+    // still resolving, or resolved and not expired
+    *out_ip_addr = dnsCache[entry].pending ? DNS_PENDING_ADDR(entry) : dnsCache[entry].ip;
+    pthread_mutex_unlock(&dnsMutex);
+    return;
+  }
+  if (entry<0) entry = freeEntry;
+  if (entry>=0) {
+    DnsCacheEntry *e = &dnsCache[entry];
+    strncpy(e->name, hostName, sizeof(e->name)-1);
+    e->name[sizeof(e->name)-1] = 0;
+    e->pending = true;
+    pthread_t thread;
+    if (pthread_create(&thread, 0, net_linux_dnsThread, (void*)(intptr_t)entry)==0) {
+      pthread_detach(thread);
+      *out_ip_addr = DNS_PENDING_ADDR(entry);
+      pthread_mutex_unlock(&dnsMutex);
+      return;
+    }
+    e->pending = false;
+    e->name[0] = 0;
+  }
+  pthread_mutex_unlock(&dnsMutex);
+  // every entry is busy, or we couldn't start a thread - just block
   struct hostent * host_addr_p = gethostbyname(hostName);
   if (host_addr_p)
     *out_ip_addr = *(uint32_t*)*host_addr_p->h_addr_list;
 }
 
+/// Convert an errno from connect into a SOCKET_ERR_...
+static int net_linux_getConnectError(int err) {
+  switch (err) {
+    case ECONNREFUSED: return SOCKET_ERR_REFUSED;
+    case ECONNRESET: return SOCKET_ERR_RESET;
+    case ETIMEDOUT: return SOCKET_ERR_TIMEOUT;
+    case EHOSTUNREACH:
+    case ENETUNREACH: return SOCKET_ERR_NO_ROUTE;
+    default: return SOCKET_ERR_UNKNOWN;
+  }
+}
+
+/// Start connecting a (non-blocking) socket. Returns 0 on success or a SOCKET_ERR_... if it failed immediately
+static int net_linux_connect(int sckt, uint32_t host, unsigned short port) {
+  sockaddr_in       sin;
+  memset(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_port = htons( port );
+  sin.sin_addr.s_addr = (in_addr_t)host;
+
+  int res = connect(sckt,(struct sockaddr *)&sin, sizeof(sockaddr_in) );
+  LinuxSocket *s = &linuxSockets[sckt];
+  s->state = LSS_NONE;
+  if (res == SOCKET_ERROR) {
+  #ifdef WIN_OS
+   int err = WSAGetLastError();
+  #else
+   int err = errno;
+  #endif
+   if (err != EINPROGRESS &&
+       err != EWOULDBLOCK)
+     return net_linux_getConnectError(err);
+   s->state = LSS_CONNECTING;
+  }
+  return 0;
+}
+
+/** Move a client socket along if it's still resolving or connecting. Returns
+ * 1 if it's ready to use, 0 if we're still waiting, or a SOCKET_ERR_... */
+static int net_linux_checkConnection(int sckt) {
+  if (sckt<0 || sckt>=LINUX_MAX_SOCKETS) return 1;
+  LinuxSocket *s = &linuxSockets[sckt];
+  if (s->state == LSS_RESOLVING) {
+    DnsCacheEntry *e = &dnsCache[s->dnsEntry];
+    pthread_mutex_lock(&dnsMutex);
+    bool pending = e->pending;
+    uint32_t ip = e->ip;
+    if (!pending) e->sockets--;
+    pthread_mutex_unlock(&dnsMutex);
+    if (pending) return 0;
+    int err = ip ? net_linux_connect(sckt, ip, s->port) : SOCKET_ERR_NOT_FOUND;
+    if (err) {
+      s->state = LSS_FAILED;
+      s->error = (signed char)err;
+    }
+  }
+  if (s->state == LSS_CONNECTING) {
+    if (net_linux_poll(sckt, true) <= 0)
+      return 0; // not connected yet
+    int err = 0;
+    socklen_t errLen = sizeof(err);
+    if (getsockopt(sckt, SOL_SOCKET, SO_ERROR, (char*)&err, &errLen) < 0)
+      err = errno;
+    if (err) {
+      s->state = LSS_FAILED;
+      s->error = (signed char)net_linux_getConnectError(err);
+    } else
+      s->state = LSS_NONE;
+  }
+  if (s->state == LSS_FAILED) return s->error;
+  return 1;
+}
+
 /// Called on idle. Do any checks required for this device
 void net_linux_idle(JsNetwork *net) {
   NOT_USED(net);
+  pthread_mutex_lock(&dnsMutex);
+  net_linux_dnsCollect(jshGetSystemTime());
+  pthread_mutex_unlock(&dnsMutex);
 }
 
 /// Call just before returning to idle loop. This checks for errors and tries to recover. Returns true if no errors.
@@ -62,38 +286,40 @@ bool net_linux_checkError(JsNetwork *net) {
 
 /// if host=0, creates a server otherwise creates a client (and automatically connects). Returns >=0 on success
 int net_linux_createsocket(JsNetwork *net, uint32_t host, unsigned short port) {
-  NOT_USED(net);
   int sckt = -1;
   if (host!=0) { // ------------------------------------------------- host (=client)
-    sockaddr_in       sin;
-    sin.sin_family = AF_INET;
-    sin.sin_port = htons( port );
-
     sckt = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (sckt<0) return sckt; // error
+    if (sckt>=LINUX_MAX_SOCKETS) { // we couldn't keep track of it
+      closesocket(sckt);
+      return -1;
+    }
 
-    // turn on non-blocking mode
+    // turn on non-blocking mode, so connect returns immediately and we check on it from idle
     #ifdef WIN_OS
     u_long n = 1;
     ioctlsocket(sckt,FIONBIO,&n);
-    #endif
-
-    sin.sin_addr.s_addr = (in_addr_t)host;
-
-    int res = connect(sckt,(struct sockaddr *)&sin, sizeof(sockaddr_in) );
-
-    if (res == SOCKET_ERROR) {
-    #ifdef WIN_OS
-     int err = WSAGetLastError();
     #else
-     int err = errno;
+    fcntl(sckt, F_SETFL, fcntl(sckt, F_GETFL, 0) | O_NONBLOCK);
     #endif
-     if (err != EINPROGRESS &&
-         err != EWOULDBLOCK) {
-       jsError("Connect failed (err %d)\n", err );
-       closesocket(sckt);
-       return -1;
-     }
+
+    LinuxSocket *s = &linuxSockets[sckt];
+    int dnsEntry = net_linux_dnsPendingEntry(host);
+    if (dnsEntry>=0) {
+      // gethostbyname is still working on it - connect when it's done
+      pthread_mutex_lock(&dnsMutex);
+      dnsCache[dnsEntry].sockets++;
+      pthread_mutex_unlock(&dnsMutex);
+      s->state = LSS_RESOLVING;
+      s->dnsEntry = (unsigned char)dnsEntry;
+      s->port = port;
+    } else {
+      int err = net_linux_connect(sckt, host, port);
+      if (err) {
+        // report it from recv/send, as it would have been if the connect had been slow
+        s->state = LSS_FAILED;
+        s->error = (signed char)err;
+      }
     }
 
   } else { // ------------------------------------------------- no host (=server)
@@ -123,8 +349,8 @@ int net_linux_createsocket(JsNetwork *net, uint32_t host, unsigned short port) {
       return -1;
     }
 
-    // Make the socket listen
-    nret = listen(sckt, 10); // 10 connections (but this ignored on CC30000)
+    // Make the socket listen - by default 10 connections can wait to be accepted
+    nret = listen(sckt, net->listenBacklog>0 ? net->listenBacklog : 10);
     if (nret == SOCKET_ERROR) {
       jsError("Socket listen failed");
       closesocket(sckt);
@@ -145,6 +371,15 @@ int net_linux_createsocket(JsNetwork *net, uint32_t host, unsigned short port) {
 /// destroys the given socket
 void net_linux_closesocket(JsNetwork *net, int sckt) {
   NOT_USED(net);
+  if (sckt>=0 && sckt<LINUX_MAX_SOCKETS) {
+    LinuxSocket *s = &linuxSockets[sckt];
+    if (s->state == LSS_RESOLVING) {
+      pthread_mutex_lock(&dnsMutex);
+      dnsCache[s->dnsEntry].sockets--;
+      pthread_mutex_unlock(&dnsMutex);
+    }
+    s->state = LSS_NONE;
+  }
   closesocket(sckt);
 }
 
@@ -152,14 +387,8 @@ void net_linux_closesocket(JsNetwork *net, int sckt) {
 int net_linux_accept(JsNetwork *net, int sckt) {
   NOT_USED(net);
   // TODO: look for unreffed servers?
-  fd_set s;
-  FD_ZERO(&s);
-  FD_SET(sckt,&s);
   // check for waiting clients
-  struct timeval timeout;
-  timeout.tv_sec = 0;
-  timeout.tv_usec = 0;
-  int n = select(sckt+1,&s,NULL,NULL,&timeout);
+  int n = net_linux_poll(sckt, false);
   if (n>0) {
     // we have a client waiting to connect... try to connect and see what happens
     int theClient = accept(sckt,0,0);
@@ -171,22 +400,18 @@ int net_linux_accept(JsNetwork *net, int sckt) {
 /// Receive data if possible. returns nBytes on success, 0 on no data, or -1 on failure
 int net_linux_recv(JsNetwork *net, int sckt, void *buf, size_t len) {
   NOT_USED(net);
+  int r = net_linux_checkConnection(sckt);
+  if (r==0) return SOCKET_ERR_NO_CONN;
+  if (r<0) return r;
   int num = 0;
-  fd_set s;
-  FD_ZERO(&s);
-  FD_SET(sckt,&s);
-  // check for waiting clients
-  struct timeval timeout;
-  timeout.tv_sec = 0;
-  timeout.tv_usec = 0;
-  int n = select(sckt+1,&s,NULL,NULL,&timeout);
+  int n = net_linux_poll(sckt, false);
   if (n==SOCKET_ERROR) {
     // we probably disconnected
     return -1;
   } else if (n>0) {
     // receive data
     num = (int)recv(sckt,buf,len,0);
-    if (num==0) num=-1; // select says data, but recv says 0 means connection is closed
+    if (num==0) num=-1; // poll says data, but recv says 0 means connection is closed
   }
 
   return num;
@@ -195,22 +420,20 @@ int net_linux_recv(JsNetwork *net, int sckt, void *buf, size_t len) {
 /// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
 int net_linux_send(JsNetwork *net, int sckt, const void *buf, size_t len) {
   NOT_USED(net);
-  fd_set writefds;
-  FD_ZERO(&writefds);
-  FD_SET(sckt, &writefds);
-  struct timeval time;
-  time.tv_sec = 0;
-  time.tv_usec = 0;
-  int n = select(sckt+1, 0, &writefds, 0, &time);
+  int r = net_linux_checkConnection(sckt);
+  if (r<=0) return r;
+  int n = net_linux_poll(sckt, true);
   if (n==SOCKET_ERROR ) {
      // we probably disconnected so just get rid of this
     return -1;
-  } else if (FD_ISSET(sckt, &writefds)) {
+  } else if (n>0) {
     int flags = 0;
 #if !defined(SO_NOSIGPIPE) && defined(MSG_NOSIGNAL)
     flags |= MSG_NOSIGNAL;
 #endif
     n = (int)send(sckt, buf, len, flags);
+    if (n<0 && (errno==EAGAIN || errno==EWOULDBLOCK))
+      return 0; // non-blocking, and the buffer filled up after all
     return n;
   } else
     return 0; // just not ready
@@ -14,6 +14,7 @@
 #include "network.h"
 #include "jsparse.h"
 #include "jsinteractive.h"
+#include "socketerrors.h"
 #ifdef USE_FILESYSTEM
   #include "jswrap_functions.h"
   #include "jswrap_fs.h"
@@ -156,7 +157,9 @@ unsigned long networkFlipIPAddress(unsigned long addr) {
  * function to resolve the hostname.
  *
  * A value of 0 returned for an IP address means we could NOT resolve the hostname.
- * A value of 0xFFFFFFFF for an IP address means that we haven't found it YET.
+ * A value of 0xFFFFFFFF for an IP address means that we haven't found it YET
+ * (a network may use other addresses it can't connect to for this, so its
+ * createsocket knows which lookup to wait for).
  */
 void networkGetHostByName(
     JsNetwork *net,        //!< The network we are using for resolution.
@@ -288,7 +291,11 @@ typedef struct {
   mbedtls_ssl_config conf;
 } SSLSocketData;
 
-BITFIELD_DECL(socketIsHTTPS, 32);
+/// Only sockets numbered below this can use TLS
+#define TLS_MAX_SOCKETS 32
+BITFIELD_DECL(socketIsHTTPS, TLS_MAX_SOCKETS);
+/// Is the given socket using TLS? Sockets may be numbered far higher than TLS_MAX_SOCKETS on Linux
+#define SOCKET_IS_HTTPS(sckt) ((sckt)>=0 && (sckt)<TLS_MAX_SOCKETS && BITFIELD_GET(socketIsHTTPS, sckt))
 
 static void ssl_debug( void *ctx, int level,
                       const char *file, int line, const char *str )
@@ -311,7 +318,7 @@ int ssl_recv(void *ctx, unsigned char *buf, size_t len) {
   assert(net);
   int sckt = *(int *)ctx;
   int r = net->recv(net, sckt, buf, len);
-  if (r==0) return MBEDTLS_ERR_SSL_WANT_READ;
+  if (r==0 || r==SOCKET_ERR_NO_CONN) return MBEDTLS_ERR_SSL_WANT_READ; // no data, or still connecting
   return r;
 }
 
@@ -503,7 +510,7 @@ bool ssl_newSocketData(int sckt, JsVar *options) {
    * Also see https://tls.mbed.org/kb/how-to/reduce-mbedtls-memory-and-storage-footprint
    * */
 
-  assert(sckt>=0 && sckt<32);
+  assert(sckt>=0 && sckt<TLS_MAX_SOCKETS);
   // Create a new socketData using the variable
   JsVar *ssl = jsvObjectGetChild(execInfo.root, "ssl", JSV_OBJECT);
   if (!ssl) return false; // out of memory?
@@ -663,16 +670,21 @@ bool netCheckError(JsNetwork *net) {
 }
 
 int netCreateSocket(JsNetwork *net, uint32_t host, unsigned short port, NetCreateFlags flags, JsVar *options) {
+  net->listenBacklog = 0;
+  if (!host && jsvIsObject(options))
+    net->listenBacklog = (int)jsvGetIntegerAndUnLock(jsvObjectGetChild(options, "backlog", 0));
   int sckt = net->createsocket(net, host, port);
   if (sckt<0) return sckt;
 
 #ifdef USE_TLS
-  assert(sckt>=0 && sckt<32);
-  BITFIELD_SET(socketIsHTTPS, sckt, 0);
+  assert(sckt>=0);
+  if (sckt<TLS_MAX_SOCKETS)
+    BITFIELD_SET(socketIsHTTPS, sckt, 0);
   if (flags & NCF_TLS) {
-    if (ssl_newSocketData(sckt, options)) {
+    if (sckt<TLS_MAX_SOCKETS && ssl_newSocketData(sckt, options)) {
       BITFIELD_SET(socketIsHTTPS, sckt, 1);
     } else {
+      net->closesocket(net, sckt);
       return -1; // fail!
     }
   }
@@ -682,7 +694,7 @@ int netCreateSocket(JsNetwork *net, uint32_t host, unsigned short port, NetCreat
 
 void netCloseSocket(JsNetwork *net, int sckt) {
 #ifdef USE_TLS
-  if (BITFIELD_GET(socketIsHTTPS, sckt)) {
+  if (SOCKET_IS_HTTPS(sckt)) {
     ssl_freeSocketData(sckt);
   }
 #endif
@@ -699,7 +711,7 @@ void netGetHostByName(JsNetwork *net, char * hostName, uint32_t* out_ip_addr) {
 
 int netRecv(JsNetwork *net, int sckt, void *buf, size_t len) {
 #ifdef USE_TLS
-  if (BITFIELD_GET(socketIsHTTPS, sckt)) {
+  if (SOCKET_IS_HTTPS(sckt)) {
     SSLSocketData *sd = ssl_getSocketData(sckt);
     if (!sd) return -1;
     if (sd->connecting) return 0; // busy
@@ -717,7 +729,7 @@ int netRecv(JsNetwork *net, int sckt, void *buf, size_t len) {
 
 int netSend(JsNetwork *net, int sckt, const void *buf, size_t len) {
 #ifdef USE_TLS
-  if (BITFIELD_GET(socketIsHTTPS, sckt)) {
+  if (SOCKET_IS_HTTPS(sckt)) {
     SSLSocketData *sd = ssl_getSocketData(sckt);
     if (!sd) return -1;
     if (sd->connecting) return 0; // busy
@@ -54,6 +54,7 @@ typedef struct JsNetwork {
   unsigned char _blank; ///< this is needed as jsvGetString for 'data' wants to add a trailing zero  
 
   int chunkSize; ///< Amount of memory to allocate for chunks of data when using send/recv
+  int listenBacklog; ///< When creating a server, how many connections may wait to be accepted (0 = device default). Set by netCreateSocket
 
   /// Called on idle. Do any checks required for this device
   void (*idle)(struct JsNetwork *net);
@@ -17,11 +17,14 @@
 #include "jsinteractive.h"
 #include "jshardware.h"
 #include "jswrap_stream.h"
+#include "jswrap_string.h"
 
 #define HTTP_NAME_SOCKETTYPE "type" // normal socket or HTTP
 #define HTTP_NAME_PORT "port"
 #define HTTP_NAME_SOCKET "sckt"
 #define HTTP_NAME_HAD_HEADERS "hdrs"
+#define HTTP_NAME_HEADER_DATA JS_HIDDEN_CHAR_STR"hDt"  // server request's header text (hidden, so it isn't enumerated)
+#define HTTP_NAME_ROUTES "rts"        // server's array of {m:method,p:path,cb:callback}
 #define HTTP_NAME_RECEIVE_DATA "dRcv"
 #define HTTP_NAME_RECEIVE_COUNT "cRcv"
 #define HTTP_NAME_SEND_DATA "dSnd"
@@ -32,6 +35,7 @@
 #define HTTP_NAME_CLOSENOW "closeNow"  // boolean: gotta close
 #define HTTP_NAME_CONNECTED "conn"     // boolean: we are connected
 #define HTTP_NAME_CLOSE "close"        // close after sending
+#define HTTP_NAME_MAX_ACCEPT "mxAc"    // server: most connections to accept per idle pass
 #define HTTP_NAME_ON_CONNECT JS_EVENT_PREFIX"connect"
 #define HTTP_NAME_ON_CLOSE JS_EVENT_PREFIX"close"
 #define HTTP_NAME_ON_END JS_EVENT_PREFIX"end"
@@ -42,6 +46,11 @@
 #define HTTP_ARRAY_HTTP_SERVERS "HttpS"
 #define HTTP_ARRAY_HTTP_SERVER_CONNECTIONS "HttpSC"
 
+/// Most connections accepted from one server in each idle pass (unless `maxAccept` is given to listen)
+#ifndef SOCKET_ACCEPT_BUDGET
+#define SOCKET_ACCEPT_BUDGET 16
+#endif
+
 #ifdef ESP8266
 // esp8266 debugging, need to remove this eventually
 extern int os_printf_plus(const char *format, ...)  __attribute__((format(printf, 1, 2)));
@@ -69,15 +78,14 @@ static void httpAppendHeaders(JsVar *string, JsVar *headerObject) {
   // free headers
 }
 
-// httpParseHeaders(&receiveData, reqVar, true) // server
-// httpParseHeaders(&receiveData, resVar, false) // client
-bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer) {
+/// Find the end of the HTTP header (after the blank line) in 'data', or -1 if we don't have it all yet
+static int httpFindHeaderEnd(JsVar *data) {
   // find /r/n/r/n
   int newlineIdx = 0;
   int strIdx = 0;
   int headerEnd = -1;
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, *receiveData, 0);
+  jsvStringIteratorNew(&it, data, 0);
   while (jsvStringIteratorHasChar(&it)) {
     char ch = jsvStringIteratorGetChar(&it);
     if (ch == '\r') {
@@ -94,64 +102,76 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
     strIdx++;
   }
   jsvStringIteratorFree(&it);
-  // skip if we have no header
-  if (headerEnd<0) return false;
-  // Now parse the header
-  JsVar *vHeaders = jsvNewObject();
-  if (!vHeaders) return true;
-  jsvUnLock(jsvAddNamedChild(objectForData, vHeaders, "headers"));
-  strIdx = 0;
-  int firstSpace = -1;
-  int secondSpace = -1;
-  int firstEOL = -1;
+  return headerEnd;
+}
+
+/** Scan the header in 'data', finding the first two spaces and end of the
+ * first line (the request or status line). If vHeaders is set, all the
+ * header lines are added to it - otherwise we stop after the first line. */
+static void httpParseHeaderLines(JsVar *data, JsVar *vHeaders, int *firstSpace, int *secondSpace, int *firstEOL) {
+  int strIdx = 0;
   int lineNumber = 0;
   int lastLineStart = 0;
   int colonPos = 0;
-  //jsiConsolePrintStringVar(receiveData);
-  jsvStringIteratorNew(&it, *receiveData, 0);
-    while (jsvStringIteratorHasChar(&it)) {
-      char ch = jsvStringIteratorGetChar(&it);
-      if (ch==' ' || ch=='\r') {
-        if (firstSpace<0) firstSpace = strIdx;
-        else if (secondSpace<0) secondSpace = strIdx;
+  *firstSpace = -1;
+  *secondSpace = -1;
+  *firstEOL = -1;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, data, 0);
+  while (jsvStringIteratorHasChar(&it)) {
+    char ch = jsvStringIteratorGetChar(&it);
+    if (ch==' ' || ch=='\r') {
+      if (*firstSpace<0) *firstSpace = strIdx;
+      else if (*secondSpace<0) *secondSpace = strIdx;
+    }
+    if (ch == ':' && colonPos<0) colonPos = strIdx;
+    if (ch == '\r') {
+      if (*firstEOL<0) {
+        *firstEOL=strIdx;
+        if (!vHeaders) break;
       }
-      if (ch == ':' && colonPos<0) colonPos = strIdx;
-      if (ch == '\r') {
-        if (firstEOL<0) firstEOL=strIdx;
-        if (lineNumber>0 && colonPos>lastLineStart && lastLineStart<strIdx) {
-          JsVar *hVal = jsvNewFromEmptyString();
-          if (hVal)
-            jsvAppendStringVar(hVal, *receiveData, (size_t)colonPos+2, (size_t)(strIdx-(colonPos+2)));
-          JsVar *hKey = jsvNewFromEmptyString();
-          if (hKey) {
-            jsvMakeIntoVariableName(hKey, hVal);
-            jsvAppendStringVar(hKey, *receiveData, (size_t)lastLineStart, (size_t)(colonPos-lastLineStart));
-            jsvAddName(vHeaders, hKey);
-            jsvUnLock(hKey);
-          }
-          jsvUnLock(hVal);
+      if (lineNumber>0 && colonPos>lastLineStart && lastLineStart<strIdx) {
+        JsVar *hVal = jsvNewFromEmptyString();
+        if (hVal)
+          jsvAppendStringVar(hVal, data, (size_t)colonPos+2, (size_t)(strIdx-(colonPos+2)));
+        JsVar *hKey = jsvNewFromEmptyString();
+        if (hKey) {
+          jsvMakeIntoVariableName(hKey, hVal);
+          jsvAppendStringVar(hKey, data, (size_t)lastLineStart, (size_t)(colonPos-lastLineStart));
+          jsvAddName(vHeaders, hKey);
+          jsvUnLock(hKey);
         }
-        lineNumber++;
-        colonPos=-1;
+        jsvUnLock(hVal);
       }
-      if (ch == '\r' || ch == '\n') {
-        lastLineStart = strIdx+1;
-      }
-
-      jsvStringIteratorNext(&it);
-      strIdx++;
+      lineNumber++;
+      colonPos=-1;
+    }
+    if (ch == '\r' || ch == '\n') {
+      lastLineStart = strIdx+1;
     }
-    jsvStringIteratorFree(&it);
+
+    jsvStringIteratorNext(&it);
+    strIdx++;
+  }
+  jsvStringIteratorFree(&it);
+}
+
+// httpParseHeaders(&receiveData, resVar) // client
+static bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData) {
+  int headerEnd = httpFindHeaderEnd(*receiveData);
+  // skip if we have no header
+  if (headerEnd<0) return false;
+  // Now parse the header
+  JsVar *vHeaders = jsvNewObject();
+  if (!vHeaders) return true;
+  jsvUnLock(jsvAddNamedChild(objectForData, vHeaders, "headers"));
+  int firstSpace, secondSpace, firstEOL;
+  httpParseHeaderLines(*receiveData, vHeaders, &firstSpace, &secondSpace, &firstEOL);
   jsvUnLock(vHeaders);
   // try and pull out methods/etc
-  if (isServer) {
-    jsvObjectSetChildAndUnLock(objectForData, "method", jsvNewFromStringVar(*receiveData, 0, (size_t)firstSpace));
-    jsvObjectSetChildAndUnLock(objectForData, "url", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
-  } else {
-    jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(*receiveData, 5, (size_t)firstSpace-5));
-    jsvObjectSetChildAndUnLock(objectForData, "statusCode", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
-    jsvObjectSetChildAndUnLock(objectForData, "statusMessage", jsvNewFromStringVar(*receiveData, (size_t)(secondSpace+1), (size_t)(firstEOL-(secondSpace+1))));
-  }
+  jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(*receiveData, 5, (size_t)firstSpace-5));
+  jsvObjectSetChildAndUnLock(objectForData, "statusCode", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
+  jsvObjectSetChildAndUnLock(objectForData, "statusMessage", jsvNewFromStringVar(*receiveData, (size_t)(secondSpace+1), (size_t)(firstEOL-(secondSpace+1))));
   // strip out the header
   JsVar *afterHeaders = jsvNewFromStringVar(*receiveData, (size_t)headerEnd, JSVAPPENDSTRINGVAR_MAXLENGTH);
   jsvUnLock(*receiveData);
@@ -159,6 +179,320 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
   return true;
 }
 
+/* On the server, we just keep the header text of each request (in
+ * HTTP_NAME_HEADER_DATA) while routes are matched directly against it.
+ * method, url, headers and query are only set up on the request (see
+ * serverRequestSetFields) when there's a handler to call. */
+
+/// Find the end of the path in a request's URL (before any query string)
+static int httpGetPathEnd(JsVar *headerData, int urlStart, int urlEnd) {
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, headerData, (size_t)urlStart);
+  int idx = urlStart;
+  while (idx<urlEnd && jsvStringIteratorGetChar(&it)!='?') {
+    jsvStringIteratorNext(&it);
+    idx++;
+  }
+  jsvStringIteratorFree(&it);
+  return idx;
+}
+
+static char httpLowerCase(char ch) {
+  return (ch>='A' && ch<='Z') ? (char)(ch+'a'-'A') : ch;
+}
+
+/** Find the value of the header called 'name' (case insensitive) in the
+ * header text, without parsing the rest. Returns the value, or 0 */
+static JsVar *httpGetHeaderValue(JsVar *headerData, const char *name) {
+  size_t nameLen = strlen(name);
+  size_t idx = 0; // index in headerData
+  size_t col = 0; // index in the current line
+  bool lineMatches = false; // the first line is the request line
+  JsVar *value = 0;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, headerData, 0);
+  while (jsvStringIteratorHasChar(&it) && !value) {
+    char ch = jsvStringIteratorGetChar(&it);
+    jsvStringIteratorNext(&it);
+    idx++;
+    if (ch=='\n') {
+      col = 0;
+      lineMatches = true;
+    } else if (lineMatches) {
+      if (col<nameLen) {
+        lineMatches = httpLowerCase(ch) == httpLowerCase(name[col]);
+      } else if (ch==':') {
+        // found it - the value is after any spaces, up to the end of the line
+        while (jsvStringIteratorGetChar(&it)==' ') {
+          jsvStringIteratorNext(&it);
+          idx++;
+        }
+        size_t valueStart = idx;
+        while (jsvStringIteratorHasChar(&it) && jsvStringIteratorGetChar(&it)!='\r') {
+          jsvStringIteratorNext(&it);
+          idx++;
+        }
+        value = jsvNewFromStringVar(headerData, valueStart, idx-valueStart);
+      } else
+        lineMatches = false;
+      col++;
+    }
+  }
+  jsvStringIteratorFree(&it);
+  return value;
+}
+
+/// If we have all of a request's header, keep it and cut it off the front of receiveData
+static bool httpServerParseHeaders(JsVar **receiveData, JsVar *connection) {
+  int headerEnd = httpFindHeaderEnd(*receiveData);
+  if (headerEnd<0) return false;
+  jsvObjectSetChildAndUnLock(connection, HTTP_NAME_HEADER_DATA, jsvNewFromStringVar(*receiveData, 0, (size_t)headerEnd));
+  JsVar *afterHeaders = jsvNewFromStringVar(*receiveData, (size_t)headerEnd, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  jsvUnLock(*receiveData);
+  *receiveData = afterHeaders;
+  return true;
+}
+
+/// Find where the method and URL are in a request's header text
+static void httpGetRequestLine(JsVar *headerData, int *methodEnd, int *urlStart, int *urlEnd) {
+  int firstEOL;
+  httpParseHeaderLines(headerData, 0, methodEnd, urlEnd, &firstEOL);
+  if (*methodEnd<0) *methodEnd = 0;
+  *urlStart = *methodEnd+1;
+  if (*urlEnd<*urlStart) *urlEnd = *urlStart;
+}
+
+/** Set up the fields of a request from its header text, just before its handler is
+ * called. They're normal properties, so they're enumerated and stringified as usual. */
+static void serverRequestSetFields(JsVar *connection, JsVar *headerData) {
+  int firstSpace, secondSpace, firstEOL;
+  JsVar *headers = jsvNewObject();
+  if (headers) httpParseHeaderLines(headerData, headers, &firstSpace, &secondSpace, &firstEOL);
+  jsvObjectSetChildAndUnLock(connection, "headers", headers);
+  int methodEnd, urlStart, urlEnd;
+  httpGetRequestLine(headerData, &methodEnd, &urlStart, &urlEnd);
+  jsvObjectSetChildAndUnLock(connection, "method", jsvNewFromStringVar(headerData, 0, (size_t)methodEnd));
+  jsvObjectSetChildAndUnLock(connection, "url", jsvNewFromStringVar(headerData, (size_t)urlStart, (size_t)(urlEnd-urlStart)));
+#ifndef SAVE_ON_FLASH
+  int pathEnd = httpGetPathEnd(headerData, urlStart, urlEnd);
+  jsvObjectSetChildAndUnLock(connection, "query", httpParseQuery(headerData, (size_t)pathEnd+1, (size_t)urlEnd));
+#endif
+  // everything we need is in the fields now
+  if (headers) jsvRemoveNamedChild(connection, HTTP_NAME_HEADER_DATA);
+}
+
+/// Get the Content-Length of a request, without parsing all its headers if we haven't already
+static JsVarInt serverRequestGetContentLength(JsVar *connection) {
+  JsVarInt contentLength = 0;
+  JsVar *headers = jsvObjectGetChild(connection, "headers", 0);
+  if (headers) {
+    contentLength = jsvGetIntegerAndUnLock(jsvObjectGetChild(headers,"Content-Length",0));
+    jsvUnLock(headers);
+  } else {
+    JsVar *headerData = jsvObjectGetChild(connection, HTTP_NAME_HEADER_DATA, 0);
+    if (headerData)
+      contentLength = jsvGetIntegerAndUnLock(httpGetHeaderValue(headerData, "Content-Length"));
+    jsvUnLock(headerData);
+  }
+  return contentLength;
+}
+
+/** If the iterator (at index 'idx') is on a `%XX` escape that finishes before 'end', return the
+ * character it stands for. Otherwise return -1 - a '%' that isn't followed by two hex digits
+ * is just copied as-is. */
+static int httpGetEscape(JsvStringIterator *it, size_t idx, size_t end) {
+  if (jsvStringIteratorGetChar(it)!='%' || idx+2>=end) return -1;
+  JsvStringIterator hexIt = jsvStringIteratorClone(it);
+  jsvStringIteratorNext(&hexIt);
+  char hi = jsvStringIteratorGetChar(&hexIt);
+  jsvStringIteratorNext(&hexIt);
+  char lo = jsvStringIteratorGetChar(&hexIt);
+  jsvStringIteratorFree(&hexIt);
+  if (!isHexadecimal(hi) || !isHexadecimal(lo)) return -1;
+  return (chtod(hi)<<4) | chtod(lo);
+}
+
+/// Append the characters from start to end of str to dst, decoding `%XX` escapes
+static void httpAppendDecoded(JsVar *dst, JsVar *str, size_t start, size_t end) {
+  size_t runStart = start; // characters from here haven't been added to dst yet
+  size_t idx = start;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, str, start);
+  while (idx<end && jsvStringIteratorHasChar(&it)) {
+    int escaped = httpGetEscape(&it, idx, end);
+    if (escaped>=0) {
+      if (idx>runStart) jsvAppendStringVar(dst, str, runStart, idx-runStart);
+      jsvStringIteratorNext(&it);
+      jsvStringIteratorNext(&it);
+      idx += 2;
+      jsvAppendCharacter(dst, (char)escaped);
+      runStart = idx+1;
+    }
+    jsvStringIteratorNext(&it);
+    idx++;
+  }
+  jsvStringIteratorFree(&it);
+  if (idx>runStart) jsvAppendStringVar(dst, str, runStart, idx-runStart);
+}
+
+/** Match the path of a request against a route's path. In the route, `:name`
+ * matches one non-empty segment of the path (which is added to 'params' if
+ * it is set, decoded like the query string), and `*` matches the rest of the path. */
+static bool httpRouteMatch(JsVar *route, JsVar *headerData, int pathStart, int pathEnd, JsVar *params) {
+  JsvStringIterator rit, pit;
+  jsvStringIteratorNew(&rit, route, 0);
+  jsvStringIteratorNew(&pit, headerData, (size_t)pathStart);
+  size_t routeIdx = 0;
+  int idx = pathStart;
+  bool match = true;
+  bool wildcard = false;
+  while (match && jsvStringIteratorHasChar(&rit)) {
+    char ch = jsvStringIteratorGetChar(&rit);
+    if (ch=='*') {
+      wildcard = true;
+      break;
+    } else if (ch==':') {
+      size_t nameStart = routeIdx+1;
+      while (jsvStringIteratorHasChar(&rit) && jsvStringIteratorGetChar(&rit)!='/') {
+        jsvStringIteratorNext(&rit);
+        routeIdx++;
+      }
+      int valueStart = idx;
+      while (idx<pathEnd && jsvStringIteratorGetChar(&pit)!='/') {
+        jsvStringIteratorNext(&pit);
+        idx++;
+      }
+      match = idx>valueStart;
+      if (match && params) {
+        JsVar *key = jsvNewFromStringVar(route, nameStart, routeIdx-nameStart);
+        JsVar *value = jsvNewFromEmptyString();
+        if (value) httpAppendDecoded(value, headerData, (size_t)valueStart, (size_t)idx);
+        if (key) {
+          jsvMakeIntoVariableName(key, value);
+          jsvAddName(params, key);
+        }
+        jsvUnLock2(key, value);
+      }
+    } else {
+      match = idx<pathEnd && jsvStringIteratorGetChar(&pit)==ch;
+      jsvStringIteratorNext(&rit);
+      jsvStringIteratorNext(&pit);
+      routeIdx++;
+      idx++;
+    }
+  }
+  jsvStringIteratorFree(&rit);
+  jsvStringIteratorFree(&pit);
+  return match && (wildcard || idx==pathEnd);
+}
+
+/** We have the header for a request - find a route for it, and queue a call
+ * to its handler. If there's no route, the server's callback is called, or
+ * if there's no callback a 404 is sent. */
+static void serverRequestDispatch(JsVar *server, JsVar *connection, JsVar *socket) {
+  JsVar *args[2] = { connection, socket };
+  JsVar *headerData = jsvObjectGetChild(connection, HTTP_NAME_HEADER_DATA, 0);
+  if (!headerData) return;
+  JsVar *routes = jsvObjectGetChild(server, HTTP_NAME_ROUTES, 0);
+  if (routes) {
+    int methodEnd, urlStart, urlEnd;
+    httpGetRequestLine(headerData, &methodEnd, &urlStart, &urlEnd);
+    int pathEnd = httpGetPathEnd(headerData, urlStart, urlEnd);
+    JsVar *callback = 0;
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, routes);
+    while (!callback && jsvObjectIteratorHasValue(&it)) {
+      JsVar *route = jsvObjectIteratorGetValue(&it);
+      JsVar *method = jsvObjectGetChild(route, "m", 0);
+      JsVar *path = jsvObjectGetChild(route, "p", 0);
+      if ((!method || ((int)jsvGetStringLength(method)==methodEnd && jsvCompareString(method, headerData, 0, 0, true)==0)) &&
+          httpRouteMatch(path, headerData, urlStart, pathEnd, 0)) {
+        if (jsvGetStringIndexOf(path, ':')>=0) {
+          JsVar *params = jsvNewObject();
+          if (params) httpRouteMatch(path, headerData, urlStart, pathEnd, params);
+          jsvObjectSetChildAndUnLock(connection, "params", params);
+        }
+        callback = jsvObjectGetChild(route, "cb", 0);
+      }
+      jsvUnLock3(method, path, route);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    jsvUnLock(routes);
+    if (callback) {
+      serverRequestSetFields(connection, headerData);
+      jsiQueueEvents(server, callback, args, 2);
+      jsvUnLock2(callback, headerData);
+      return;
+    }
+  }
+  if (jsiObjectHasCallbacks(server, HTTP_NAME_ON_CONNECT)) {
+    serverRequestSetFields(connection, headerData);
+    jsiQueueObjectCallbacks(server, HTTP_NAME_ON_CONNECT, args, 2);
+  } else {
+    serverResponseWriteHead(socket, 404, 0);
+    serverResponseEnd(socket);
+  }
+  jsvUnLock(headerData);
+}
+
+/// Add key=val to the query object, if either is set. Returns true if it was added
+static bool httpQueryAdd(JsVar *query, JsVar *key, JsVar *val) {
+  if (jsvGetStringLength(key)==0 && jsvGetStringLength(val)==0) return false;
+  key = jsvAsArrayIndex(key); // make sure "0" gets made into 0
+  jsvMakeIntoVariableName(key, val);
+  jsvAddName(query, key);
+  jsvUnLock(key);
+  return true;
+}
+
+/** Decode the query string in str between start and end (eg. `a=b&c=%20d`)
+ * into a new object. Runs of characters that don't need decoding are
+ * appended in one go, rather than a character at a time. */
+JsVar *httpParseQuery(JsVar *str, size_t start, size_t end) {
+  JsVar *query = jsvNewObject();
+  if (!query) return 0; // out of memory
+  JsVar *key = jsvNewFromEmptyString();
+  JsVar *val = jsvNewFromEmptyString();
+  bool hadEquals = false;
+  size_t runStart = start; // characters from here haven't been added to key or val yet
+  size_t idx = start;
+
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, str, start);
+  while (idx<end && jsvStringIteratorHasChar(&it)) {
+    char ch = jsvStringIteratorGetChar(&it);
+    int escaped = (ch=='%') ? httpGetEscape(&it, idx, end) : -1;
+    if (ch=='&' || escaped>=0 || (!hadEquals && ch=='=')) {
+      JsVar *dst = hadEquals ? val : key;
+      if (idx>runStart) jsvAppendStringVar(dst, str, runStart, idx-runStart);
+      if (ch=='&') {
+        if (httpQueryAdd(query, key, val)) {
+          jsvUnLock2(key, val);
+          key = jsvNewFromEmptyString();
+          val = jsvNewFromEmptyString();
+          hadEquals = false;
+        }
+      } else if (ch=='=') {
+        hadEquals = true;
+      } else { // decode percent escape chars
+        jsvStringIteratorNext(&it);
+        jsvStringIteratorNext(&it);
+        idx += 2;
+        jsvAppendCharacter(dst, (char)escaped);
+      }
+      runStart = idx+1;
+    }
+    jsvStringIteratorNext(&it);
+    idx++;
+  }
+  jsvStringIteratorFree(&it);
+  if (idx>runStart) jsvAppendStringVar(hadEquals ? val : key, str, runStart, idx-runStart);
+  httpQueryAdd(query, key, val);
+  jsvUnLock2(key, val);
+  return query;
+}
+
 size_t httpStringGet(JsVar *v, char *str, size_t len) {
   size_t l = len;
   JsvStringIterator it;
@@ -189,6 +523,21 @@ static NO_INLINE void socketSetType(JsVar *var, SocketType socketType) {
   jsvObjectSetChildAndUnLock(var, HTTP_NAME_SOCKETTYPE, jsvNewFromInteger((JsVarInt)socketType));
 }
 
+/// Get an array from socketGetArray, if we haven't already
+static JsVar *socketGetArrayCached(JsVar **arr, const char *name) {
+  if (!*arr) *arr = socketGetArray(name, true);
+  return *arr;
+}
+
+/// Create a new object of a built-in class, looking up its prototype only if we haven't already
+static JsVar *socketNewObject(JsVar **proto, const char *instanceOf) {
+  if (!*proto) *proto = jsvSkipNameAndUnLock(jspNewPrototype(instanceOf));
+  JsVar *obj = jsvNewObject();
+  if (obj && *proto)
+    jsvUnLock(jsvAddNamedChild(obj, *proto, JSPARSE_INHERITS_VAR));
+  return obj;
+}
+
 void _socketConnectionKill(JsNetwork *net, JsVar *connection) {
   if (!net || networkState != NETWORKSTATE_ONLINE) return;
   int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChild(connection,HTTP_NAME_SOCKET,0))-1; // so -1 if undefined
@@ -331,12 +680,11 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
           if (receiveData) {
             jsvAppendStringBuf(receiveData, buf, (size_t)num);
             bool hadHeaders = jsvGetBoolAndUnLock(jsvObjectGetChild(connection,HTTP_NAME_HAD_HEADERS,0));
-            if (!hadHeaders && httpParseHeaders(&receiveData, connection, true)) {
+            if (!hadHeaders && httpServerParseHeaders(&receiveData, connection)) {
               hadHeaders = true;
               jsvObjectSetChildAndUnLock(connection, HTTP_NAME_HAD_HEADERS, jsvNewFromBool(hadHeaders));
               JsVar *server = jsvObjectGetChild(connection,HTTP_NAME_SERVER_VAR,0);
-              JsVar *args[2] = { connection, socket };
-              jsiQueueObjectCallbacks(server, HTTP_NAME_ON_CONNECT, args, ((socketType&ST_TYPE_MASK)==ST_HTTP) ? 2 : 1);
+              serverRequestDispatch(server, connection, socket);
               jsvUnLock(server);
             }
             if (hadHeaders && !jsvIsEmptyString(receiveData)) {
@@ -384,14 +732,10 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
         bool reallyCloseNow = true;
         if ((socketType&ST_TYPE_MASK)==ST_HTTP) {
           // Check if we had a Content-Length header - if so, we need to wait until we have received that amount
-          JsVar *headers = jsvObjectGetChild(connection,"headers",0);
-          if (headers) {
-            JsVarInt contentLength = jsvGetIntegerAndUnLock(jsvObjectGetChild(headers,"Content-Length",0));
-            JsVarInt contentReceived = jsvGetIntegerAndUnLock(jsvObjectGetChild(connection, HTTP_NAME_RECEIVE_COUNT, 0));
-            if (contentLength > contentReceived) {
-              reallyCloseNow = false;
-            }
-            jsvUnLock(headers);
+          JsVarInt contentLength = serverRequestGetContentLength(connection);
+          JsVarInt contentReceived = jsvGetIntegerAndUnLock(jsvObjectGetChild(connection, HTTP_NAME_RECEIVE_COUNT, 0));
+          if (contentLength > contentReceived) {
+            reallyCloseNow = false;
           }
         }
         closeConnectionNow = reallyCloseNow;
@@ -537,7 +881,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
                 if ((socketType&ST_TYPE_MASK)==ST_HTTP && !hadHeaders) {
                   // for HTTP see whether we now have full response headers
                   JsVar *resVar = jsvObjectGetChild(connection,HTTP_NAME_RESPONSE_VAR,0);
-                  if (httpParseHeaders(&receiveData, resVar, false)) {
+                  if (httpParseHeaders(&receiveData, resVar)) {
                     hadHeaders = true;
                     jsvObjectSetChildAndUnLock(connection, HTTP_NAME_HAD_HEADERS, jsvNewFromBool(hadHeaders));
                     jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CONNECT, &resVar, 1);
@@ -604,6 +948,9 @@ bool socketIdle(JsNetwork *net) {
   bool hadSockets = false;
   JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVERS,false);
   if (arr) {
+    // looked up when we first accept a connection, and then reused for the rest
+    JsVar *serverConns = 0, *clientConns = 0;
+    JsVar *reqProto = 0, *resProto = 0, *sockProto = 0;
     JsvObjectIterator it;
     jsvObjectIteratorNew(&it, arr);
     while (jsvObjectIteratorHasValue(&it)) {
@@ -612,38 +959,41 @@ bool socketIdle(JsNetwork *net) {
       JsVar *server = jsvObjectIteratorGetValue(&it);
       int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChild(server,HTTP_NAME_SOCKET,0))-1; // so -1 if undefined
 
-      int theClient = netAccept(net, sckt);
-      if (theClient >= 0) {
-        SocketType socketType = socketGetType(server);
+      SocketType socketType = socketGetType(server);
+      int budget = (int)jsvGetIntegerAndUnLock(jsvObjectGetChild(server,HTTP_NAME_MAX_ACCEPT,0));
+      if (budget<=0) budget = SOCKET_ACCEPT_BUDGET;
+      // Accept everything that's waiting (up to the budget) rather than one connection per pass
+      while (budget--) {
+        int theClient = netAccept(net, sckt);
+        if (theClient < 0) break;
+        bool ok = false;
         if ((socketType&ST_TYPE_MASK) == ST_HTTP) {
-          JsVar *req = jspNewObject(0, "httpSRq");
-          JsVar *res = jspNewObject(0, "httpSRs");
-          if (res && req) { // out of memory?
+          JsVar *req = socketNewObject(&reqProto, "httpSRq");
+          JsVar *res = socketNewObject(&resProto, "httpSRs");
+          if (res && req && socketGetArrayCached(&serverConns, HTTP_ARRAY_HTTP_SERVER_CONNECTIONS)) { // out of memory?
             socketSetType(req, ST_HTTP);
-            JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVER_CONNECTIONS, true);
-            if (arr) {
-              jsvArrayPush(arr, req);
-              jsvUnLock(arr);
-            }
+            jsvArrayPush(serverConns, req);
             jsvObjectSetChild(req, HTTP_NAME_RESPONSE_VAR, res);
             jsvObjectSetChild(req, HTTP_NAME_SERVER_VAR, server);
             jsvObjectSetChildAndUnLock(req, HTTP_NAME_SOCKET, jsvNewFromInteger(theClient+1));
+            ok = true;
           }
           jsvUnLock2(req, res);
         } else {
           // Normal sockets
-          JsVar *sock = jspNewObject(0, "Socket");
-          if (sock) { // out of memory?
+          JsVar *sock = socketNewObject(&sockProto, "Socket");
+          if (sock && socketGetArrayCached(&clientConns, HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS)) { // out of memory?
             socketSetType(sock, ST_NORMAL);
-            JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS, true);
-            if (arr) {
-              jsvArrayPush(arr, sock);
-              jsvUnLock(arr);
-            }
+            jsvArrayPush(clientConns, sock);
             jsvObjectSetChildAndUnLock(sock, HTTP_NAME_SOCKET, jsvNewFromInteger(theClient+1));
             jsiQueueObjectCallbacks(server, HTTP_NAME_ON_CONNECT, &sock, 1);
-            jsvUnLock(sock);
+            ok = true;
           }
+          jsvUnLock(sock);
+        }
+        if (!ok) { // out of memory - don't leave the connection hanging
+          netCloseSocket(net, theClient);
+          break;
         }
       }
 
@@ -652,6 +1002,8 @@ bool socketIdle(JsNetwork *net) {
     }
     jsvObjectIteratorFree(&it);
     jsvUnLock(arr);
+    jsvUnLock3(serverConns, clientConns, reqProto);
+    jsvUnLock2(resProto, sockProto);
   }
 
   if (socketServerConnectionsIdle(net)) hadSockets = true;
@@ -670,13 +1022,34 @@ JsVar *serverNew(SocketType socketType, JsVar *callback) {
   return server;
 }
 
-void serverListen(JsNetwork *net, JsVar *server, int port) {
+void serverAddRoute(JsVar *server, JsVar *method, JsVar *path, JsVar *callback) {
+  JsVar *routes = jsvObjectGetChild(server, HTTP_NAME_ROUTES, JSV_ARRAY);
+  JsVar *route = jsvNewObject();
+  if (routes && route) {
+    if (jsvIsString(method) && !jsvIsStringEqual(method, "*")) {
+      // methods in requests are case-sensitive, but the standard ones are upper case - so let "get" match GET
+      JsVar *upper = jswrap_string_toUpperLowerCase(method, true);
+      jsvObjectSetChildAndUnLock(route, "m", upper);
+    }
+    jsvObjectSetChild(route, "p", path);
+    jsvObjectSetChild(route, "cb", callback);
+    jsvArrayPush(routes, route);
+  }
+  jsvUnLock2(route, routes);
+}
+
+void serverListen(JsNetwork *net, JsVar *server, int port, JsVar *options) {
   JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVERS, true);
   if (!arr) return; // out of memory
 
   jsvObjectSetChildAndUnLock(server, HTTP_NAME_PORT, jsvNewFromInteger(port));
+  if (jsvIsObject(options)) {
+    JsVar *maxAccept = jsvObjectGetChild(options, "maxAccept", 0);
+    if (maxAccept) jsvObjectSetChild(server, HTTP_NAME_MAX_ACCEPT, maxAccept);
+    jsvUnLock(maxAccept);
+  }
 
-  int sckt = netCreateSocket(net, 0/*server*/, (unsigned short)port, NCF_NORMAL, 0 /*options*/);
+  int sckt = netCreateSocket(net, 0/*server*/, (unsigned short)port, NCF_NORMAL, options);
   if (sckt<0) {
     jsError("Unable to create socket\n");
     jsvObjectSetChildAndUnLock(server, HTTP_NAME_CLOSENOW, jsvNewFromBool(true));
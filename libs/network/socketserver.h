@@ -37,7 +37,9 @@ bool socketIdle(JsNetwork *net);
 
 // -----------------------------
 JsVar *serverNew(SocketType socketType, JsVar *callback);
-void serverListen(JsNetwork *net, JsVar *httpServerVar, int port);
+/// Add a route to an HTTP server. method may be undefined (or "*") for any method
+void serverAddRoute(JsVar *server, JsVar *method, JsVar *path, JsVar *callback);
+void serverListen(JsNetwork *net, JsVar *httpServerVar, int port, JsVar *options);
 void serverClose(JsNetwork *net, JsVar *server);
 
 JsVar *clientRequestNew(SocketType socketType, JsVar *options, JsVar *callback);
@@ -45,6 +47,9 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data);
 void clientRequestConnect(JsNetwork *net, JsVar *httpClientReqVar);
 void clientRequestEnd(JsNetwork *net, JsVar *httpClientReqVar);
 
+/// Decode a URL query string (eg. `a=b&c=d`) between start and end into a new object
+JsVar *httpParseQuery(JsVar *str, size_t start, size_t end);
+
 void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar *headers);
 void serverResponseWrite(JsVar *httpServerResponseVar, JsVar *data);
 void serverResponseEnd(JsVar *httpServerResponseVar);
@@ -259,6 +259,7 @@ void telnetSendChar(char ch) {
   if (tnSrv.sock == 0 || tnSrv.cliSock == 0) return;
   if (tnSrv.txBufLen >= TX_CHUNK) {
     // buffer overflow :-(
+    jshTransmitDropped(EV_TELNET);
     if (!ovf) {
       printf("tnSrv: send overflow!\n");
       ovf = true;
@@ -124,6 +124,101 @@ def getArgumentSpecifier(jsondata):
     n=n+1
   return " | ".join(s);
   
+def getArgumentSpecifierValue(jsondata):
+  # The numeric value of getArgumentSpecifier, so we can spot builtins that share a signature
+  values = { "JSWAT_VOID":0, "JSWAT_JSVAR":1, "JSWAT_ARGUMENT_ARRAY":2, "JSWAT_BOOL":3,
+             "JSWAT_INT32":4, "JSWAT_PIN":5, "JSWAT_JSVARFLOAT":6 }
+  params = getParams(jsondata)
+  if jsondata["type"]=="object":
+    return values["JSWAT_JSVAR"] | 0x7000
+  v = values[toArgumentType(getResult(jsondata)[0])]
+  if hasThis(jsondata): v = v | 0x8000
+  if jsondata["type"]=="variable" or common.is_property(jsondata): v = v | 0x7000
+  n = 1
+  for param in params:
+    v = v | (values[toArgumentType(param[1])] << (3*n))
+    n=n+1
+  return v
+
+def getThunkArgTypes(jsondata):
+  # The argument and return types a thunk for this builtin has to convert
+  if jsondata["type"]=="object": return "JsVar", []
+  return getResult(jsondata)[0], [param[1] for param in getParams(jsondata)]
+
+def codeOutThunk(thunkName, jsondata):
+  # A typed call for one argument specifier - converts each JsVar in turn (in order, as
+  # conversions may execute JS) then calls the native function directly
+  result, params = getThunkArgTypes(jsondata)
+  cArgs = []
+  cTypes = []
+  codeOut("static JsVar *"+thunkName+"(void *function, JsVar *thisParam, JsVar **paramData, int paramCount) {")
+  if hasThis(jsondata):
+    cArgs.append("thisParam")
+    cTypes.append("JsVar*")
+  else:
+    codeOut("  NOT_USED(thisParam);")
+  if not params:
+    codeOut("  NOT_USED(paramData);")
+    codeOut("  NOT_USED(paramCount);")
+  argsArray = False
+  n = 0
+  for param in params:
+    a = "a"+str(n)
+    p = "jsnGetArg(paramData, paramCount, "+str(n)+")"
+    if param=="JsVar": codeOut("  JsVar *"+a+" = "+p+";")
+    elif param=="JsVarArray":
+      codeOut("  JsVar *"+a+" = jsnNewArgumentArray(paramData, paramCount, "+str(n)+");")
+      argsArray = a
+    elif param=="bool": codeOut("  bool "+a+" = jsvGetBool("+p+");")
+    elif param=="pin": codeOut("  Pin "+a+" = jshGetPinFromVar("+p+");")
+    elif param=="int32" or param=="int": codeOut("  JsVarInt "+a+" = jsvGetInteger("+p+");")
+    elif param=="float": codeOut("  JsVarFloat "+a+" = jsvGetFloat("+p+");")
+    cArgs.append(a)
+    cTypes.append("JsVarInt" if param=="int32" or param=="int" else toCType(param))
+    n=n+1
+  cRet = "JsVarInt" if result=="int32" or result=="int" else toCType(result)
+  call = "(("+cRet+" (*)("+(",".join(cTypes) if cTypes else "void")+"))function)("+", ".join(cArgs)+")"
+  if result=="":
+    codeOut("  "+call+";")
+    r = "0"
+  else:
+    codeOut("  "+cRet+" r = "+call+";")
+    if result=="JsVar" or result=="JsVarArray": r = "r"
+    elif result=="bool": r = "jsvNewFromBool(r)"
+    elif result=="pin": r = "jsvNewFromPin(r)"
+    elif result=="float": r = "jsvNewFromFloat(r)"
+    else: r = "jsvNewFromInteger(r)"
+  if argsArray: codeOut("  jsvUnLock("+argsArray+");")
+  codeOut("  return "+r+";")
+  codeOut("}")
+
+def codeOutThunks(jsondatas):
+  # One thunk per distinct argument specifier used by a builtin, dispatched from jswCallFunction.
+  # Anything else (eg. E.nativeCall) goes through jsnCallFunction's generic marshalling.
+  # There are ~100 of these, so SAVE_ON_FLASH builds leave them out and always use jsnCallFunction
+  thunks = {}
+  for jsondata in jsondatas:
+    if "generate" in jsondata:
+      value = getArgumentSpecifierValue(jsondata)
+      if not value in thunks: thunks[value] = jsondata
+  codeOut("#ifndef SAVE_ON_FLASH")
+  for value in sorted(thunks.keys()):
+    codeOutThunk("jswThunk_"+hex(value), thunks[value])
+  codeOut("#endif")
+  codeOut("")
+  codeOut("JsVar *jswCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar *thisParam, JsVar **paramData, int paramCount) {")
+  codeOut("#ifndef SAVE_ON_FLASH")
+  codeOut("  switch ((int)argumentSpecifier) {")
+  for value in sorted(thunks.keys()):
+    codeOut("    case "+hex(value)+": return jswThunk_"+hex(value)+"(function, thisParam, paramData, paramCount);")
+  codeOut("    default: return jsnCallFunction(function, argumentSpecifier, thisParam, paramData, paramCount);")
+  codeOut("  }")
+  codeOut("#else")
+  codeOut("  return jsnCallFunction(function, argumentSpecifier, thisParam, paramData, paramCount);")
+  codeOut("#endif")
+  codeOut("}")
+  codeOut("")
+
 def getCDeclaration(jsondata, name): 
   # name could be '(*)' for a C function pointer 
   params = getParams(jsondata)
@@ -265,10 +360,17 @@ codeOut('// --------------------------------------------------------------------
 codeOut('// -----------------------------------------------------------------------------------------');
 codeOut('');
 
+codeOutThunks(jsondatas)
+
+codeOut('// -----------------------------------------------------------------------------------------');
+codeOut('// -----------------------------------------------------------------------------------------');
+codeOut('// -----------------------------------------------------------------------------------------');
+codeOut('');
+
 codeOut("""
 // Binary search coded to allow for JswSyms to be in flash on the esp8266 where they require
 // word accesses
-JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name) {
+bool jswBinarySearchSymbol(const JswSymList *symbolsPtr, const char *name, JswBuiltInSymbol *symbol) {
   uint8_t symbolCount = READ_FLASH_UINT8(&symbolsPtr->symbolCount);
   int searchMin = 0;
   int searchMax = symbolCount - 1;
@@ -278,10 +380,9 @@ JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *
     unsigned short strOffset = READ_FLASH_UINT16(&sym->strOffset);
     int cmp = FLASH_STRCMP(name, &symbolsPtr->symbolChars[strOffset]);
     if (cmp==0) {
-      unsigned short functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
-      if ((functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
-        return jsnCallFunction(sym->functionPtr, functionSpec, parent, 0, 0);
-      return jsvNewNativeFunction(sym->functionPtr, functionSpec);
+      symbol->functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
+      symbol->functionPtr = sym->functionPtr;
+      return true;
     } else {
       if (cmp<0) {
         // searchMin is the same
@@ -292,7 +393,48 @@ JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *
       }
     }
   }
-  return 0;
+  return false;
+}
+
+JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name) {
+  JswBuiltInSymbol symbol;
+  if (!jswBinarySearchSymbol(symbolsPtr, name, &symbol)) return 0;
+  if ((symbol.functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
+    return jswCallFunction(symbol.functionPtr, symbol.functionSpec, parent, 0, 0);
+  return jswGetNativeFunction(&symbol);
+}
+
+/* Functions for built-in symbols are kept in a small cache in hiddenRoot when
+ * they're used as values, so using the same one again (and comparing them)
+ * works as it would for a normal function. The cache is emptied on reset or
+ * if memory gets low (see jspCodeCacheFlush) */
+JsVar *jswGetNativeFunction(const JswBuiltInSymbol *symbol) {
+#ifndef SAVE_ON_FLASH
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, JSW_NATIVE_FUNCTION_CACHE_NAME, JSV_ARRAY);
+  if (cache) {
+    JsVarRef childref = jsvGetFirstChild(cache);
+    while (childref) {
+      JsVar *child = jsvGetAddressOfBorrowed(childref);
+      JsVar *fn = jsvGetAddressOfBorrowed(jsvGetFirstChild(child));
+      if (fn->varData.native.ptr==symbol->functionPtr && fn->varData.native.argTypes==symbol->functionSpec) {
+        jsvUnLock(cache);
+        return jsvLockAgain(fn);
+      }
+      childref = jsvGetNextSibling(child);
+    }
+  }
+#endif
+  JsVar *fn = jsvNewNativeFunction(symbol->functionPtr, symbol->functionSpec);
+#ifndef SAVE_ON_FLASH
+  if (cache && fn) {
+    // Throw out the oldest entry if we're full
+    if (jsvGetChildren(cache) >= JSW_NATIVE_FUNCTION_CACHE_SIZE)
+      jsvUnLock(jsvArrayPopFirst(cache));
+    jsvArrayPush(cache, fn);
+  }
+  jsvUnLock(cache);
+#endif
+  return fn;
 }
 
 """);
@@ -366,55 +508,62 @@ codeOut('');
 codeOut('');
 
 
+def codeOutFindInParent(codeOutSearch):
+  """ Output the search for a built-in symbol in the tables for 'parent' (which isn't root). codeOutSearch(indent, builtin)
+  outputs code that returns if the symbol was found in the given builtin's table """
+  codeOut('    // ------------------------------------------ INSTANCE + STATIC METHODS')
+  nativeCheck = "jsvIsNativeFunction(parent) && "
+  codeOut('    if (jsvIsNativeFunction(parent)) {')
+  first = True
+  for className in builtins:
+    if className.startswith(nativeCheck):
+      codeOut('      '+("" if first else "} else ")+'if ('+className[len(nativeCheck):]+') {')
+      first = False
+      codeOutSearch("        ", builtins[className])
+  if not first:
+    codeOut("      }")
+  codeOut('    }')
+  for className in builtins:
+    if className!="parent" and  className!="!parent" and not "constructorPtr" in className and not className.startswith(nativeCheck):
+      codeOut('    if ('+className+') {')
+      codeOutSearch("      ", builtins[className])
+      codeOut("    }")
+  codeOut('    // ------------------------------------------ INSTANCE METHODS WE MUST CHECK CONSTRUCTOR FOR')
+  codeOut('    JsVar *proto = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_INHERITS_VAR, false)):0;')
+  codeOut('    JsVar *constructor = jsvIsObject(proto)?jsvSkipNameAndUnLock(jsvFindChildFromString(proto, JSPARSE_CONSTRUCTOR_VAR, false)):0;')
+  codeOut('    jsvUnLock(proto);')
+  codeOut('    if (constructor && jsvIsNativeFunction(constructor)) {')
+  codeOut('      void *constructorPtr = constructor->varData.native.ptr;')
+  codeOut('      jsvUnLock(constructor);')
+  first = True
+  for className in builtins:
+    if "constructorPtr" in className:
+      if first:
+        codeOut('      if ('+className+') {')
+        first = False
+      else:
+        codeOut('      } else if ('+className+') {')
+      codeOutSearch("        ", builtins[className])
+  if not first:
+    codeOut("      }")
+  codeOut('    } else {')
+  codeOut('      jsvUnLock(constructor);')
+  codeOut('    }')
+  codeOut('    // ------------------------------------------ METHODS ON OBJECT')
+  if "parent" in builtins:
+    codeOutSearch("    ", builtins["parent"])
+
+def codeOutSearchFunction(indent, builtin):
+  codeOutBuiltins(indent+"v = ", builtin)
+  codeOut(indent+'if (v) return v;')
+
+def codeOutSearchSymbol(indent, builtin):
+  codeOut(indent+"if (jswBinarySearchSymbol(&jswSymbolTables["+builtin["indexName"]+"], name, symbol)) return true;")
+
 codeOut('JsVar *jswFindBuiltInFunction(JsVar *parent, const char *name) {')
 codeOut('  JsVar *v;')
 codeOut('  if (parent && !jsvIsRoot(parent)) {')
-
-codeOut('    // ------------------------------------------ INSTANCE + STATIC METHODS')
-nativeCheck = "jsvIsNativeFunction(parent) && "
-codeOut('    if (jsvIsNativeFunction(parent)) {')
-first = True
-for className in builtins:
-  if className.startswith(nativeCheck):    
-    codeOut('      '+("" if first else "} else ")+'if ('+className[len(nativeCheck):]+') {')
-    first = False
-    codeOutBuiltins("        v = ", builtins[className])
-    codeOut('        if (v) return v;');
-if not first:
-  codeOut("      }")
-codeOut('    }')
-for className in builtins:
-  if className!="parent" and  className!="!parent" and not "constructorPtr" in className and not className.startswith(nativeCheck):
-    codeOut('    if ('+className+') {')
-    codeOutBuiltins("      v = ", builtins[className])
-    codeOut('      if (v) return v;');
-    codeOut("    }")
-codeOut('    // ------------------------------------------ INSTANCE METHODS WE MUST CHECK CONSTRUCTOR FOR')
-codeOut('    JsVar *proto = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_INHERITS_VAR, false)):0;')
-codeOut('    JsVar *constructor = jsvIsObject(proto)?jsvSkipNameAndUnLock(jsvFindChildFromString(proto, JSPARSE_CONSTRUCTOR_VAR, false)):0;')
-codeOut('    jsvUnLock(proto);')
-codeOut('    if (constructor && jsvIsNativeFunction(constructor)) {')
-codeOut('      void *constructorPtr = constructor->varData.native.ptr;')
-codeOut('      jsvUnLock(constructor);')
-first = True
-for className in builtins:
-  if "constructorPtr" in className:
-    if first:
-      codeOut('      if ('+className+') {')
-      first = False
-    else:
-      codeOut('      } else if ('+className+') {')
-    codeOutBuiltins("        v = ", builtins[className])
-    codeOut('        if (v) return v;')
-if not first:
-  codeOut("      }")
-codeOut('    } else {')
-codeOut('      jsvUnLock(constructor);')
-codeOut('    }')
-codeOut('    // ------------------------------------------ METHODS ON OBJECT')
-if "parent" in builtins:
-  codeOutBuiltins("    v = ", builtins["parent"])
-  codeOut('    if (v) return v;');
+codeOutFindInParent(codeOutSearchFunction)
 codeOut('  } else { /* if (!parent) */')
 codeOut('    // ------------------------------------------ FUNCTIONS')
 codeOut('    // Handle pin names - eg LED1 or D5 (this is hardcoded in build_jsfunctions.py)')
@@ -432,6 +581,17 @@ codeOut('}')
 codeOut('')
 codeOut('')
 
+codeOut('#ifndef SAVE_ON_FLASH')
+codeOut('bool jswFindBuiltInSymbol(JsVar *parent, const char *name, JswBuiltInSymbol *symbol) {')
+codeOut('  if (!parent || jsvIsRoot(parent)) return false;')
+codeOutFindInParent(codeOutSearchSymbol)
+codeOut('  return false;')
+codeOut('}')
+codeOut('#endif')
+
+codeOut('')
+codeOut('')
+
 codeOut('const JswSymList *jswGetSymbolListForObject(JsVar *parent) {') 
 for className in builtins:
   builtin = builtins[className]
@@ -532,6 +692,50 @@ codeOut('}')
 codeOut('')
 codeOut('')
 
+codeOut("/** Native state for built-in classes - see JSW_NATIVE_STATE */")
+# Each state type gets its own non-zero id, so one class's state is never read as another's.
+# Classes that share a type (eg. Map and Set) share an id.
+stateTypes = sorted(set([jsondata["state"] for jsondata in jsondatas if "type" in jsondata and jsondata["type"]=="class" and "state" in jsondata]))
+if len(stateTypes)>255:
+  print("Too many native state types ("+str(len(stateTypes))+")")
+  exit(1)
+for jsondata in jsondatas:
+  if "type" in jsondata and jsondata["type"]=="class" and "state" in jsondata:
+    className = jsondata["class"]
+    stateType = jsondata["state"]
+    stateId = str(stateTypes.index(stateType)+1)
+    codeOut(stateType+" *jswNewState_"+className+"(JsVar *parent) {")
+    codeOut("  return ("+stateType+"*)jsvObjectNewNativeState(parent, sizeof("+stateType+"), "+stateId+");")
+    codeOut("}")
+    codeOut(stateType+" *jswGetState_"+className+"(JsVar *parent) {")
+    codeOut("  return ("+stateType+"*)jsvObjectGetNativeState(parent, sizeof("+stateType+"), "+stateId+");")
+    codeOut("}")
+
+stateCopiers = {}
+for jsondata in jsondatas:
+  if "type" in jsondata and jsondata["type"]=="class" and "state" in jsondata and "copystate" in jsondata:
+    stateId = stateTypes.index(jsondata["state"])+1
+    if stateId in stateCopiers and stateCopiers[stateId]!=jsondata["copystate"]:
+      print("Classes using "+jsondata["state"]+" have different copystate functions")
+      exit(1)
+    stateCopiers[stateId] = jsondata["copystate"]
+codeOut("/** Called by jsvCopy once 'dst' has its own copy of src's native state block */")
+codeOut("void jswCopyState(JsVar *src, JsVar *dst, unsigned char typeId) {")
+if len(stateCopiers)==0:
+  codeOut("  NOT_USED(src);")
+  codeOut("  NOT_USED(dst);")
+  codeOut("  NOT_USED(typeId);")
+else:
+  codeOut("  switch (typeId) {")
+  for stateId in sorted(stateCopiers):
+    codeOut("    case "+str(stateId)+": "+stateCopiers[stateId]+"(src, dst); break;")
+  codeOut("    default: break; // the block is all the state there is")
+  codeOut("  }")
+codeOut("}")
+
+codeOut('')
+codeOut('')
+
 codeOut("/** Tasks to run on Idle. Returns true if either one of the tasks returned true (eg. they're doing something and want to avoid sleeping) */")
 codeOut('bool jswIdle() {')
 codeOut('  bool wasBusy = false;')  
@@ -266,6 +266,10 @@ codeOut("#define FLASH_TOTAL ("+str(board.chip['flash'])+"*1024)")
 codeOut("");
 if LINUX:
   codeOut('#define RESIZABLE_JSVARS // Allocate variables in blocks using malloc')
+  codeOut('#define JSVARS_NO_IRQ_ALLOC // The input and util timer threads never allocate or free variables')
+  codeOut('// The util timer runs in another thread, so sleep between WAIT_UNTIL checks (for up to ~1s) rather than spinning')
+  codeOut('#define WAIT_UNTIL_N_CYCLES 20000')
+  codeOut('#define WAIT_UNTIL_IDLE() jshDelayMicroseconds(50)')
   #codeOut("#define JSVAR_CACHE_SIZE                "+str(200)+" // Number of JavaScript variables in RAM")
 else:
   codeOut("#define JSVAR_CACHE_SIZE                "+str(variables)+" // Number of JavaScript variables in RAM")
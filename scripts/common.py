@@ -73,6 +73,8 @@ if "check_output" not in dir( subprocess ):
 #         "not_real_object" : "anything",    // optional - for classes, this means we shouldn't treat this as a built-in object, as internally it isn't stored in a JSV_OBJECT
 #         "prototype" : "Object",    // optional - for classes, this is what their prototype is. It's particlarly helpful if not_real_object, because there is no prototype var in that case
 #         "check" : "jsvIsFoo(var)", // for classes - this is code that returns true if 'var' is of the given type
+#         "state" : "JswFooState", // for classes - a C struct of internal state kept in a hidden block on each instance. Declare it with JSW_NATIVE_STATE(Foo, JswFooState)
+#         "copystate" : "jswrap_foo_copyState", // optional - for classes with "state", called as fn(src, dst) when an instance is copied, if the state refers to anything that mustn't be shared
 #         "ifndef" : "SAVE_ON_FLASH", // if the given preprocessor macro is defined, don't implement this
 #         "ifdef" : "USE_LCD_FOO", // if the given preprocessor macro isn't defined, don't implement this
 #         "#if" : "A>2", // add a #if statement in the generated C file (ONLY if type==object)
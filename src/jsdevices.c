@@ -58,6 +58,20 @@ typedef enum {
 JshSerialDeviceState jshSerialDeviceStates[EV_SERIAL1+USART_COUNT-EV_SERIAL_START];
 #define TO_SERIAL_DEVICE_STATE(X) ((X)-EV_SERIAL_START)
 
+/// What to do for each device when txBuffer is full - see JshTxOverflowPolicy
+typedef struct {
+  JshTxOverflowPolicy policy;
+  bool queued; ///< We have a JsVar queue, so new characters must go into it to stay in order
+  unsigned short queueHead, queueLength; ///< Position in the JsVar queue (a flat string of TX_QUEUE_MAX bytes)
+  unsigned int dropped; ///< Characters we had to throw away
+} JshTxOverflowState;
+JshTxOverflowState jshTxOverflowStates[EV_SERIAL1+USART_COUNT-EV_SERIAL_START];
+/// Object in hiddenRoot holding the queues for JSH_TX_OVERFLOW_QUEUE, keyed by device name
+#define JSH_TX_QUEUE_NAME "txq"
+
+static int jshRemoveCharToTransmit(IOEventFlags device);
+static void jshTransmitQueue(IOEventFlags device, unsigned char data);
+
 // ----------------------------------------------------------------------------
 //                                                              IO EVENT BUFFER
 volatile IOEvent ioBuffer[IOBUFFERMASK+1];
@@ -82,6 +96,14 @@ void jshResetDevices() {
   for (i=0;i<sizeof(jshSerialDeviceStates) / sizeof(JshSerialDeviceState);i++)
     jshSerialDeviceStates[i] = SDS_NONE;
   jshSerialDeviceStates[TO_SERIAL_DEVICE_STATE(EV_USBSERIAL)] = SDS_FLOW_CONTROL_XON_XOFF;
+  // everything blocks when full again, and any queued data is discarded
+  for (i=0;i<sizeof(jshTxOverflowStates) / sizeof(JshTxOverflowState);i++) {
+    jshTxOverflowStates[i].policy = JSH_TX_OVERFLOW_BLOCK;
+    jshTxOverflowStates[i].queued = false;
+    jshTxOverflowStates[i].queueHead = 0;
+    jshTxOverflowStates[i].queueLength = 0;
+    jshTxOverflowStates[i].dropped = 0;
+  }
   // set up callbacks for events
   for (i=EV_EXTI0;i<=EV_EXTI_MAX;i++)
     jshEventCallbacks[i-EV_EXTI0] = 0;
@@ -118,18 +140,44 @@ void jshTransmit(
 #endif
 #else // if PC, just put to stdout
   if (device==DEFAULT_CONSOLE_DEVICE) {
-    fputc(data, stdout);
-    fflush(stdout);
+    // stdout is flushed from jshIdle/jshSleep/jshTransmitFlush, not for every character
+    putc(data, stdout);
     return;
   }
 #endif
   // If the device is EV_NONE then there is nowhere to send the data.
   if (device==EV_NONE) return;
 
+  // If earlier characters were queued, this one must go after them
+  if (DEVICE_IS_USART(device) && jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)].queued) {
+    jshTransmitQueue(device, data);
+    return;
+  }
+
   // The txHead global points to the current item in the txBuffer.  Since we are adding a new
   // character, we increment the head pointer.   If it has caught up with the tail, then that means
-  // we have filled the array backing the list.  What we do next is to wait for space to free up.
+  // we have filled the array backing the list.  What we do next depends on the device's
+  // JshTxOverflowPolicy - by default we wait for space to free up.
   unsigned char txHeadNext = (unsigned char)((txHead+1)&TXBUFFERMASK);
+  if (txHeadNext==txTail) {
+    JshTxOverflowPolicy policy = jshGetTxOverflowPolicy(device);
+    if (policy==JSH_TX_OVERFLOW_DROP_NEWEST) {
+      jshTransmitDropped(device);
+      return;
+    }
+    if (policy==JSH_TX_OVERFLOW_QUEUE) {
+      jshTransmitQueue(device, data);
+      return;
+    }
+    if (policy==JSH_TX_OVERFLOW_DROP_OLDEST) {
+      jshTransmitDropped(device);
+      jshInterruptOff();
+      bool removed = jshRemoveCharToTransmit(device)>=0;
+      jshInterruptOn();
+      // if there was nothing of ours to remove, throw away the new character instead
+      if (!removed) return;
+    }
+  }
   if (txHeadNext==txTail) {
     jsiSetBusy(BUSY_TRANSMIT, true);
     bool wasConsoleLimbo = device==EV_LIMBO && jsiGetConsoleDevice()==EV_LIMBO;
@@ -184,6 +232,11 @@ int jshGetCharToTransmit(
     }
   }
 
+  return jshRemoveCharToTransmit(device);
+}
+
+/// Remove the oldest character waiting in txBuffer for the given device, or return -1 if there is none
+static int jshRemoveCharToTransmit(IOEventFlags device) {
   unsigned char tempTail = txTail;
   while (txHead != tempTail) {
     if (IOEVENTFLAGS_GETTYPE(txBuffer[tempTail].flags) == device) {
@@ -210,6 +263,9 @@ void jshTransmitFlush() {
   jsiSetBusy(BUSY_TRANSMIT, true);
   while (jshHasTransmitData()) ; // wait for send to finish
   jsiSetBusy(BUSY_TRANSMIT, false);
+#ifdef LINUX
+  fflush(stdout);
+#endif
 }
 
 /**
@@ -220,6 +276,9 @@ void jshTransmitClearDevice(
   ) {
   // Keep requesting a character to transmit until there are no further characters.
   while (jshGetCharToTransmit(device)>=0);
+  // Forget anything queued too - jshTransmitIdle will free the queue
+  if (DEVICE_IS_USART(device))
+    jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)].queueLength = 0;
 }
 
 /// Move all output from one device to another
@@ -235,6 +294,121 @@ void jshTransmitMove(IOEventFlags from, IOEventFlags to) {
   jshInterruptOn();
 }
 
+void jshSetTxOverflowPolicy(IOEventFlags device, JshTxOverflowPolicy policy) {
+  if (!DEVICE_IS_USART(device)) return;
+  JshTxOverflowState *txState = &jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)];
+  // anything already queued still gets sent from jshTransmitIdle
+  txState->policy = policy;
+  txState->dropped = 0;
+}
+
+JshTxOverflowPolicy jshGetTxOverflowPolicy(IOEventFlags device) {
+  if (!DEVICE_IS_USART(device)) return JSH_TX_OVERFLOW_BLOCK;
+  return jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)].policy;
+}
+
+void jshTransmitDropped(IOEventFlags device) {
+  if (!DEVICE_IS_USART(device)) return;
+  jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)].dropped++;
+}
+
+unsigned int jshGetTxDroppedCount(IOEventFlags device) {
+  if (!DEVICE_IS_USART(device)) return 0;
+  return jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)].dropped;
+}
+
+/// Get the flat string we queue characters in for the given device, creating it if needed
+static JsVar *jshGetTxQueue(IOEventFlags device, bool create) {
+  const char *name = jshGetDeviceString(device);
+  if (!execInfo.hiddenRoot || !name) return 0;
+  JsVar *queues = jsvObjectGetChild(execInfo.hiddenRoot, JSH_TX_QUEUE_NAME, create ? JSV_OBJECT : 0);
+  if (!queues) return 0;
+  JsVar *queue = jsvObjectGetChild(queues, name, 0);
+  if (queue && !jsvIsFlatString(queue)) {
+    // not one of ours (maybe it was saved and loaded) - start again
+    jsvUnLock(queue);
+    queue = 0;
+  }
+  if (!queue && create) {
+    queue = jsvNewFlatStringOfLength(TX_QUEUE_MAX);
+    if (queue) jsvObjectSetChild(queues, name, queue);
+  }
+  jsvUnLock(queues);
+  return queue;
+}
+
+/// Add a character to the JsVar queue for a device with JSH_TX_OVERFLOW_QUEUE, or drop it if we can't
+static void jshTransmitQueue(IOEventFlags device, unsigned char data) {
+  JshTxOverflowState *txState = &jshTxOverflowStates[TO_SERIAL_DEVICE_STATE(device)];
+  // 'busy' stops us recursing if allocating the queue tries to print something
+  static bool busy = false;
+  JsVar *queue = 0;
+  if (txState->queueLength<TX_QUEUE_MAX && !busy) {
+    busy = true;
+    queue = jshGetTxQueue(device, true);
+    busy = false;
+  }
+  if (!queue) {
+    jshTransmitDropped(device);
+    return;
+  }
+  if (!txState->queued) {
+    txState->queued = true;
+    txState->queueHead = 0;
+    txState->queueLength = 0;
+  }
+  char *buf = jsvGetFlatStringPointer(queue);
+  buf[(txState->queueHead + txState->queueLength) % TX_QUEUE_MAX] = (char)data;
+  txState->queueLength++;
+  jsvUnLock(queue);
+}
+
+bool jshTransmitIdle() {
+  bool stillQueued = false;
+  unsigned int i;
+  for (i=0;i<sizeof(jshTxOverflowStates) / sizeof(JshTxOverflowState);i++) {
+    JshTxOverflowState *txState = &jshTxOverflowStates[i];
+    if (!txState->queued) continue;
+    IOEventFlags device = (IOEventFlags)(EV_SERIAL_START+i);
+    JsVar *queue = jshGetTxQueue(device, false);
+    if (queue) {
+      // Move as much as we can into txBuffer - we're the only thing adding to it
+      char *buf = jsvGetFlatStringPointer(queue);
+      bool moved = false;
+      while (txState->queueLength) {
+        unsigned char txHeadNext = (unsigned char)((txHead+1)&TXBUFFERMASK);
+        if (txHeadNext==txTail) break;
+        txBuffer[txHead].flags = device;
+        txBuffer[txHead].data = (unsigned char)buf[txState->queueHead];
+        txHead = txHeadNext;
+        txState->queueHead = (unsigned short)((txState->queueHead+1) % TX_QUEUE_MAX);
+        txState->queueLength--;
+        moved = true;
+      }
+      jsvUnLock(queue);
+      if (moved) jshUSARTKick(device);
+    } else {
+      // someone removed our queue (eg. by loading new code) - we've lost the data
+      txState->dropped += txState->queueLength;
+      txState->queueLength = 0;
+    }
+    if (txState->queueLength) {
+      stillQueued = true;
+    } else {
+      // All sent - free the queue so it isn't using memory
+      txState->queued = false;
+      JsVar *queues = jsvObjectGetChild(execInfo.hiddenRoot, JSH_TX_QUEUE_NAME, 0);
+      if (queues) {
+        jsvRemoveNamedChild(queues, jshGetDeviceString(device));
+        if (!jsvGetChildren(queues))
+          jsvRemoveNamedChild(execInfo.hiddenRoot, JSH_TX_QUEUE_NAME);
+        jsvUnLock(queues);
+      }
+    }
+  }
+  return stillQueued;
+}
+
 /**
  * Determine if we have data to be transmitted.
  * \return True if we have data to transmit and false otherwise.
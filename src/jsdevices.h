@@ -177,6 +177,30 @@ IOEventFlags jshGetDeviceToTransmit();
 /// Try and get a character for transmission - could just return -1 if nothing
 int jshGetCharToTransmit(IOEventFlags device);
 
+/// What jshTransmit does when the transmit buffer is full
+typedef enum {
+  JSH_TX_OVERFLOW_BLOCK,       ///< Wait until there is space (the default)
+  JSH_TX_OVERFLOW_DROP_NEWEST, ///< Throw away the character being written
+  JSH_TX_OVERFLOW_DROP_OLDEST, ///< Throw away the oldest character waiting for this device
+  JSH_TX_OVERFLOW_QUEUE,       ///< Store characters in a JsVar string, moved to the buffer from jshTransmitIdle
+} PACKED_FLAGS JshTxOverflowPolicy;
+
+/// Maximum number of characters stored for a device with JSH_TX_OVERFLOW_QUEUE before we drop them
+#ifndef TX_QUEUE_MAX
+#define TX_QUEUE_MAX 1024
+#endif
+
+/// Set what happens when the transmit buffer is full for a device (resets the dropped count)
+void jshSetTxOverflowPolicy(IOEventFlags device, JshTxOverflowPolicy policy);
+/// Get what happens when the transmit buffer is full for a device
+JshTxOverflowPolicy jshGetTxOverflowPolicy(IOEventFlags device);
+/// Record that a character for this device had to be thrown away
+void jshTransmitDropped(IOEventFlags device);
+/// How many characters have been thrown away for this device since its policy was set?
+unsigned int jshGetTxDroppedCount(IOEventFlags device);
+/// Move queued characters into the transmit buffer. Returns true if any are still waiting
+bool jshTransmitIdle();
+
 
 /// Set whether the host should transmit or not
 void jshSetFlowControlXON(IOEventFlags device, bool hostShouldTransmit);
@@ -388,7 +388,9 @@ unsigned int jshGetRandomNumber();
 unsigned int jshSetSystemClock(JsVar *options);
 
 /** Hacky definition of wait cycles used for WAIT_UNTIL.
- * TODO: make this depend on known system clock speed? */
+ * TODO: make this depend on known system clock speed?
+ * Boards can override this (and WAIT_UNTIL_IDLE) in their board config */
+#ifndef WAIT_UNTIL_N_CYCLES
 #if defined(STM32F401xx) || defined(STM32F411xx)
 #define WAIT_UNTIL_N_CYCLES 2000000
 #elif defined(STM32F4)
@@ -396,12 +398,18 @@ unsigned int jshSetSystemClock(JsVar *options);
 #else
 #define WAIT_UNTIL_N_CYCLES 2000000
 #endif
+#endif
+
+/// Called each time WAIT_UNTIL checks its condition and finds it false
+#ifndef WAIT_UNTIL_IDLE
+#define WAIT_UNTIL_IDLE()
+#endif
 
 /** Wait for the condition to become true, checking a certain amount of times
  * (or until interrupted by Ctrl-C) before leaving and writing a message. */
 #define WAIT_UNTIL(CONDITION, REASON) { \
     int timeout = WAIT_UNTIL_N_CYCLES;                                              \
-    while (!(CONDITION) && !jspIsInterrupted() && (timeout--)>0);                  \
+    while (!(CONDITION) && !jspIsInterrupted() && (timeout--)>0) WAIT_UNTIL_IDLE(); \
     if (timeout<=0 || jspIsInterrupted()) { jsExceptionHere(JSET_INTERNALERROR, "Timeout on "REASON); }  \
 }
 
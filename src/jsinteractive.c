@@ -22,6 +22,7 @@
 #include "jswrap_stream.h"
 #include "jswrap_flash.h" // load and save to flash
 #include "jswrap_object.h" // jswrap_object_keys_or_property_names
+#include "jswrap_functions.h" // jswrap_function_cache_flush
 #include "jsnative.h" // jsnSanityTest
 
 #ifdef ARM
@@ -50,6 +51,30 @@ typedef enum {
 JsVar *events = 0; // Array of events to execute
 JsVarRef timerArray = 0; // Linked List of timers to check and run
 JsVarRef watchArray = 0; // Linked List of input watches to check and run
+
+/** Native copy of each watch in watchArray. The JS objects are what get saved
+ * and dumped, but the event loop only uses this table for filtering edges,
+ * debouncing and recurrence - the JS object is only touched when a callback
+ * actually has to be called. */
+typedef struct {
+  JsVarRef watch;         ///< The watch object in watchArray, or 0 if this slot is free
+  Pin pin;
+  signed char edge;       ///< 0 = both, 1 = rising, -1 = falling
+  bool recur;
+  bool state;             ///< The last state of the pin (when debouncing)
+  bool hasLastTime;
+  bool debouncing;        ///< Waiting for the pin to settle before calling back
+  JsVarInt debounce;      ///< Debounce time in JsSysTime units, or 0
+  JsSysTime lastTime;     ///< Time the watch was last triggered
+  JsSysTime debounceTime; ///< When the pending debounced event will fire
+} JsiWatch;
+
+#define JSI_WATCH_TABLE_NAME "wtab" ///< Name of the flat string in hiddenRoot that holds the watch table
+#define JSI_WATCH_TABLE_INITIAL 8 ///< Number of watches the table is first allocated with - it doubles when full
+static JsiWatch *jsiWatches = 0; ///< Points into the watch table's flat string (flat strings never move), or 0
+static int jsiWatchSize = 0; ///< Number of slots allocated in jsiWatches
+static int jsiWatchCount = 0; ///< Slots in jsiWatches that have been used (some may now be free)
+static void jsiWatchFreeTable();
 // ----------------------------------------------------------------------------
 IOEventFlags consoleDevice = DEFAULT_CONSOLE_DEVICE; ///< The console device for user interaction
 Pin pinBusyIndicator = DEFAULT_BUSY_PIN_INDICATOR;
@@ -69,6 +94,9 @@ uint16_t jsiLineNumberOffset; ///< When we execute code, this is the 'offset' we
 bool hasUsedHistory = false; ///< Used to speed up - if we were cycling through history and then edit, we need to copy the string
 unsigned char loopsIdling; ///< How many times around the loop have we been entirely idle?
 bool interruptedDuringEvent; ///< Were we interrupted while executing an event? If so may want to clear timers
+unsigned char lowMemoryThresholds[JSI_LOW_MEMORY_LEVELS] = JSI_LOW_MEMORY_THRESHOLDS_DEFAULT; ///< % of free memory below which each `E.on('lowMemory'` level is reached (0 = unused)
+unsigned char lowMemoryLevel; ///< The last `E.on('lowMemory'` level we reported
+JsSysTime lowMemoryLastGC; ///< When jsiCheckLowMemory last collected garbage
 // ----------------------------------------------------------------------------
 
 #ifdef USE_DEBUGGER
@@ -449,6 +477,9 @@ void jsiSoftInit(bool hasBeenReset) {
   jsiLastIdleTime = jshGetSystemTime();
   jsiTimeSinceCtrlC = 0xFFFFFFFF;
 
+  // Thresholds set with E.setLowMemoryThresholds don't survive a reset
+  jsiSetLowMemoryThresholds(0);
+
   // Run wrapper initialisation stuff
   jswInit();
 
@@ -462,17 +493,24 @@ void jsiSoftInit(bool hasBeenReset) {
     jsvRemoveNamedChild(execInfo.hiddenRoot, JSI_INIT_CODE_NAME);
   }
 
-  // Check any existing watches and set up interrupts for them
+  // Check any existing watches, add them to our table and set up interrupts for them
+  jsiWatchFreeTable();
   if (watchArray) {
     JsVar *watchArrayPtr = jsvLock(watchArray);
     JsvObjectIterator it;
     jsvObjectIteratorNew(&it, watchArrayPtr);
     while (jsvObjectIteratorHasValue(&it)) {
       JsVar *watch = jsvObjectIteratorGetValue(&it);
-      JsVar *watchPin = jsvObjectGetChild(watch, "pin", 0);
-      jshPinWatch(jshGetPinFromVar(watchPin), true);
-      jsvUnLock2(watchPin, watch);
-      jsvObjectIteratorNext(&it);
+      Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChild(watch, "pin", 0));
+      bool isWatched = jsiIsWatchingPin(pin);
+      if (jsiWatchAdd(watch)) {
+        if (!isWatched) jshPinWatch(pin, true);
+        jsvObjectIteratorNext(&it);
+      } else {
+        jsError("Not enough memory for watch - removing it");
+        jsvObjectIteratorRemoveAndGotoNext(&it, watchArrayPtr);
+      }
+      jsvUnLock(watch);
     }
     jsvObjectIteratorFree(&it);
     jsvUnLock(watchArrayPtr);
@@ -500,6 +538,56 @@ void jsiSoftInit(bool hasBeenReset) {
   }
 }
 
+/// Set the percentages of free memory at which `E.on('lowMemory'` levels are reached. 0 = use defaults
+void jsiSetLowMemoryThresholds(unsigned char *thresholds) {
+  static const unsigned char defaults[JSI_LOW_MEMORY_LEVELS] = JSI_LOW_MEMORY_THRESHOLDS_DEFAULT;
+  memcpy(lowMemoryThresholds, thresholds ? thresholds : defaults, JSI_LOW_MEMORY_LEVELS);
+  lowMemoryLevel = 0;
+  lowMemoryLastGC = 0;
+}
+
+/// Work out how many of the low memory thresholds (each raised by 'margin' %) free memory is below
+static unsigned char jsiGetLowMemoryLevel(unsigned int margin) {
+  unsigned int total = jsvGetMemoryTotal();
+  unsigned int freeVars = total - jsvGetMemoryUsage();
+  unsigned char level = 0;
+  while (level<JSI_LOW_MEMORY_LEVELS && lowMemoryThresholds[level] &&
+         freeVars*100 < total*(lowMemoryThresholds[level]+margin))
+    level++;
+  return level;
+}
+
+/** If free memory has dropped below one of the thresholds since last
+ * time, fire `E.on('lowMemory', level)` so code can free what it can
+ * before an allocation actually fails. */
+static void jsiCheckLowMemory() {
+  if (jsiGetLowMemoryLevel(0) > lowMemoryLevel) {
+    // it may just be garbage - but don't collect it every time around the idle loop
+    JsSysTime time = jshGetSystemTime();
+    if (lowMemoryLastGC && time < lowMemoryLastGC+jshGetTimeFromMilliseconds(JSI_LOW_MEMORY_GC_INTERVAL))
+      return;
+    lowMemoryLastGC = time;
+    jsiSetBusy(BUSY_INTERACTIVE, true);
+    jsvGarbageCollect();
+    jsiSetBusy(BUSY_INTERACTIVE, false);
+    unsigned char level = jsiGetLowMemoryLevel(0);
+    if (level > lowMemoryLevel) {
+      JsVar *E = jsvObjectGetChild(execInfo.root, "E", 0);
+      if (E) {
+        JsVar *levelVar = jsvNewFromInteger(level);
+        jsiQueueObjectCallbacks(E, LOWMEMORY_CALLBACK_NAME, &levelVar, 1);
+        jsvUnLock2(levelVar, E);
+      }
+      lowMemoryLevel = level;
+      return;
+    }
+  }
+  /* Only go back down a level once there's a bit more free memory than its
+   * threshold, so hovering around it doesn't keep firing the event */
+  unsigned char level = jsiGetLowMemoryLevel(JSI_LOW_MEMORY_HYSTERESIS);
+  if (level < lowMemoryLevel) lowMemoryLevel = level;
+}
+
 /** Output the given variable as JSON, or if it exists
  * in the root scope (and it's not 'existing') then just
  * the name is dumped.  */
@@ -677,6 +765,10 @@ void jsiSoftKill() {
 
   // kill any wrapped stuff
   jswKill();
+#ifndef SAVE_ON_FLASH
+  // don't save cached switch tables or literal templates
+  jspCodeCacheFlush();
+#endif
   // Stop all active timer tasks
   jstReset();
   // Unref Watches/etc
@@ -689,18 +781,14 @@ void jsiSoftKill() {
     timerArray=0;
   }
   if (watchArray) {
-    // Check any existing watches and disable interrupts for them
+    // Disable interrupts for any existing watches. The watch objects stay
+    // in watchArray, and the table is rebuilt from them in jsiSoftInit
+    int i;
+    for (i=0;i<jsiWatchCount;i++)
+      if (jsiWatches[i].watch)
+        jshPinWatch(jsiWatches[i].pin, false);
+    jsiWatchFreeTable();
     JsVar *watchArrayPtr = jsvLock(watchArray);
-    JsvObjectIterator it;
-    jsvObjectIteratorNew(&it, watchArrayPtr);
-    while (jsvObjectIteratorHasValue(&it)) {
-      JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
-      JsVar *watchPin = jsvObjectGetChild(watchPtr, "pin", 0);
-      jshPinWatch(jshGetPinFromVar(watchPin), false);
-      jsvUnLock2(watchPin, watchPtr);
-      jsvObjectIteratorNext(&it);
-    }
-    jsvObjectIteratorFree(&it);
     jsvUnRef(watchArrayPtr);
     jsvUnLock(watchArrayPtr);
     watchArray=0;
@@ -847,6 +935,11 @@ int jsiCountBracketsInInput() {
 
 /// Tries to get rid of some memory (by clearing command history). Returns true if it got rid of something, false if it didn't.
 bool jsiFreeMoreMemory() {
+#ifndef SAVE_ON_FLASH
+  // cached Function code, switch tables and literal templates are the easiest things to get rid of
+  if (jswrap_function_cache_flush()) return true;
+  if (jspCodeCacheFlush()) return true;
+#endif
   JsVar *history = jsvObjectGetChild(execInfo.hiddenRoot, JSI_HISTORY_NAME, 0);
   if (!history) return 0;
   JsVar *item = jsvArrayPopFirst(history);
@@ -1570,6 +1663,10 @@ NO_INLINE bool jsiExecuteEventCallback(JsVar *thisVar, JsVar *callbackVar, unsig
 }
 
 bool jsiHasTimers() {
+  int i;
+  for (i=0;i<jsiWatchCount;i++)
+    if (jsiWatches[i].watch && jsiWatches[i].debouncing)
+      return true;
   if (!timerArray) return false;
   JsVar *timerArrayPtr = jsvLock(timerArray);
   bool hasTimers = !jsvArrayIsEmpty(timerArrayPtr);
@@ -1577,30 +1674,204 @@ bool jsiHasTimers() {
   return hasTimers;
 }
 
-/// Is the given watch object meant to be executed when the current value of the pin is pinIsHigh
-bool jsiShouldExecuteWatch(JsVar *watchPtr, bool pinIsHigh) {
-  int watchEdge = (int)jsvGetIntegerAndUnLock(jsvObjectGetChild(watchPtr, "edge", 0));
-  return watchEdge==0 || // any edge
-      (pinIsHigh && watchEdge>0) || // rising edge
-      (!pinIsHigh && watchEdge<0); // falling edge
+bool jsiIsWatchingPin(Pin pin) {
+  int i;
+  for (i=0;i<jsiWatchCount;i++)
+    if (jsiWatches[i].watch && jsiWatches[i].pin == pin)
+      return true;
+  return false;
+}
+
+/** Make sure the watch table has at least n slots, moving it to a bigger
+ * flat string if needed. Returns false if we're out of memory. Anything
+ * holding a JsiWatch pointer must get it again after this. */
+static bool jsiWatchEnsureSize(int n) {
+  if (n <= jsiWatchSize) return true;
+  int size = jsiWatchSize ? jsiWatchSize*2 : JSI_WATCH_TABLE_INITIAL;
+  while (size < n) size *= 2;
+  JsVar *table = jsvNewFlatStringOfLength((unsigned int)size * (unsigned int)sizeof(JsiWatch));
+  if (!table) return false;
+  JsiWatch *watches = (JsiWatch*)jsvGetFlatStringPointer(table);
+  if (jsiWatchCount)
+    memcpy(watches, jsiWatches, (size_t)jsiWatchCount * sizeof(JsiWatch));
+  // this frees the old table
+  jsvObjectSetChildAndUnLock(execInfo.hiddenRoot, JSI_WATCH_TABLE_NAME, table);
+  jsiWatches = watches;
+  jsiWatchSize = size;
+  return true;
 }
 
-bool jsiIsWatchingPin(Pin pin) {
-  bool isWatched = false;
-  JsVar *watchArrayPtr = jsvLock(watchArray);
-  JsvObjectIterator it;
-  jsvObjectIteratorNew(&it, watchArrayPtr);
-  while (jsvObjectIteratorHasValue(&it)) {
-    JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
-    JsVar *pinVar = jsvObjectGetChild(watchPtr, "pin", 0);
-    if (jshGetPinFromVar(pinVar) == pin)
-      isWatched = true;
-    jsvUnLock2(pinVar, watchPtr);
-    jsvObjectIteratorNext(&it);
+/// Throw away the watch table (it's rebuilt from watchArray, so it shouldn't be saved)
+static void jsiWatchFreeTable() {
+  jsvRemoveNamedChild(execInfo.hiddenRoot, JSI_WATCH_TABLE_NAME);
+  jsiWatches = 0;
+  jsiWatchSize = 0;
+  jsiWatchCount = 0;
+}
+
+/// Add a watch object (already set up by setWatch) to the native watch table. Returns false if we're out of memory
+bool jsiWatchAdd(JsVar *watchPtr) {
+  int i = 0;
+  while (i<jsiWatchCount && jsiWatches[i].watch) i++;
+  if (!jsiWatchEnsureSize(i+1)) return false;
+  if (i==jsiWatchCount) jsiWatchCount++;
+  JsiWatch *w = &jsiWatches[i];
+  memset(w, 0, sizeof(JsiWatch));
+  w->watch = jsvGetRef(watchPtr);
+  w->pin = jshGetPinFromVarAndUnLock(jsvObjectGetChild(watchPtr, "pin", 0));
+  w->edge = (signed char)jsvGetIntegerAndUnLock(jsvObjectGetChild(watchPtr, "edge", 0));
+  w->recur = jsvGetBoolAndUnLock(jsvObjectGetChild(watchPtr, "recur", 0));
+  w->debounce = jsvGetIntegerAndUnLock(jsvObjectGetChild(watchPtr, "debounce", 0));
+  return true;
+}
+
+/// Remove the watch in the given slot, and stop watching its pin if nothing else is
+static void jsiWatchRemoveAt(int i) {
+  Pin pin = jsiWatches[i].pin;
+  jsiWatches[i].watch = 0;
+  while (jsiWatchCount>0 && !jsiWatches[jsiWatchCount-1].watch)
+    jsiWatchCount--;
+  if (!jsiIsWatchingPin(pin))
+    jshPinWatch(pin, false);
+}
+
+static int jsiWatchFind(JsVarRef watch) {
+  int i;
+  for (i=0;i<jsiWatchCount;i++)
+    if (jsiWatches[i].watch == watch)
+      return i;
+  return -1;
+}
+
+/// Remove a watch object from the native watch table (the caller removes it from watchArray)
+void jsiWatchRemove(JsVar *watchPtr) {
+  int i = jsiWatchFind(jsvGetRef(watchPtr));
+  if (i>=0) jsiWatchRemoveAt(i);
+}
+
+/// Remove every watch from the native watch table, and stop watching their pins
+void jsiWatchRemoveAll() {
+  while (jsiWatchCount>0) {
+    jsiWatchCount--;
+    if (jsiWatches[jsiWatchCount].watch)
+      jshPinWatch(jsiWatches[jsiWatchCount].pin, false);
   }
-  jsvObjectIteratorFree(&it);
-  jsvUnLock(watchArrayPtr);
-  return isWatched;
+}
+
+/// Trigger the watch in slot i for a pin change at 'time'. Only calls back if the edge matches
+static void jsiExecuteWatch(int i, JsSysTime time, bool pinIsHigh) {
+  JsiWatch *w = &jsiWatches[i];
+  bool hadLastTime = w->hasLastTime;
+  JsSysTime lastTime = w->lastTime;
+  w->lastTime = time;
+  w->hasLastTime = true;
+  if (!(w->edge==0 || // any edge
+        (pinIsHigh && w->edge>0) || // rising edge
+        (!pinIsHigh && w->edge<0))) // falling edge
+    return;
+
+  // copy what we need - the callback could change the watch table
+  JsVarRef watchRef = w->watch;
+  bool watchRecurring = w->recur;
+  Pin pin = w->pin;
+  JsVar *watchPtr = jsvLock(watchRef);
+  JsVar *watchCallback = jsvObjectGetChild(watchPtr, "callback", 0);
+  JsVar *data = jsvNewObject();
+  if (data) {
+    if (hadLastTime)
+      jsvObjectSetChildAndUnLock(data, "lastTime", jsvNewFromFloat(jshGetMillisecondsFromTime(lastTime)/1000));
+    jsvObjectSetChildAndUnLock(data, "time", jsvNewFromFloat(jshGetMillisecondsFromTime(time)/1000));
+    jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(pin));
+    jsvObjectSetChildAndUnLock(data, "state", jsvNewFromBool(pinIsHigh));
+  }
+  if (!jsiExecuteEventCallback(0, watchCallback, 1, &data) && watchRecurring) {
+    jsError("Ctrl-C while processing watch - removing it.");
+    jsErrorFlags |= JSERR_CALLBACK;
+    watchRecurring = false;
+  }
+  jsvUnLock2(data, watchCallback);
+  if (!watchRecurring) {
+    // the callback may have removed the watch itself with clearWatch
+    i = jsiWatchFind(watchRef);
+    if (i>=0) {
+      jsiWatchRemoveAt(i);
+      JsVar *watchArrayPtr = jsvLock(watchArray);
+      JsVar *watchNamePtr = jsvGetArrayIndexOf(watchArrayPtr, watchPtr, true);
+      if (watchNamePtr) {
+        jsvRemoveChild(watchArrayPtr, watchNamePtr);
+        jsvUnLock(watchNamePtr);
+      }
+      jsvUnLock(watchArrayPtr);
+    }
+  }
+  jsvUnLock(watchPtr);
+}
+
+/// Handle a pin change event for every watch on that pin
+static void jsiHandleIOEventForWatches(IOEvent *event) {
+  /** Work out event time. Events time is only stored in 32 bits, so we need to
+   * use the correct 'high' 32 bits from the current time.
+   *
+   * We know that the current time is always newer than the event time, so
+   * if the bottom 32 bits of the current time is less than the bottom
+   * 32 bits of the event time, we need to subtract a full 32 bits worth
+   * from the current time.
+   */
+  JsSysTime time = jshGetSystemTime();
+  if (((unsigned int)time) < (unsigned int)event->data.time)
+    time = time - 0x100000000LL;
+  // finally, mask in the event's time
+  JsSysTime eventTime = (time & ~0xFFFFFFFFLL) | (JsSysTime)event->data.time;
+  bool pinIsHigh = (event->flags&EV_EXTI_IS_HIGH)!=0;
+
+  /* Callbacks may add or remove watches. Removed slots are just marked free,
+   * so indices stay valid while we go through the table */
+  int i;
+  for (i=0;i<jsiWatchCount;i++) {
+    JsiWatch *w = &jsiWatches[i];
+    if (!w->watch || !jshIsEventForPin(event, w->pin)) continue;
+
+    if (w->debounce<=0) {
+      jsiExecuteWatch(i, eventTime, pinIsHigh);
+    } else { // Debouncing - only fire once the pin has stopped changing
+      bool oldWatchState = w->state;
+      w->state = pinIsHigh;
+      if (w->debouncing) {
+        JsSysTime timeoutTime = w->debounceTime;
+        w->debounceTime = eventTime + w->debounce;
+        if (eventTime > timeoutTime) {
+          // debounce should have fired, but we didn't get around to executing it!
+          // Do it now (with the old time and state)
+          jsiExecuteWatch(i, timeoutTime - w->debounce, oldWatchState);
+        }
+      } else {
+        w->debouncing = true;
+        w->debounceTime = eventTime + w->debounce;
+      }
+    }
+  }
+}
+
+/** Fire any debounced watches whose pins have settled by 'time'. Returns the
+ * time until the next one is due (or JSSYSTIME_MAX), and sets *wasBusy if anything ran */
+static JsSysTime jsiCheckWatchDebounce(JsSysTime time, bool *wasBusy) {
+  JsSysTime minTimeUntilNext = JSSYSTIME_MAX;
+  int i;
+  for (i=0;i<jsiWatchCount;i++) {
+    JsiWatch *w = &jsiWatches[i];
+    if (!w->watch || !w->debouncing) continue;
+    JsSysTime timeUntilNext = w->debounceTime - time;
+    if (timeUntilNext<=0) {
+      if (!*wasBusy) {
+        jsiSetBusy(BUSY_INTERACTIVE, true);
+        *wasBusy = true;
+      }
+      w->debouncing = false;
+      jsiExecuteWatch(i, w->debounceTime - w->debounce, w->state);
+    } else if (timeUntilNext < minTimeUntilNext)
+      minTimeUntilNext = timeUntilNext;
+  }
+  return minTimeUntilNext;
 }
 
 /** Take an event for a UART and handle the chareacters we're getting, potentially
@@ -1695,110 +1966,7 @@ void jsiIdle() {
       }
       jsvUnLock(usartClass);
     } else if (DEVICE_IS_EXTI(eventType)) { // ---------------------------------------------------------------- PIN WATCH
-      // we have an event... find out what it was for...
-      // Check everything in our Watch array
-      JsVar *watchArrayPtr = jsvLock(watchArray);
-      JsvObjectIterator it;
-      jsvObjectIteratorNew(&it, watchArrayPtr);
-      while (jsvObjectIteratorHasValue(&it)) {
-        bool hasDeletedWatch = false;
-        JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
-        Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChild(watchPtr, "pin", 0));
-
-        if (jshIsEventForPin(&event, pin)) {
-          /** Work out event time. Events time is only stored in 32 bits, so we need to
-           * use the correct 'high' 32 bits from the current time.
-           *
-           * We know that the current time is always newer than the event time, so
-           * if the bottom 32 bits of the current time is less than the bottom
-           * 32 bits of the event time, we need to subtract a full 32 bits worth
-           * from the current time.
-           */
-          JsSysTime time = jshGetSystemTime();
-          if (((unsigned int)time) < (unsigned int)event.data.time)
-            time = time - 0x100000000LL;
-          // finally, mask in the event's time
-          JsSysTime eventTime = (time & ~0xFFFFFFFFLL) | (JsSysTime)event.data.time;
-
-          // Now actually process the event
-          bool pinIsHigh = (event.flags&EV_EXTI_IS_HIGH)!=0;
-
-          bool executeNow = false;
-          JsVarInt debounce = jsvGetIntegerAndUnLock(jsvObjectGetChild(watchPtr, "debounce", 0));
-          if (debounce<=0) {
-            executeNow = true;
-          } else { // Debouncing - use timeouts to ensure we only fire at the right time
-            // store the current state of the pin
-            bool oldWatchState = jsvGetBoolAndUnLock(jsvObjectGetChild(watchPtr, "state",0));
-            jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(pinIsHigh));
-
-            JsVar *timeout = jsvObjectGetChild(watchPtr, "timeout", 0);
-            if (timeout) { // if we had a timeout, update the callback time
-              JsSysTime timeoutTime = jsiLastIdleTime + (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChild(timeout, "time", 0));
-              jsvUnLock(jsvObjectSetChild(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce)));
-              if (eventTime > timeoutTime) {
-                // timeout should have fired, but we didn't get around to executing it!
-                // Do it now (with the old timeout time)
-                executeNow = true;
-                eventTime = timeoutTime - debounce;
-                pinIsHigh = oldWatchState;
-              }
-            } else { // else create a new timeout
-              timeout = jsvNewObject();
-              if (timeout) {
-                jsvObjectSetChild(timeout, "watch", watchPtr); // no unlock
-                jsvObjectSetChildAndUnLock(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce));
-                jsvObjectSetChildAndUnLock(timeout, "callback", jsvObjectGetChild(watchPtr, "callback", 0));
-                jsvObjectSetChildAndUnLock(timeout, "lastTime", jsvObjectGetChild(watchPtr, "lastTime", 0));
-                jsvObjectSetChildAndUnLock(timeout, "pin", jsvNewFromPin(pin));
-                // Add to timer array
-                jsiTimerAdd(timeout);
-                // Add to our watch
-                jsvObjectSetChild(watchPtr, "timeout", timeout); // no unlock
-              }
-            }
-            jsvUnLock(timeout);
-          }
-
-          // If we want to execute this watch right now...
-          if (executeNow) {
-            JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(eventTime)/1000);
-            if (jsiShouldExecuteWatch(watchPtr, pinIsHigh)) { // edge triggering
-              JsVar *watchCallback = jsvObjectGetChild(watchPtr, "callback", 0);
-              bool watchRecurring = jsvGetBoolAndUnLock(jsvObjectGetChild(watchPtr,  "recur", 0));
-              JsVar *data = jsvNewObject();
-              if (data) {
-                jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChild(watchPtr, "lastTime", 0));
-                // set both data.time, and watch.lastTime in one go
-                jsvObjectSetChild(data, "time", timePtr); // no unlock
-                jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(pin));
-                jsvObjectSetChildAndUnLock(data, "state", jsvNewFromBool(pinIsHigh));
-              }
-              if (!jsiExecuteEventCallback(0, watchCallback, 1, &data) && watchRecurring) {
-                jsError("Ctrl-C while processing watch - removing it.");
-                jsErrorFlags |= JSERR_CALLBACK;
-                watchRecurring = false;
-              }
-              jsvUnLock(data);
-              if (!watchRecurring) {
-                // free all
-                jsvObjectIteratorRemoveAndGotoNext(&it, watchArrayPtr);
-                hasDeletedWatch = true;
-                if (!jsiIsWatchingPin(pin))
-                  jshPinWatch(pin, false);
-              }
-              jsvUnLock(watchCallback);
-            }
-            jsvObjectSetChildAndUnLock(watchPtr, "lastTime", timePtr);
-          }
-        }
-
-        jsvUnLock(watchPtr);
-        if (!hasDeletedWatch)
-          jsvObjectIteratorNext(&it);
-      }
-      jsvObjectIteratorFree(&it);
-      jsvUnLock(watchArrayPtr);
+      jsiHandleIOEventForWatches(&event);
     }
   }
 
@@ -1811,7 +1979,6 @@ void jsiIdle() {
   }
 
   // Check timers
-  JsSysTime minTimeUntilNext = JSSYSTIME_MAX;
   JsSysTime time = jshGetSystemTime();
   JsSysTime timePassed = time - jsiLastIdleTime;
   jsiLastIdleTime = time;
@@ -1821,6 +1988,9 @@ void jsiIdle() {
   if (oldTimeSinceCtrlC > jsiTimeSinceCtrlC)
     jsiTimeSinceCtrlC = 0xFFFFFFFF;
 
+  // Fire any debounced watches
+  JsSysTime minTimeUntilNext = jsiCheckWatchDebounce(time, &wasBusy);
+
   jsiStatus = jsiStatus & ~JSIS_TIMERS_CHANGED;
   JsVar *timerArrayPtr = jsvLock(timerArray);
   JsvObjectIterator it;
@@ -1836,67 +2006,18 @@ void jsiIdle() {
       jsiSetBusy(BUSY_INTERACTIVE, true);
       wasBusy = true;
       JsVar *timerCallback = jsvObjectGetChild(timerPtr, "callback", 0);
-      JsVar *watchPtr = jsvObjectGetChild(timerPtr, "watch", 0); // for debounce - may be undefined
-      bool exec = true;
-      JsVar *data = 0;
-      if (watchPtr) {
-        data = jsvNewObject();
-        // if we were from a watch then we were delayed by the debounce time...
-        if (data) {
-          JsVarInt delay = jsvGetIntegerAndUnLock(jsvObjectGetChild(watchPtr, "debounce", 0));
-          // Create the 'time' variable that will be passed to the user
-          JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(jsiLastIdleTime+timeUntilNext-delay)/1000);
-          // if it was a watch, set the last state up
-          bool state = jsvGetBoolAndUnLock(jsvObjectSetChild(data, "state", jsvObjectGetChild(watchPtr, "state", 0)));
-          exec = jsiShouldExecuteWatch(watchPtr, state);
-          // set up the lastTime variable of data to what was in the watch
-          jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChild(watchPtr, "lastTime", 0));
-          // set up the watches lastTime to this one
-          jsvObjectSetChild(watchPtr, "lastTime", timePtr); // don't unlock
-          jsvObjectSetChildAndUnLock(data, "time", timePtr);
-        }
-      }
       JsVar *interval = jsvObjectGetChild(timerPtr, "interval", 0);
-      if (exec) {
-        bool execResult;
-        if (data) {
-          execResult = jsiExecuteEventCallback(0, timerCallback, 1, &data);
-        } else {
-          JsVar *argsArray = jsvObjectGetChild(timerPtr, "args", 0);
-          execResult = jsiExecuteEventCallbackArgsArray(0, timerCallback, argsArray);
-          jsvUnLock(argsArray);
-        }
-        if (!execResult && interval) {
-          jsError("Ctrl-C while processing interval - removing it.");
-          jsErrorFlags |= JSERR_CALLBACK;
-          // by setting interval to 0, we now think we've for a Timeout,
-          // which will get removed.
-          jsvUnLock(interval);
-          interval = 0;
-        }
+      JsVar *argsArray = jsvObjectGetChild(timerPtr, "args", 0);
+      bool execResult = jsiExecuteEventCallbackArgsArray(0, timerCallback, argsArray);
+      jsvUnLock(argsArray);
+      if (!execResult && interval) {
+        jsError("Ctrl-C while processing interval - removing it.");
+        jsErrorFlags |= JSERR_CALLBACK;
+        // by setting interval to 0, we now think we've for a Timeout,
+        // which will get removed.
+        jsvUnLock(interval);
+        interval = 0;
       }
-      jsvUnLock(data);
-      if (watchPtr) { // if we had a watch pointer, be sure to remove us from it
-        jsvObjectSetChild(watchPtr, "timeout", 0);
-        // Deal with non-recurring watches
-        if (exec) {
-          bool watchRecurring = jsvGetBoolAndUnLock(jsvObjectGetChild(watchPtr,  "recur", 0));
-          if (!watchRecurring) {
-            JsVar *watchArrayPtr = jsvLock(watchArray);
-            JsVar *watchNamePtr = jsvGetArrayIndexOf(watchArrayPtr, watchPtr, true);
-            if (watchNamePtr) {
-              jsvRemoveChild(watchArrayPtr, watchNamePtr);
-              jsvUnLock(watchNamePtr);
-            }
-            jsvUnLock(watchArrayPtr);
-            Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChild(watchPtr, "pin", 0));
-            if (!jsiIsWatchingPin(pin))
-              jshPinWatch(pin, false);
-          }
-        }
-        jsvUnLock(watchPtr);
-      }
-
       if (interval) {
         timeUntilNext = timeUntilNext + jsvGetLongIntegerAndUnLock(interval);
       } else {
@@ -2000,6 +2121,12 @@ void jsiIdle() {
     jsiSetBusy(BUSY_INTERACTIVE, false);
   }
 
+  // Tell any `E.on('lowMemory'` handlers if we're running out of memory
+  jsiCheckLowMemory();
+
+  // Send anything that was queued because a transmit buffer was full (see JSH_TX_OVERFLOW_QUEUE)
+  if (jshTransmitIdle()) loopsIdling = 0; // don't sleep while we still have data to send
+
   // Go to sleep!
   if (loopsIdling>1 && // once around the idle loop without having done any work already (just in case)
 #ifdef USB
@@ -41,6 +41,12 @@ bool jsiFreeMoreMemory();
 
 bool jsiHasTimers(); // are there timers still left to run?
 bool jsiIsWatchingPin(Pin pin); // are there any watches for the given pin?
+/// Add a watch object (with pin/edge/recur/debounce set) to the native watch table. Returns false if out of memory
+bool jsiWatchAdd(JsVar *watchPtr);
+/// Remove a watch object from the native watch table (it must still be removed from watchArray)
+void jsiWatchRemove(JsVar *watchPtr);
+/// Remove all watches from the native watch table
+void jsiWatchRemoveAll();
 
 /// Queue a function, string, or array (of funcs/strings) to be executed next time around the idle loop
 void jsiQueueEvents(JsVar *object, JsVar *callback, JsVar **args, int argCount);
@@ -122,6 +128,15 @@ void jsiSetSleep(JsiSleepType isSleep);
 #define USART_BAUDRATE_NAME "_baudrate"
 #define DEVICE_OPTIONS_NAME "_options"
 #define INIT_CALLBACK_NAME JS_EVENT_PREFIX"init" ///< Callback for `E.on('init'`
+#define LOWMEMORY_CALLBACK_NAME JS_EVENT_PREFIX"lowMemory" ///< Callback for `E.on('lowMemory'`
+
+#define JSI_LOW_MEMORY_LEVELS 4 ///< How many levels of `E.on('lowMemory'` there can be
+#define JSI_LOW_MEMORY_THRESHOLDS_DEFAULT { 10, 3, 0, 0 } ///< Default % free memory for each `E.on('lowMemory'` level
+#define JSI_LOW_MEMORY_HYSTERESIS 2 ///< % free memory above a threshold needed before that `E.on('lowMemory'` level can fire again
+#define JSI_LOW_MEMORY_GC_INTERVAL 1000 ///< Minimum time (in ms) between the garbage collections done to check for `E.on('lowMemory'`
+
+/// Set the percentages of free memory at which `E.on('lowMemory'` levels are reached. 0 = use defaults
+void jsiSetLowMemoryThresholds(unsigned char *thresholds);
 
 typedef enum {
   JSIS_NONE,
@@ -12,6 +12,7 @@
  * ----------------------------------------------------------------------------
  */
 #include "jslex.h"
+#include "jsparse.h" // for execInfo.hiddenRoot
 
 JsLex *lex;
 
@@ -811,27 +812,142 @@ JsVar *jslNewFromLexer(JslCharPos *charFrom, size_t charTo) {
   return var;
 }
 
-/// Return the line number at the current character position (this isn't fast as it searches the string)
+#ifndef SAVE_ON_FLASH
+/* Sources of at least JSL_LINE_INDEX_MIN_LENGTH characters get an index of
+ * where each of their lines starts the first time we need a line number from
+ * them, so lines can be found with a binary search rather than by scanning
+ * from the start of the source. Each index is a flat string of uint32s, kept
+ * in a small cache in hiddenRoot. Entries are named by the source's ref and
+ * contain the source itself ('src') and the index ('idx'). The cache is
+ * emptied on reset or if memory gets low (see jspCodeCacheFlush) */
+static JsVar *jslGetLineIndex(JsVar *source) {
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, JSL_LINE_INDEX_CACHE_NAME, JSV_OBJECT);
+  if (!cache) return 0;
+  JsVarInt key = (JsVarInt)jsvGetRef(source);
+  JsVar *index = 0;
+  JsVarRef childref = jsvGetFirstChild(cache);
+  while (childref && !index) {
+    JsVar *child = jsvGetAddressOfBorrowed(childref);
+    if (child->varData.integer == key) {
+      JsVar *entry = jsvSkipName(child);
+      JsVar *src = jsvObjectGetChild(entry, "src", 0);
+      if (src == source) index = jsvObjectGetChild(entry, "idx", 0);
+      jsvUnLock2(src, entry);
+    }
+    childref = jsvGetNextSibling(child);
+  }
+  if (!index) {
+    // count lines, then fill in where each one starts
+    uint32_t lines = 1;
+    JsvStringIterator it;
+    jsvStringIteratorNew(&it, source, 0);
+    while (jsvStringIteratorHasChar(&it)) {
+      if (jsvStringIteratorGetChar(&it)=='\n') lines++;
+      jsvStringIteratorNext(&it);
+    }
+    jsvStringIteratorFree(&it);
+    index = jsvNewFlatStringOfLength((unsigned int)(lines*sizeof(uint32_t)));
+    JsVar *entry = index ? jsvNewObject() : 0;
+    if (entry) {
+      char *starts = jsvGetFlatStringPointer(index);
+      uint32_t line = 0, pos = 0;
+      memcpy(&starts[0], &pos, sizeof(uint32_t));
+      jsvStringIteratorNew(&it, source, 0);
+      while (jsvStringIteratorHasChar(&it)) {
+        pos++;
+        if (jsvStringIteratorGetChar(&it)=='\n')
+          memcpy(&starts[(++line)*sizeof(uint32_t)], &pos, sizeof(uint32_t));
+        jsvStringIteratorNext(&it);
+      }
+      jsvStringIteratorFree(&it);
+      jsvObjectSetChild(entry, "src", source);
+      jsvObjectSetChild(entry, "idx", index);
+      // Throw out the oldest entry if we're full
+      if (jsvGetChildren(cache) >= JSL_LINE_INDEX_CACHE_SIZE) {
+        JsVar *oldest = jsvLock(jsvGetFirstChild(cache));
+        jsvRemoveChild(cache, oldest);
+        jsvUnLock(oldest);
+      }
+      JsVar *name = jsvMakeIntoVariableName(jsvNewFromInteger(key), entry);
+      if (name) {
+        jsvAddName(cache, name);
+        jsvUnLock(name);
+      }
+      jsvUnLock(entry);
+    } else {
+      jsvUnLock(index); // out of memory - just scan the source instead
+      index = 0;
+    }
+  }
+  jsvUnLock(cache);
+  return index;
+}
+#endif
+
+/** Get the 1-based line and column of character 'pos' in 'source', as well as
+ * the position of the start of that line and how many characters are on it */
+static void jslGetLineInfo(JsVar *source, size_t pos, size_t *line, size_t *col, size_t *lineStart, size_t *lineLength) {
+#ifndef SAVE_ON_FLASH
+  size_t length = jsvGetStringLength(source);
+  JsVar *index = (length >= JSL_LINE_INDEX_MIN_LENGTH) ? jslGetLineIndex(source) : 0;
+  if (index) {
+    const char *starts = jsvGetFlatStringPointer(index);
+    size_t lines = jsvGetCharactersInVar(index) / sizeof(uint32_t);
+    // find the last line that starts at or before pos
+    size_t lo = 0, hi = lines;
+    while (hi-lo > 1) {
+      size_t mid = (lo+hi)/2;
+      uint32_t start;
+      memcpy(&start, &starts[mid*sizeof(uint32_t)], sizeof(uint32_t));
+      if (start <= pos) lo = mid;
+      else hi = mid;
+    }
+    uint32_t start, nextStart;
+    memcpy(&start, &starts[lo*sizeof(uint32_t)], sizeof(uint32_t));
+    if (lo+1 < lines) {
+      memcpy(&nextStart, &starts[(lo+1)*sizeof(uint32_t)], sizeof(uint32_t));
+      nextStart--; // don't count the newline
+    } else
+      nextStart = (uint32_t)length;
+    jsvUnLock(index);
+    *line = lo+1;
+    *col = pos+1-start;
+    *lineStart = start;
+    *lineLength = nextStart-start;
+    return;
+  }
+#endif
+  jsvGetLineAndCol(source, pos, line, col);
+  *lineStart = jsvGetIndexFromLineAndCol(source, *line, 1);
+  *lineLength = jsvGetCharsOnLine(source, *line);
+}
+
+/// Return the line number at the current character position
 unsigned int jslGetLineNumber() {
-  size_t line;
-  size_t col;
-  jsvGetLineAndCol(lex->sourceVar, jsvStringIteratorGetIndex(&lex->tokenStart.it)-1, &line, &col);
+  size_t line, col, lineStart, lineLength;
+  jslGetLineInfo(lex->sourceVar, jsvStringIteratorGetIndex(&lex->tokenStart.it)-1, &line, &col, &lineStart, &lineLength);
   return (unsigned int)line;
 }
 
 void jslPrintPosition(vcbprintf_callback user_callback, void *user_data, size_t tokenPos) {
-  size_t line,col;
-  jsvGetLineAndCol(lex->sourceVar, tokenPos, &line, &col);
-  if (lex->lineNumberOffset)
-    line += (size_t)lex->lineNumberOffset - 1;
+  jslPrintSourcePosition(user_callback, user_data, lex->sourceVar, lex->lineNumberOffset, tokenPos);
+}
+
+void jslPrintSourcePosition(vcbprintf_callback user_callback, void *user_data, JsVar *source, uint16_t lineNumberOffset, size_t tokenPos) {
+  size_t line, col, lineStart, lineLength;
+  jslGetLineInfo(source, tokenPos, &line, &col, &lineStart, &lineLength);
+  if (lineNumberOffset)
+    line += (size_t)lineNumberOffset - 1;
   cbprintf(user_callback, user_data, "line %d col %d\n", line, col);
 }
 
 void jslPrintTokenLineMarker(vcbprintf_callback user_callback, void *user_data, size_t tokenPos, char *prefix) {
-  size_t line = 1,col = 1;
-  jsvGetLineAndCol(lex->sourceVar, tokenPos, &line, &col);
-  size_t startOfLine = jsvGetIndexFromLineAndCol(lex->sourceVar, line, 1);
-  size_t lineLength = jsvGetCharsOnLine(lex->sourceVar, line);
+  jslPrintSourceLineMarker(user_callback, user_data, lex->sourceVar, tokenPos, prefix);
+}
+
+void jslPrintSourceLineMarker(vcbprintf_callback user_callback, void *user_data, JsVar *source, size_t tokenPos, char *prefix) {
+  size_t line = 1, col = 1, startOfLine = 0, lineLength = 0;
+  jslGetLineInfo(source, tokenPos, &line, &col, &startOfLine, &lineLength);
   size_t prefixLength = 0;
 
   if (prefix) {
@@ -850,7 +966,7 @@ void jslPrintTokenLineMarker(vcbprintf_callback user_callback, void *user_data,
   // print the string until the end of the line, or 60 chars (whichever is lesS)
   int chars = 0;
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, lex->sourceVar, startOfLine);
+  jsvStringIteratorNew(&it, source, startOfLine);
   while (jsvStringIteratorHasChar(&it) && chars<60) {
     char ch = jsvStringIteratorGetChar(&it);
     if (ch == '\n') break;
@@ -145,14 +145,22 @@ void jslGetNextToken(); ///< Get the text token from our text string
 
 JsVar *jslNewFromLexer(JslCharPos *charFrom, size_t charTo); // Create a new STRING from part of the lexer
 
-/// Return the line number at the current character position (this isn't fast as it searches the string)
+#define JSL_LINE_INDEX_CACHE_NAME "lnIdx" ///< Name of the cache of line start indexes for sources in hiddenRoot
+#define JSL_LINE_INDEX_CACHE_SIZE 4 ///< Maximum number of sources with line start indexes
+#define JSL_LINE_INDEX_MIN_LENGTH 256 ///< Sources shorter than this are just scanned for line numbers
+
+/// Return the line number at the current character position (sources over JSL_LINE_INDEX_MIN_LENGTH get a cached line index)
 unsigned int jslGetLineNumber();
 
 /// Print position in the form 'line X col Y'
 void jslPrintPosition(vcbprintf_callback user_callback, void *user_data, size_t tokenPos);
+/// Like jslPrintPosition, but for a position in the given source (with the given line number offset) rather than the lexer's
+void jslPrintSourcePosition(vcbprintf_callback user_callback, void *user_data, JsVar *source, uint16_t lineNumberOffset, size_t tokenPos);
 
 /** Print the line of source code at `tokenPos`, prefixed with the string 'prefix' (0=no string).
  * Then, underneath it, print a '^' marker at the column tokenPos was at  */
 void jslPrintTokenLineMarker(vcbprintf_callback user_callback, void *user_data, size_t tokenPos, char *prefix);
+/// Like jslPrintTokenLineMarker, but for a position in the given source rather than the lexer's
+void jslPrintSourceLineMarker(vcbprintf_callback user_callback, void *user_data, JsVar *source, size_t tokenPos, char *prefix);
 
 #endif /* JSLEX_H_ */
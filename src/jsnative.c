@@ -41,7 +41,19 @@
   #endif
 #endif
 
-/** Call a function with the given argument specifiers */
+JsVar *jsnNewArgumentArray(JsVar **paramData, int paramCount, int first) {
+  JsVar *argsArray = jsvNewEmptyArray();
+  if (argsArray) {
+    // push everything into the array
+    int i;
+    for (i=first;i<paramCount;i++)
+      jsvArrayPush(argsArray, paramData[i]);
+  }
+  return argsArray;
+}
+
+/** Call a function with the given argument specifiers. Builtins normally go through
+ * jswCallFunction's generated thunks instead - this is the fallback for any other signature */
 JsVar *jsnCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar *thisParam, JsVar **paramData, int paramCount) {
   JsnArgumentType returnType = (JsnArgumentType)(argumentSpecifier&JSWAT_MASK);
   JsVar *argsArray = 0; // if JSWAT_ARGUMENT_ARRAY is ever used (note it'll only ever be used once)
@@ -89,15 +101,8 @@ JsVar *jsnCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar
       break;
     }
     case JSWAT_ARGUMENT_ARRAY: { // a JsVar array containing all subsequent arguments
-      argsArray = jsvNewEmptyArray();
-      if (argsArray) {
-        // push everything into the array
-        while (paramNumber<=paramCount) {
-          jsvArrayPush(argsArray, param);
-          param = (paramNumber<paramCount) ? paramData[paramNumber] : 0;
-          paramNumber++;
-        }
-      }
+      argsArray = jsnNewArgumentArray(paramData, paramCount, paramNumber-1);
+      paramNumber = paramCount+1;
       // push the array
       argData[argCount++] = (size_t)argsArray;
       break;
@@ -38,6 +38,14 @@
  */
 JsVar *jsnCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar *thisParam, JsVar **paramData, int paramCount) ;
 
+/** Get argument 'n' of a native call, or 0 if it wasn't supplied */
+static ALWAYS_INLINE JsVar *jsnGetArg(JsVar **paramData, int paramCount, int n) {
+  return (n<paramCount) ? paramData[n] : 0;
+}
+
+/** Create the array passed for a JSWAT_ARGUMENT_ARRAY argument - everything from argument 'first' onwards */
+JsVar *jsnNewArgumentArray(JsVar **paramData, int paramCount, int first);
+
 /** Perform sanity tests to ensure that  jsnCallFunction is working as expected */
 void jsnSanityTest();
 
@@ -19,6 +19,7 @@
 #include "jswrap_functions.h" // insane check for eval in jspeFunctionCall
 #include "jswrap_json.h" // for jsfPrintJSON
 #include "jswrap_espruino.h" // for jswrap_espruino_memoryArea
+#include "jswrap_map.h" // for switch statement jump tables
 
 /* Info about execution when Parsing - this saves passing it on the stack
  * for each call */
@@ -32,6 +33,8 @@ void jspeBlock();
 void jspeBlockNoBrackets();
 JsVar *jspeStatement();
 JsVar *jspeFactor();
+JsVar *jspeFactorObject();
+JsVar *jspeFactorArray();
 void jspEnsureIsPrototype(JsVar *instanceOf, JsVar *prototypeName);
 // ----------------------------------------------- Utils
 #define JSP_MATCH_WITH_CLEANUP_AND_RETURN(TOKEN, CLEANUP_CODE, RETURN_VAL) { if (!jslMatch((TOKEN))) { CLEANUP_CODE; return RETURN_VAL; } }
@@ -261,13 +264,38 @@ void jspSetNoExecute() {
   execInfo.execute = (execInfo.execute & (JsExecFlags)(int)~EXEC_RUN_MASK) | EXEC_NO;
 }
 
-void jspAppendStackTrace(JsVar *stackTrace) {
-  JsvStringIterator it;
-  jsvStringIteratorNew(&it, stackTrace, 0);
-  jsvStringIteratorGotoEnd(&it);
-  jslPrintPosition((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it, lex->tokenLastStart);
-  jslPrintTokenLineMarker((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it, lex->tokenLastStart, 0);
-  jsvStringIteratorFree(&it);
+/* The stack trace is kept in hiddenRoot as an array of frames, and only
+ * turned into text if something asks for it with jspGetStackTrace - so
+ * exceptions that get caught never need the source searching for line
+ * numbers. Each frame is an array of:
+ *
+ *   [JspStackTraceKind, position, lineNumberOffset, source, functionName]
+ *
+ * where source is undefined if we were called from the system rather than
+ * from JS code, and functionName is undefined if we didn't have one. */
+typedef enum {
+  JSP_STACKTRACE_EXCEPTION, ///< ' at ' - where an exception was thrown
+  JSP_STACKTRACE_AT,        ///< 'at ' - an error in a block
+  JSP_STACKTRACE_CALLED,    ///< 'in function called from ' - an error in a function call
+} JspStackTraceKind;
+
+/// Add a frame for the lexer's current position to the stack trace
+static void jspAppendStackTrace(JspStackTraceKind kind, JsVar *functionName) {
+  JsVar *stackTrace = jsvObjectGetChild(execInfo.hiddenRoot, JSPARSE_STACKTRACE_VAR, JSV_ARRAY);
+  if (!stackTrace) return;
+  JsVar *frame = jsvNewEmptyArray();
+  if (frame) {
+    jsvArrayPushAndUnLock(frame, jsvNewFromInteger(kind));
+    jsvArrayPushAndUnLock(frame, jsvNewFromInteger(lex ? (JsVarInt)lex->tokenLastStart : 0));
+    jsvArrayPushAndUnLock(frame, jsvNewFromInteger(lex ? lex->lineNumberOffset : 0));
+    jsvArrayPush(frame, lex ? lex->sourceVar : 0);
+    if (jsvIsName(functionName)) // a variable name, so copy it as a normal string
+      jsvArrayPushAndUnLock(frame, jsvCopyNameOnly(functionName, false, false));
+    else if (jsvIsString(functionName))
+      jsvArrayPush(frame, functionName);
+    jsvArrayPushAndUnLock(stackTrace, frame);
+  }
+  jsvUnLock(stackTrace);
 }
 
 /// We had an exception (argument is the exception's value)
@@ -282,14 +310,9 @@ void jspSetException(JsVar *value) {
   execInfo.execute = execInfo.execute | EXEC_EXCEPTION;
   // Try and do a stack trace
   if (lex) {
-    JsVar *stackTrace = jsvObjectGetChild(execInfo.hiddenRoot, JSPARSE_STACKTRACE_VAR, JSV_STRING_0);
-    if (stackTrace) {
-      jsvAppendPrintf(stackTrace, " at ");
-      jspAppendStackTrace(stackTrace);
-      jsvUnLock(stackTrace);
-      // stop us from printing the trace in the same block
-      execInfo.execute = execInfo.execute | EXEC_ERROR_LINE_REPORTED;
-    }
+    jspAppendStackTrace(JSP_STACKTRACE_EXCEPTION, 0);
+    // stop us from printing the trace in the same block
+    execInfo.execute = execInfo.execute | EXEC_ERROR_LINE_REPORTED;
   }
 
 }
@@ -309,13 +332,45 @@ JsVar *jspGetException() {
 /** Return a stack trace string if there was one (and clear it) */
 JsVar *jspGetStackTrace() {
   JsVar *stackTraceName = jsvFindChildFromString(execInfo.hiddenRoot, JSPARSE_STACKTRACE_VAR, false);
-  if (stackTraceName) {
-    JsVar *stackTrace = jsvSkipName(stackTraceName);
-    jsvRemoveChild(execInfo.hiddenRoot, stackTraceName);
-    jsvUnLock(stackTraceName);
-    return stackTrace;
+  if (!stackTraceName) return 0;
+  JsVar *frames = jsvSkipName(stackTraceName);
+  jsvRemoveChild(execInfo.hiddenRoot, stackTraceName);
+  jsvUnLock(stackTraceName);
+  JsVar *stackTrace = jsvNewFromEmptyString();
+  if (!stackTrace) {
+    jsvUnLock(frames);
+    return 0;
   }
-  return 0;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, stackTrace, 0);
+  JsvObjectIterator fit;
+  jsvObjectIteratorNew(&fit, frames);
+  while (jsvObjectIteratorHasValue(&fit)) {
+    JsVar *frame = jsvObjectIteratorGetValue(&fit);
+    JspStackTraceKind kind = (JspStackTraceKind)jsvGetIntegerAndUnLock(jsvGetArrayItem(frame, 0));
+    size_t pos = (size_t)jsvGetIntegerAndUnLock(jsvGetArrayItem(frame, 1));
+    uint16_t lineNumberOffset = (uint16_t)jsvGetIntegerAndUnLock(jsvGetArrayItem(frame, 2));
+    JsVar *source = jsvGetArrayItem(frame, 3);
+    JsVar *functionName = jsvGetArrayItem(frame, 4);
+    jsvUnLock(frame);
+    if (kind==JSP_STACKTRACE_CALLED)
+      cbprintf((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it,
+          functionName ? "in function %q called from " : "in function called from ", functionName);
+    else
+      cbprintf((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it,
+          kind==JSP_STACKTRACE_EXCEPTION ? " at " : "at ");
+    if (source) {
+      jslPrintSourcePosition((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it, source, lineNumberOffset, pos);
+      jslPrintSourceLineMarker((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it, source, pos, 0);
+    } else
+      cbprintf((vcbprintf_callback)jsvStringIteratorPrintfCallback, &it, "system\n");
+    jsvUnLock2(source, functionName);
+    jsvObjectIteratorNext(&fit);
+  }
+  jsvObjectIteratorFree(&fit);
+  jsvStringIteratorFree(&it);
+  jsvUnLock(frames);
+  return stackTrace;
 }
 
 // ----------------------------------------------
@@ -446,6 +501,115 @@ NO_INLINE bool jspeParseFunctionCallBrackets() {
   return 0;
 }
 
+/** Call a native function. 'function' is the function variable (used for
+ * bound arguments and 'this') but may be 0 when calling a built-in method that
+ * we found directly in the symbol tables - in which case nativePtr and argTypes
+ * are all we need. If isParsing, the lexer must already be past the opening
+ * bracket. */
+static NO_INLINE JsVar *jspeNativeFunctionCall(JsVar *function, void *nativePtr, JsnArgumentType argTypes, JsVar *thisArg, bool isParsing, int argCount, JsVar **argPtr) {
+  JsVar *returnVar = 0;
+  JsVar *thisVar = jsvLockAgainSafe(thisArg);
+  unsigned int argPtrSize = 0;
+  int boundArgs = 0;
+  if (function) {
+    /* Count 'bound' parameters and look for a bound 'this'. Nothing here
+     * can allocate, so we borrow the children rather than locking them */
+    JsVarRef boundThisRef = 0;
+    JsVarRef childRef = jsvGetFirstChild(function);
+    while (childRef) {
+      JsVar *child = jsvGetAddressOfBorrowed(childRef);
+      if (!jsvIsFunctionParameter(child)) break;
+      boundArgs++;
+      childRef = jsvGetNextSibling(child);
+    }
+    // check if 'this' was defined
+    while (childRef) {
+      JsVar *child = jsvGetAddressOfBorrowed(childRef);
+      if (jsvIsStringEqual(child, JSPARSE_FUNCTION_THIS_NAME)) {
+        boundThisRef = childRef;
+        break;
+      }
+      childRef = jsvGetNextSibling(child);
+    }
+    if (boundThisRef) {
+      jsvUnLock(thisVar);
+      thisVar = jsvSkipNameAndUnLock(jsvLock(boundThisRef));
+    }
+    // Add 'bound' parameters if there were any - building the argument list just once
+    if (boundArgs) {
+      argPtrSize = (unsigned int)(boundArgs + argCount);
+      if (isParsing && argPtrSize<16) argPtrSize = 16;
+      JsVar **newArgPtr = (JsVar**)alloca(sizeof(JsVar*)*argPtrSize);
+      int i = 0;
+      childRef = jsvGetFirstChild(function);
+      while (i<boundArgs) {
+        JsVar *param = jsvLock(childRef);
+        assert(jsvIsFunctionParameter(param));
+        newArgPtr[i++] = jsvSkipName(param);
+        childRef = jsvGetNextSibling(param);
+        jsvUnLock(param);
+      }
+      if (argCount) memcpy(&newArgPtr[boundArgs], argPtr, (unsigned)argCount*sizeof(JsVar*));
+      argPtr = newArgPtr;
+      argCount += boundArgs;
+    }
+  }
+
+  // Now, if we're parsing add the rest of the arguments
+  int allocatedArgCount = boundArgs;
+  if (isParsing) {
+    while (!JSP_SHOULDNT_PARSE && lex->tk!=')' && lex->tk!=LEX_EOF) {
+      if ((unsigned)argCount>=argPtrSize) {
+        // allocate more space on stack
+        unsigned int newArgPtrSize = argPtrSize?argPtrSize*4:16;
+        JsVar **newArgPtr = (JsVar**)alloca(sizeof(JsVar*)*newArgPtrSize);
+        memcpy(newArgPtr, argPtr, (unsigned)argCount*sizeof(JsVar*));
+        argPtr = newArgPtr;
+        argPtrSize = newArgPtrSize;
+      }
+      argPtr[argCount++] = jsvSkipNameAndUnLock(jspeAssignmentExpression());
+      if (lex->tk!=')') JSP_MATCH_WITH_CLEANUP_AND_RETURN(',',jsvUnLockMany((unsigned)argCount, argPtr);jsvUnLock(thisVar);, 0);
+    }
+
+    JSP_MATCH_WITH_CLEANUP_AND_RETURN(')',jsvUnLockMany((unsigned)argCount, argPtr);jsvUnLock(thisVar);, 0);
+    allocatedArgCount = argCount;
+  }
+
+  JsVar *oldThisVar = execInfo.thisVar;
+  if (thisVar)
+    execInfo.thisVar = jsvRef(thisVar);
+  else {
+    if (nativePtr==jswrap_eval) { // eval gets to use the current scope
+      /* Note: proper JS has some utterly insane code that depends on whether
+       * eval is an lvalue or not:
+       *
+       * http://stackoverflow.com/questions/9107240/1-evalthis-vs-evalthis-in-javascript
+       *
+       * Doing this in Espruino is quite an upheaval for that one
+       * slightly insane case - so it's not implemented. */
+      if (execInfo.thisVar) execInfo.thisVar = jsvRef(execInfo.thisVar);
+    } else {
+      execInfo.thisVar = jsvRef(execInfo.root); // 'this' should always default to root
+    }
+  }
+
+  if (nativePtr) {
+    returnVar = jswCallFunction(nativePtr, argTypes, thisVar, argPtr, argCount);
+  } else {
+    assert(0); // in case something went horribly wrong
+    returnVar = 0;
+  }
+
+  // unlock values if we locked them
+  jsvUnLockMany((unsigned)allocatedArgCount, argPtr);
+
+  /* Return to old 'this' var. No need to unlock as we never locked before */
+  if (execInfo.thisVar) jsvUnRef(execInfo.thisVar);
+  execInfo.thisVar = oldThisVar;
+  jsvUnLock(thisVar);
+  return returnVar;
+}
+
 /** Handle a function call (assumes we've parsed the function name and we're
  * on the start bracket). 'thisArg' is the value of the 'this' variable when the
  * function is executed (it's usually the parent object)
@@ -488,104 +652,7 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
      *   b) we parse our own args, which is possibly better
      */
     if (jsvIsNative(function)) { // ------------------------------------- NATIVE
-
-      unsigned int argPtrSize = 0;
-      int boundArgs = 0;
-      // Add 'bound' parameters if there were any
-      JsvObjectIterator it;
-      jsvObjectIteratorNew(&it, function);
-      JsVar *param = jsvObjectIteratorGetKey(&it);
-      while (jsvIsFunctionParameter(param)) {
-        if ((unsigned)argCount>=argPtrSize) {
-          // allocate more space on stack if needed
-          unsigned int newArgPtrSize = argPtrSize?argPtrSize*4:16;
-          JsVar **newArgPtr = (JsVar**)alloca(sizeof(JsVar*)*newArgPtrSize);
-          memcpy(newArgPtr, argPtr, (unsigned)argCount*sizeof(JsVar*));
-          argPtr = newArgPtr;
-          argPtrSize = newArgPtrSize;
-        }
-        // if we already had arguments - shift them up...
-        int i;
-        for (i=argCount-1;i>=boundArgs;i--)
-          argPtr[i+1] = argPtr[i];
-        // add bound argument
-        argPtr[boundArgs] = jsvSkipName(param);
-        argCount++;
-        boundArgs++;
-        jsvUnLock(param);
-        jsvObjectIteratorNext(&it);
-        param = jsvObjectIteratorGetKey(&it);
-      }
-      // check if 'this' was defined
-      while (param) {
-        if (jsvIsStringEqual(param, JSPARSE_FUNCTION_THIS_NAME)) {
-          jsvUnLock(thisVar);
-          thisVar = jsvSkipName(param);
-          break;
-        }
-        jsvUnLock(param);
-        jsvObjectIteratorNext(&it);
-        param = jsvObjectIteratorGetKey(&it);
-      }
-      jsvUnLock(param);
-      jsvObjectIteratorFree(&it);
-
-      // Now, if we're parsing add the rest of the arguments
-      int allocatedArgCount = boundArgs;
-      if (isParsing) {
-        while (!JSP_SHOULDNT_PARSE && lex->tk!=')' && lex->tk!=LEX_EOF) {
-          if ((unsigned)argCount>=argPtrSize) {
-            // allocate more space on stack
-            unsigned int newArgPtrSize = argPtrSize?argPtrSize*4:16;
-            JsVar **newArgPtr = (JsVar**)alloca(sizeof(JsVar*)*newArgPtrSize);
-            memcpy(newArgPtr, argPtr, (unsigned)argCount*sizeof(JsVar*));
-            argPtr = newArgPtr;
-            argPtrSize = newArgPtrSize;
-          }
-          argPtr[argCount++] = jsvSkipNameAndUnLock(jspeAssignmentExpression());
-          if (lex->tk!=')') JSP_MATCH_WITH_CLEANUP_AND_RETURN(',',jsvUnLockMany((unsigned)argCount, argPtr);jsvUnLock(thisVar);, 0);
-        }
-
-        JSP_MATCH(')');
-        allocatedArgCount = argCount;
-      }
-
-      void *nativePtr = jsvGetNativeFunctionPtr(function);
-
-      JsVar *oldThisVar = execInfo.thisVar;
-      if (thisVar)
-        execInfo.thisVar = jsvRef(thisVar);
-      else {
-        if (nativePtr==jswrap_eval) { // eval gets to use the current scope
-          /* Note: proper JS has some utterly insane code that depends on whether
-           * eval is an lvalue or not:
-           *
-           * http://stackoverflow.com/questions/9107240/1-evalthis-vs-evalthis-in-javascript
-           *
-           * Doing this in Espruino is quite an upheaval for that one
-           * slightly insane case - so it's not implemented. */
-          if (execInfo.thisVar) execInfo.thisVar = jsvRef(execInfo.thisVar);
-        } else {
-          execInfo.thisVar = jsvRef(execInfo.root); // 'this' should always default to root
-        }
-      }
-
-
-
-      if (nativePtr) {
-        returnVar = jsnCallFunction(nativePtr, function->varData.native.argTypes, thisVar, argPtr, argCount);
-      } else {
-        assert(0); // in case something went horribly wrong
-        returnVar = 0;
-      }
-
-      // unlock values if we locked them
-      jsvUnLockMany((unsigned)allocatedArgCount, argPtr);
-
-      /* Return to old 'this' var. No need to unlock as we never locked before */
-      if (execInfo.thisVar) jsvUnRef(execInfo.thisVar);
-      execInfo.thisVar = oldThisVar;
-
+      returnVar = jspeNativeFunctionCall(function, jsvGetNativeFunctionPtr(function), (JsnArgumentType)function->varData.native.argTypes, thisVar, isParsing, argCount, argPtr);
     } else { // ----------------------------------------------------- NOT NATIVE
       // create a new symbol table entry for execution of this function
       // OPT: can we cache this function execution environment + param variables?
@@ -813,16 +880,7 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
 
             if (hasError) {
               execInfo.execute |= hasError; // propogate error
-              JsVar *stackTrace = jsvObjectGetChild(execInfo.hiddenRoot, JSPARSE_STACKTRACE_VAR, JSV_STRING_0);
-              if (stackTrace) {
-                jsvAppendPrintf(stackTrace, jsvIsString(functionName)?"in function %q called from ":
-                    "in function called from ", functionName);
-                if (lex) {
-                  jspAppendStackTrace(stackTrace);
-                } else
-                  jsvAppendPrintf(stackTrace, "system\n");
-                jsvUnLock(stackTrace);
-              }
+              jspAppendStackTrace(JSP_STACKTRACE_CALLED, functionName);
             }
           }
 
@@ -884,14 +942,30 @@ JsVar *jspGetNamedVariable(const char *tokenName) {
   return a;
 }
 
-/// Used by jspGetNamedField / jspGetVarNamedField
-static NO_INLINE JsVar *jspGetNamedFieldInParents(JsVar *object, const char* name, bool returnName) {
+/** Used by jspGetNamedField / jspGetVarNamedField. If 'method' is set and
+ * the field turns out to be a built-in method, no function is created for it -
+ * 0 is returned and 'method' is filled in instead (method->functionPtr is 0
+ * otherwise) */
+static NO_INLINE JsVar *jspGetNamedFieldInParents(JsVar *object, const char* name, bool returnName, JswBuiltInSymbol *method) {
   // Now look in prototypes
   JsVar * child = jspeiFindChildFromStringInParents(object, name);
 
   /* Check for builtins via separate function
    * This way we save on RAM for built-ins because everything comes out of program code */
   if (!child) {
+#ifndef SAVE_ON_FLASH
+    JswBuiltInSymbol symbol;
+    if (jswFindBuiltInSymbol(object, name, &symbol)) {
+      if ((symbol.functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY) {
+        // a getter - its value is the answer, even if that's undefined (so don't look again and run it twice)
+        child = jswCallFunction(symbol.functionPtr, symbol.functionSpec, object, 0, 0);
+      } else if (method) {
+        *method = symbol;
+        return 0;
+      } else
+        child = jswGetNativeFunction(&symbol);
+    } else if (jsvIsRoot(object))
+#endif
     child = jswFindBuiltInFunction(object, name);
   }
 
@@ -934,14 +1008,9 @@ static NO_INLINE JsVar *jspGetNamedFieldInParents(JsVar *object, const char* nam
   return child;
 }
 
-/** Get the named function/variable on the object - whether it's built in, or predefined.
- * If !returnName, returns the function/variable itself or undefined, but
- * if returnName, return a name (could be fake) referencing the parent.
- *
- * NOTE: ArrayBuffer/Strings are not handled here. We assume that if we're
- * passing a char* rather than a JsVar it's because we're looking up via
- * a symbol rather than a variable. To handle these use jspGetVarNamedField  */
-JsVar *jspGetNamedField(JsVar *object, const char* name, bool returnName) {
+/// see jspGetNamedField - 'method' is as for jspGetNamedFieldInParents, and may be 0
+static JsVar *jspGetNamedFieldOrMethod(JsVar *object, const char* name, bool returnName, JswBuiltInSymbol *method) {
+  if (method) method->functionPtr = 0;
 
   JsVar *child = 0;
   // if we're an object (or pretending to be one)
@@ -949,7 +1018,7 @@ JsVar *jspGetNamedField(JsVar *object, const char* name, bool returnName) {
     child = jsvFindChildFromString(object, name, false);
 
   if (!child) {
-    child = jspGetNamedFieldInParents(object, name, returnName);
+    child = jspGetNamedFieldInParents(object, name, returnName, method);
 
     // If not found and is the prototype, create it
     if (!child && jsvIsFunction(object) && strcmp(name, JSPARSE_PROTOTYPE_VAR)==0) {
@@ -963,6 +1032,17 @@ JsVar *jspGetNamedField(JsVar *object, const char* name, bool returnName) {
   else return jsvSkipNameAndUnLock(child);
 }
 
+/** Get the named function/variable on the object - whether it's built in, or predefined.
+ * If !returnName, returns the function/variable itself or undefined, but
+ * if returnName, return a name (could be fake) referencing the parent.
+ *
+ * NOTE: ArrayBuffer/Strings are not handled here. We assume that if we're
+ * passing a char* rather than a JsVar it's because we're looking up via
+ * a symbol rather than a variable. To handle these use jspGetVarNamedField  */
+JsVar *jspGetNamedField(JsVar *object, const char* name, bool returnName) {
+  return jspGetNamedFieldOrMethod(object, name, returnName, 0);
+}
+
 /// see jspGetNamedField - note that nameVar should have had jsvAsArrayIndex called on it first
 JsVar *jspGetVarNamedField(JsVar *object, JsVar *nameVar, bool returnName) {
 
@@ -989,7 +1069,7 @@ JsVar *jspGetVarNamedField(JsVar *object, JsVar *nameVar, bool returnName) {
       char name[JSLEX_MAX_TOKEN_LENGTH];
       jsvGetString(nameVar, name, JSLEX_MAX_TOKEN_LENGTH);
       // try and find it in parents
-      child = jspGetNamedFieldInParents(object, name, returnName);
+      child = jspGetNamedFieldInParents(object, name, returnName, 0);
 
       // If not found and is the prototype, create it
       if (!child && jsvIsFunction(object) && jsvIsStringEqual(nameVar, JSPARSE_PROTOTYPE_VAR)) {
@@ -1014,7 +1094,10 @@ JsVar *jspCallNamedFunction(JsVar *object, char* name, int argCount, JsVar **arg
   return r;
 }
 
-NO_INLINE JsVar *jspeFactorMember(JsVar *a, JsVar **parentResult) {
+/** Parse '.' and '[' member accesses after 'a'. If callMethods is set and a
+ * built-in method is called directly (eg. `arr.push(x)`), the call is made
+ * here without ever creating a function for the method. */
+NO_INLINE JsVar *jspeFactorMember(JsVar *a, JsVar **parentResult, bool callMethods) {
   /* The parent if we're executing a method call */
   JsVar *parent = 0;
 
@@ -1027,8 +1110,41 @@ NO_INLINE JsVar *jspeFactorMember(JsVar *a, JsVar **parentResult) {
 
         JsVar *aVar = jsvSkipName(a);
         JsVar *child = 0;
+#ifndef SAVE_ON_FLASH
+        JswBuiltInSymbol method;
+        method.functionPtr = 0;
+        if (aVar)
+          child = jspGetNamedFieldOrMethod(aVar, name, true, callMethods ? &method : 0);
+        if (method.functionPtr) {
+          char methodName[JSLEX_MAX_TOKEN_LENGTH];
+          strncpy(methodName, name, sizeof(methodName));
+          jslGetNextToken(lex); // skip over the method name
+          if (lex->tk=='(') {
+            // Call the method straight away
+            JsVar *r = 0;
+            if (jspCheckStackPosition()) {
+              JSP_ASSERT_MATCH('(');
+              r = jspeNativeFunctionCall(0, (void*)method.functionPtr, (JsnArgumentType)method.functionSpec, aVar, true, 0, 0);
+            }
+            jsvUnLock3(parent, a, aVar);
+            parent = 0;
+            a = r;
+            continue;
+          }
+          // We're not calling it, so we need a real function after all
+          JsVar *fn = jswGetNativeFunction(&method);
+          JsVar *nameVar = jsvNewFromString(methodName);
+          child = jsvCreateNewChild(aVar, nameVar, fn);
+          jsvUnLock2(nameVar, fn);
+          jsvUnLock2(parent, a);
+          parent = aVar;
+          a = child;
+          continue;
+        }
+#else
         if (aVar)
           child = jspGetNamedField(aVar, name, true);
+#endif
         if (!child) {
           if (jsvHasChildren(aVar)) {
             // if no child found, create a pointer to where it could be
@@ -1138,7 +1254,7 @@ NO_INLINE JsVar *jspeFactorFunctionCall() {
   }
 
   JsVar *parent = 0;
-  JsVar *a = jspeFactorMember(jspeFactor(), &parent);
+  JsVar *a = jspeFactorMember(jspeFactor(), &parent, !isConstructor);
 
   while ((lex->tk=='(' || (isConstructor && JSP_SHOULD_EXECUTE)) && !jspIsInterrupted()) {
     JsVar *funcName = a;
@@ -1156,7 +1272,7 @@ NO_INLINE JsVar *jspeFactorFunctionCall() {
 
     jsvUnLock3(funcName, func, parent);
     parent=0;
-    a = jspeFactorMember(a, &parent);
+    a = jspeFactorMember(a, &parent, true);
   }
 
   jsvUnLock(parent);
@@ -1164,8 +1280,309 @@ NO_INLINE JsVar *jspeFactorFunctionCall() {
 }
 
 
+/// Position in the source of the start of the current token, for use with jslSeekTo
+static ALWAYS_INLINE size_t jspeGetTokenStart() {
+  return jsvStringIteratorGetIndex(&lex->tokenStart.it)-1;
+}
+
+#ifndef SAVE_ON_FLASH
+/* Position caches are objects in hiddenRoot holding information about bits of
+ * code we have already parsed. Each entry is an object, named by the position
+ * of the code in the source, with a 'src' field referencing the source string
+ * itself (so the same position in different functions can't get mixed up).
+ * When a cache is full, the oldest entry gets thrown out. */
+static JsVar *jspeCacheFind(const char *cacheName, size_t pos) {
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, cacheName, 0);
+  if (!cache) return 0;
+  JsVar *entry = 0;
+  JsVarRef childref = jsvGetFirstChild(cache);
+  while (childref && !entry) {
+    JsVar *child = jsvGetAddressOfBorrowed(childref);
+    if (child->varData.integer == (JsVarInt)pos) {
+      JsVar *e = jsvSkipName(child);
+      JsVar *src = jsvObjectGetChild(e, "src", 0);
+      if (src == lex->sourceVar) entry = jsvLockAgain(e);
+      jsvUnLock2(src, e);
+    }
+    childref = jsvGetNextSibling(child);
+  }
+  jsvUnLock(cache);
+  return entry;
+}
+
+/// Add an entry for the code at 'pos' in the current source to a position cache
+static void jspeCacheAdd(const char *cacheName, int maxEntries, size_t pos, JsVar *entry) {
+  jsvObjectSetChild(entry, "src", lex->sourceVar);
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, cacheName, JSV_OBJECT);
+  if (!cache) return;
+  // Throw out the oldest entry if we're full
+  if (jsvGetChildren(cache) >= maxEntries) {
+    JsVar *oldest = jsvLock(jsvGetFirstChild(cache));
+    jsvRemoveChild(cache, oldest);
+    jsvUnLock(oldest);
+  }
+  JsVar *name = jsvMakeIntoVariableName(jsvNewFromInteger((JsVarInt)pos), entry);
+  if (name) {
+    jsvAddName(cache, name);
+    jsvUnLock(name);
+  }
+  jsvUnLock(cache);
+}
+
+/// Remove a position cache from hiddenRoot. Returns true if it had anything in it
+static bool jspeCacheFlush(const char *cacheName) {
+  JsVar *name = jsvFindChildFromString(execInfo.hiddenRoot, cacheName, false);
+  if (!name) return false;
+  JsVar *cache = jsvSkipName(name);
+  bool hadEntries = cache && jsvGetFirstChild(cache)!=0;
+  jsvRemoveChild(execInfo.hiddenRoot, name);
+  jsvUnLock2(cache, name);
+  return hadEntries;
+}
+
+bool jspCodeCacheFlush() {
+  bool freed = jspeCacheFlush(JSP_SWITCH_CACHE_NAME);
+  if (jspeCacheFlush(JSP_LITERAL_CACHE_NAME)) freed = true;
+  if (jspeCacheFlush(JSL_LINE_INDEX_CACHE_NAME)) freed = true;
+  if (jspeCacheFlush(JSW_NATIVE_FUNCTION_CACHE_NAME)) freed = true;
+  return freed;
+}
+
+/* Array and object literals get an entry in the literal cache the first time
+ * they're executed, keyed on the position of their opening bracket:
+ *
+ *   tpl  - if the literal only contains constant values (numbers, strings,
+ *          true/false/null/undefined and other constant literals), a copy of
+ *          what it evaluated to. We just copy this (see jspeCopyLiteral) and
+ *          skip over the source text.
+ *   end  - (with tpl) the position of the token after the literal
+ *   keys - for other object literals with no duplicate keys, an object
+ *          containing just the key names. We can then add each value to
+ *          the new object without converting or searching for its key.
+ *
+ * Entries with neither (other arrays, and objects with duplicate keys) just
+ * stop us scanning the literal every time. */
+static bool jspeLiteralTemplateBuild = false; ///< set while evaluating a literal to make a template from, so nested literals don't get cached separately
+
+/// Is the lexer on a token that is a constant value by itself?
+static bool jspeIsLiteralToken() {
+  return lex->tk==LEX_INT ||
+         lex->tk==LEX_FLOAT ||
+         lex->tk==LEX_STR ||
+         lex->tk==LEX_R_TRUE ||
+         lex->tk==LEX_R_FALSE ||
+         lex->tk==LEX_R_NULL ||
+         lex->tk==LEX_R_UNDEFINED;
+}
+
+/** Is the array or object literal the lexer is on made only of constant
+ * values? Moves the lexer on (not always to the end of the literal). The
+ * number of values found is added to 'count' */
+static bool jspeIsConstantLiteral(int *count) {
+  bool isArray = lex->tk=='[';
+  int endToken = isArray ? ']' : '}';
+  jslGetNextToken();
+  while (lex->tk != endToken) {
+    if (isArray) {
+      if (lex->tk==',') { // #287 - [,] and [1,2,,4] are allowed
+        (*count)++;
+        jslGetNextToken();
+        continue;
+      }
+    } else {
+      if (!jslIsIDOrReservedWord() && !jspeIsLiteralToken()) return false;
+      jslGetNextToken();
+      if (lex->tk!=':') return false;
+      jslGetNextToken();
+    }
+    if (++(*count) > JSP_LITERAL_TEMPLATE_MAX) return false;
+    if (lex->tk=='[' || lex->tk=='{') {
+      if (!jspeIsConstantLiteral(count)) return false;
+    } else {
+      if (lex->tk=='-') {
+        jslGetNextToken();
+        if (lex->tk!=LEX_INT && lex->tk!=LEX_FLOAT) return false;
+      } else if (!jspeIsLiteralToken()) return false;
+      jslGetNextToken();
+    }
+    if (lex->tk==',') jslGetNextToken();
+    else if (lex->tk!=endToken) return false;
+  }
+  jslGetNextToken();
+  return true;
+}
+
+/** Scan the object literal the lexer is on without executing anything, and
+ * return an object containing its keys (in order), or 0 if it has duplicate
+ * keys or can't be parsed. Moves the lexer on. */
+static JsVar *jspeObjectLiteralKeys() {
+  JsVar *keys = jsvNewObject();
+  if (!keys) return 0;
+  JSP_SAVE_EXECUTE();
+  jspSetNoExecute();
+  bool ok = true;
+  jslGetNextToken(); // '{'
+  while (ok && !JSP_SHOULDNT_PARSE && lex->tk != '}') {
+    // convert keys the same way jspeFactorObject does
+    JsVar *key = 0;
+    if (lex->tk==LEX_INT) key = jsvNewFromLongInteger(stringToInt(jslGetTokenValueAsString(lex)));
+    else if (lex->tk==LEX_FLOAT) key = jsvNewFromFloat(stringToFloat(jslGetTokenValueAsString(lex)));
+    else if (jslIsIDOrReservedWord() || lex->tk==LEX_STR) key = jslGetTokenValueAsVar(lex);
+    key = jsvAsArrayIndexAndUnLock(key);
+    JsVar *existing = key ? jsvFindChildFromVar(keys, key, false) : 0;
+    if (!key || existing) ok = false;
+    else jsvUnLock(jsvFindChildFromVar(keys, key, true));
+    jsvUnLock2(key, existing);
+    jslGetNextToken();
+    if (!ok || lex->tk!=':') {
+      ok = false;
+      break;
+    }
+    jslGetNextToken();
+    jsvUnLock(jspeAssignmentExpression());
+    if (lex->tk==',') jslGetNextToken();
+    else if (lex->tk!='}') ok = false;
+  }
+  if (JSP_SHOULDNT_PARSE) ok = false;
+  JSP_RESTORE_EXECUTE();
+  if (!ok || !jsvGetFirstChild(keys)) {
+    jsvUnLock(keys);
+    return 0;
+  }
+  return keys;
+}
+
+/// Copy a template from the literal cache. Nested arrays and objects are copied too, but other values are shared.
+static JsVar *jspeCopyLiteral(JsVar *tpl) {
+  JsVar *dst = jsvCopy(tpl);
+  if (!dst) return 0;
+  JsVarRef childref = jsvGetFirstChild(dst);
+  while (childref) {
+    JsVar *name = jsvLock(childref);
+    if (!jsvIsNameWithValue(name) && jsvGetFirstChild(name)) {
+      JsVar *value = jsvLock(jsvGetFirstChild(name));
+      if (jsvIsArray(value) || jsvIsObject(value)) {
+        // if we're out of memory, don't leave the template's value in there to be modified
+        JsVar *copy = jspeCopyLiteral(value);
+        jsvSetValueOfName(name, copy);
+        jsvUnLock(copy);
+      }
+      jsvUnLock(value);
+    }
+    childref = jsvGetNextSibling(name);
+    jsvUnLock(name);
+  }
+  return dst;
+}
+
+/// Create a new object from an object literal, using the key names in 'keys' (see jspeObjectLiteralKeys)
+static JsVar *jspeFactorObjectFromKeys(JsVar *keys) {
+  JsVar *contents = jsvNewObject();
+  if (!contents) { // out of memory
+    jspSetError(false);
+    return 0;
+  }
+  JSP_MATCH_WITH_RETURN('{', contents);
+  JsVarRef keyref = jsvGetFirstChild(keys);
+  while (keyref && !JSP_SHOULDNT_PARSE) {
+    JsVar *key = jsvLock(keyref);
+    jslGetNextToken(); // skip over the key - we already have it
+    JSP_MATCH_WITH_CLEANUP_AND_RETURN(':', jsvUnLock(key), contents);
+    JsVar *value = jsvSkipNameAndUnLock(jspeAssignmentExpression()); // value can be 0 (could be undefined!)
+    // keys are unique, so we can just add to the end without searching
+    JsVar *name = jsvCopyNameOnly(key, false/*linkChildren*/, true/*keepAsName*/);
+    if (name) { // could be out of memory
+      jsvSetValueOfName(name, value);
+      jsvAddName(contents, name);
+      jsvUnLock(name);
+    }
+    jsvUnLock(value);
+    keyref = jsvGetNextSibling(key);
+    jsvUnLock(key);
+    if (lex->tk != '}') JSP_MATCH_WITH_RETURN(',', contents);
+  }
+  JSP_MATCH_WITH_RETURN('}', contents);
+  return contents;
+}
+
+/** Quick check on the character after the opening bracket so we don't look in
+ * the cache for literals that can't gain from it: empty ones, and arrays that
+ * start with an identifier (that isn't true/false/null/undefined) */
+static bool jspeLiteralMayBeCached() {
+  char ch = lex->currCh;
+  if (ch==']' || ch=='}') return false;
+  return !(lex->tk=='[' && isAlpha(ch) && !strchr("tfnu", ch));
+}
+
+/** Try and create the array or object literal the lexer is on using the
+ * literal cache, adding an entry for it if there isn't one. Returns false
+ * (with the lexer where it was) if the literal must be parsed normally */
+static bool jspeFactorCachedLiteral(JsVar **result) {
+  if (!jspeLiteralMayBeCached()) return false;
+  size_t start = jspeGetTokenStart();
+  JsVar *entry = jspeCacheFind(JSP_LITERAL_CACHE_NAME, start);
+  if (!entry) {
+    bool isArray = lex->tk=='[';
+    JslCharPos startPos = jslCharPosClone(&lex->tokenStart);
+    int count = 0;
+    bool constant = jspeIsConstantLiteral(&count);
+    jslSeekToP(&startPos);
+    JsVar *keys = 0;
+    if (!constant && !isArray) {
+      keys = jspeObjectLiteralKeys();
+      jslSeekToP(&startPos);
+    }
+    jslCharPosFree(&startPos);
+    if (constant && !count) // empty - nothing to gain
+      return false;
+    entry = jsvNewObject();
+    if (!entry) {
+      jsvUnLock(keys);
+      return false;
+    }
+    if (constant) {
+      // evaluate it normally, and keep a copy as the template
+      jspeLiteralTemplateBuild = true;
+      *result = isArray ? jspeFactorArray() : jspeFactorObject();
+      jspeLiteralTemplateBuild = false;
+      if (*result && !JSP_HAS_ERROR) {
+        jsvObjectSetChildAndUnLock(entry, "tpl", jspeCopyLiteral(*result));
+        jsvObjectSetChildAndUnLock(entry, "end", jsvNewFromInteger((JsVarInt)jspeGetTokenStart()));
+        jspeCacheAdd(JSP_LITERAL_CACHE_NAME, JSP_LITERAL_CACHE_SIZE, start, entry);
+      }
+      jsvUnLock(entry);
+      return true;
+    }
+    jsvObjectSetChildAndUnLock(entry, "keys", keys);
+    jspeCacheAdd(JSP_LITERAL_CACHE_NAME, JSP_LITERAL_CACHE_SIZE, start, entry);
+  }
+  bool handled = true;
+  JsVar *tpl = jsvObjectGetChild(entry, "tpl", 0);
+  JsVar *keys = (tpl || lex->tk=='[') ? 0 : jsvObjectGetChild(entry, "keys", 0);
+  if (tpl) {
+    *result = jspeCopyLiteral(tpl);
+    size_t end = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChild(entry, "end", 0));
+    // Seeking may have to walk the source from the start, so for short literals it's quicker to just lex past them
+    if (jsvIsFlatString(lex->sourceVar) || jsvIsNativeString(lex->sourceVar) || (end-start)*16 > start)
+      jslSeekTo(end);
+    else while (lex->tk!=LEX_EOF && jspeGetTokenStart()<end)
+      jslGetNextToken();
+  } else if (keys) {
+    *result = jspeFactorObjectFromKeys(keys);
+  } else
+    handled = false;
+  jsvUnLock3(tpl, keys, entry);
+  return handled;
+}
+#endif
+
 NO_INLINE JsVar *jspeFactorObject() {
   if (JSP_SHOULD_EXECUTE) {
+#ifndef SAVE_ON_FLASH
+    JsVar *cached = 0;
+    if (!jspeLiteralTemplateBuild && jspeFactorCachedLiteral(&cached))
+      return cached;
+#endif
     JsVar *contents = jsvNewObject();
     if (!contents) { // out of memory
       jspSetError(false);
@@ -1218,6 +1635,10 @@ NO_INLINE JsVar *jspeFactorArray() {
   int idx = 0;
   JsVar *contents = 0;
   if (JSP_SHOULD_EXECUTE) {
+#ifndef SAVE_ON_FLASH
+    if (!jspeLiteralTemplateBuild && jspeFactorCachedLiteral(&contents))
+      return contents;
+#endif
     contents = jsvNewEmptyArray();
     if (!contents) { // out of memory
       jspSetError(false);
@@ -1288,7 +1709,7 @@ NO_INLINE JsVar *jspeFactorTypeOf() {
 NO_INLINE JsVar *jspeFactorDelete() {
   JSP_ASSERT_MATCH(LEX_R_DELETE);
   JsVar *parent = 0;
-  JsVar *a = jspeFactorMember(jspeFactor(), &parent);
+  JsVar *a = jspeFactorMember(jspeFactor(), &parent, false);
   JsVar *result = 0;
   if (JSP_SHOULD_EXECUTE) {
     bool ok = false;
@@ -1560,6 +1981,8 @@ NO_INLINE JsVar *__jspeBinaryExpression(JsVar *a, unsigned int lastPrecedence) {
           }
           jsvUnLock3(av, bv, a);
           a = jsvNewFromBool(inst);
+        } else if (op=='+' && jsvMathsOpAppendInPlace(a, b)) {
+          // 'a' was a temporary string, so we just appended to it
         } else {  // --------------------------------------------- NORMAL
           JsVar *res = jsvMathsOpSkipNames(a, b, op);
           jsvUnLock(a); a = res;
@@ -1696,12 +2119,7 @@ NO_INLINE void jspeBlockNoBrackets() {
       if (JSP_HAS_ERROR) {
         if (lex && !(execInfo.execute&EXEC_ERROR_LINE_REPORTED)) {
           execInfo.execute = (JsExecFlags)(execInfo.execute | EXEC_ERROR_LINE_REPORTED);
-          JsVar *stackTrace = jsvObjectGetChild(execInfo.hiddenRoot, JSPARSE_STACKTRACE_VAR, JSV_STRING_0);
-          if (stackTrace) {
-            jsvAppendPrintf(stackTrace, "at ");
-            jspAppendStackTrace(stackTrace);
-            jsvUnLock(stackTrace);
-          }
+          jspAppendStackTrace(JSP_STACKTRACE_AT, 0);
         }
       }
       if (JSP_SHOULDNT_PARSE)
@@ -1818,50 +2236,196 @@ NO_INLINE JsVar *jspeStatementIf() {
   return 0;
 }
 
+#ifndef SAVE_ON_FLASH
+/* Switch statements get an entry in a small cache in hiddenRoot the first
+ * time they're executed, keyed on the position of their body in the source
+ * (see jspeCacheFind):
+ *
+ *   end - the position of the closing '}'
+ *   map - (only if every case label is an integer, float or string literal)
+ *         a Map from label value to the position of that case's body
+ *   def - (with map) the position of the default body, or -1
+ *
+ * A switch with a map can jump straight to the right case, and any switch can
+ * seek to its end rather than lexing the rest of its body once it has
+ * finished executing. The cache is emptied on reset or if memory gets low */
+
+/** Return a Map value if the lexer is on a literal case label (followed by ':') and move the
+ * lexer on to the ':', or return 0 and leave the lexer where it was (eg. for `case 1*2:`) */
+static JsVar *jspeSwitchLiteralLabel() {
+  size_t labelStart = jspeGetTokenStart();
+  bool negate = false;
+  if (lex->tk=='-') {
+    negate = true;
+    jslGetNextToken();
+  }
+  JsVar *v = 0;
+  if (lex->tk==LEX_INT) {
+    long long i = stringToInt(jslGetTokenValueAsString(lex));
+    v = jsvNewFromLongInteger(negate ? -i : i);
+  } else if (lex->tk==LEX_FLOAT) {
+    JsVarFloat f = stringToFloat(jslGetTokenValueAsString(lex));
+    v = jsvNewFromFloat(negate ? -f : f);
+  } else if (lex->tk==LEX_STR && !negate) {
+    v = jslGetTokenValueAsVar(lex);
+  }
+  if (v) jslGetNextToken();
+  if (!v || lex->tk!=':') {
+    // it's an expression that starts with a literal - go back so it can be parsed as one
+    if (negate || v) jslSeekTo(labelStart);
+    jsvUnLock(v);
+    return 0;
+  }
+  return v;
+}
+
+/** Scan the switch body starting at bodyStart (where the lexer is) without
+ * executing anything, and add an entry for it to the switch cache. The lexer
+ * is left somewhere inside the switch, so the caller must seek afterwards */
+static JsVar *jspeSwitchCacheAdd(size_t bodyStart) {
+  JsVar *entry = jsvNewObject();
+  JsVar *map = jswrap_map_constructor(0);
+  if (!entry || !map) {
+    jsvUnLock2(entry, map);
+    return 0;
+  }
+  JSP_SAVE_EXECUTE();
+  jspSetNoExecute();
+  JsVarInt defaultPos = -1;
+  bool literal = true;
+  while (!JSP_SHOULDNT_PARSE && (lex->tk==LEX_R_CASE || lex->tk==LEX_R_DEFAULT)) {
+    bool isDefault = lex->tk==LEX_R_DEFAULT;
+    JsVar *label = 0;
+    jslGetNextToken();
+    if (!isDefault) {
+      if (literal) label = jspeSwitchLiteralLabel();
+      if (!label) {
+        // not a literal - but we can still record where the end is
+        literal = false;
+        jsvUnLock(jspeAssignmentExpression());
+      }
+    }
+    if (lex->tk!=':') {
+      jsvUnLock(label);
+      break;
+    }
+    jslGetNextToken();
+    // the body starts at the token after ':'
+    if (isDefault) {
+      if (defaultPos<0) defaultPos = (JsVarInt)jspeGetTokenStart();
+    } else if (label && !jswrap_map_has(map, label)) { // the first of any duplicates wins
+      JsVar *pos = jsvNewFromInteger((JsVarInt)jspeGetTokenStart());
+      jsvUnLock2(jswrap_map_set(map, label, pos), pos);
+    }
+    jsvUnLock(label);
+    while (!JSP_SHOULDNT_PARSE && lex->tk!=LEX_EOF && lex->tk!=LEX_R_CASE && lex->tk!=LEX_R_DEFAULT && lex->tk!='}')
+      jsvUnLock(jspeBlockOrStatement());
+  }
+  JSP_RESTORE_EXECUTE();
+  if (lex->tk!='}' || JSP_SHOULDNT_PARSE) {
+    jsvUnLock2(entry, map);
+    return 0;
+  }
+  jsvObjectSetChildAndUnLock(entry, "end", jsvNewFromInteger((JsVarInt)jspeGetTokenStart()));
+  if (literal) {
+    jsvObjectSetChild(entry, "map", map);
+    jsvObjectSetChildAndUnLock(entry, "def", jsvNewFromInteger(defaultPos));
+  }
+  jsvUnLock(map);
+  jspeCacheAdd(JSP_SWITCH_CACHE_NAME, JSP_SWITCH_CACHE_SIZE, bodyStart, entry);
+  return entry;
+}
+#endif
+
 NO_INLINE JsVar *jspeStatementSwitch() {
   JSP_ASSERT_MATCH(LEX_R_SWITCH);
   JSP_MATCH('(');
-  JsVar *switchOn = jspeExpression();
+  JsVar *switchOn = jsvSkipNameAndUnLock(jspeExpression());
   JSP_MATCH_WITH_CLEANUP_AND_RETURN(')', jsvUnLock(switchOn), 0);
   JSP_MATCH_WITH_CLEANUP_AND_RETURN('{', jsvUnLock(switchOn), 0);
   JSP_SAVE_EXECUTE();
   bool execute = JSP_SHOULD_EXECUTE;
-  bool hasExecuted = false;
-  if (execute) execInfo.execute=EXEC_NO|EXEC_IN_SWITCH;
-  while (lex->tk==LEX_R_CASE) {
-    JSP_MATCH_WITH_CLEANUP_AND_RETURN(LEX_R_CASE, jsvUnLock(switchOn), 0);
-    JsExecFlags oldFlags = execInfo.execute;
-    if (execute) execInfo.execute=EXEC_YES|EXEC_IN_SWITCH;
-    JsVar *test = jspeAssignmentExpression();
-    execInfo.execute = oldFlags|EXEC_IN_SWITCH;;
-    JSP_MATCH_WITH_CLEANUP_AND_RETURN(':', jsvUnLock2(switchOn, test), 0);
-    bool cond = false;
-    if (execute)
-      cond = jsvGetBoolAndUnLock(jsvMathsOpSkipNames(switchOn, test, LEX_TYPEEQUAL));
-    if (cond) hasExecuted = true;
-    jsvUnLock(test);
-    if (cond && (execInfo.execute&EXEC_RUN_MASK)==EXEC_NO)
-      execInfo.execute=EXEC_YES|EXEC_IN_SWITCH;
-    while (!JSP_SHOULDNT_PARSE && lex->tk!=LEX_EOF && lex->tk!=LEX_R_CASE && lex->tk!=LEX_R_DEFAULT && lex->tk!='}')
-      jsvUnLock(jspeBlockOrStatement());
+  size_t bodyStart = jspeGetTokenStart();
+  JsVarInt endPos = -1; // where the closing '}' is, if we know
+  bool search = true; // do we need to check each case in turn?
+#ifndef SAVE_ON_FLASH
+  JsVar *entry = jspeCacheFind(JSP_SWITCH_CACHE_NAME, bodyStart);
+  if (!entry && execute) {
+    entry = jspeSwitchCacheAdd(bodyStart);
+    jslSeekTo(bodyStart);
+  }
+  if (entry) {
+    endPos = jsvGetIntegerAndUnLock(jsvObjectGetChild(entry, "end", 0));
+    JsVar *map = jsvObjectGetChild(entry, "map", 0);
+    if (!execute) {
+      // skip straight to the end
+      jslSeekTo((size_t)endPos);
+    } else if (map) {
+      // jump straight to the matching case, or default
+      JsVar *pos = jswrap_map_get(map, switchOn);
+      if (!pos) pos = jsvObjectGetChild(entry, "def", 0);
+      JsVarInt p = jsvGetIntegerAndUnLock(pos);
+      jslSeekTo((size_t)((p>=0) ? p : endPos));
+      search = false;
+    }
+    jsvUnLock2(map, entry);
+  }
+#endif
+  if (search) {
+    // Check each case in turn, skipping the bodies of ones that don't match
+    bool found = false;
+    bool hasDefault = false;
+    size_t defaultPos = 0;
+    while (!found && !JSP_SHOULDNT_PARSE && (lex->tk==LEX_R_CASE || lex->tk==LEX_R_DEFAULT)) {
+      if (lex->tk==LEX_R_CASE) {
+        JSP_ASSERT_MATCH(LEX_R_CASE);
+        JsVar *test = jspeAssignmentExpression();
+        JSP_MATCH_WITH_CLEANUP_AND_RETURN(':', jsvUnLock2(switchOn, test), 0);
+        if (execute && JSP_SHOULD_EXECUTE)
+          found = jsvGetBoolAndUnLock(jsvMathsOpSkipNames(switchOn, test, LEX_TYPEEQUAL));
+        jsvUnLock(test);
+      } else {
+        JSP_ASSERT_MATCH(LEX_R_DEFAULT);
+        JSP_MATCH_WITH_CLEANUP_AND_RETURN(':', jsvUnLock(switchOn), 0);
+        hasDefault = true;
+        defaultPos = jspeGetTokenStart();
+      }
+      if (!found) {
+        JSP_SAVE_EXECUTE();
+        jspSetNoExecute();
+        while (!JSP_SHOULDNT_PARSE && lex->tk!=LEX_EOF && lex->tk!=LEX_R_CASE && lex->tk!=LEX_R_DEFAULT && lex->tk!='}')
+          jsvUnLock(jspeBlockOrStatement());
+        JSP_RESTORE_EXECUTE();
+      }
+    }
+    // no match, so we run from 'default' (wherever it was)
+    if (!found && hasDefault && execute && JSP_SHOULD_EXECUTE)
+      jslSeekTo(defaultPos);
   }
   jsvUnLock(switchOn);
-  if (execute && (execInfo.execute&EXEC_RUN_MASK)==EXEC_BREAK)
-    execInfo.execute=EXEC_YES|EXEC_IN_SWITCH;
-  JSP_RESTORE_EXECUTE();
-
-  if (lex->tk==LEX_R_DEFAULT) {
-    JSP_ASSERT_MATCH(LEX_R_DEFAULT);
-    JSP_MATCH(':');
-    JSP_SAVE_EXECUTE();
-    if (hasExecuted) jspSetNoExecute();
-    else execInfo.execute |= EXEC_IN_SWITCH;
-    while (!JSP_SHOULDNT_PARSE && lex->tk!=LEX_EOF && lex->tk!='}')
+  // Run from here to the end of the switch, falling through any case labels
+  while (!JSP_SHOULDNT_PARSE && lex->tk!=LEX_EOF && lex->tk!='}') {
+    execInfo.execute |= EXEC_IN_SWITCH; // loops inside the switch may have cleared it
+    if (lex->tk==LEX_R_CASE || lex->tk==LEX_R_DEFAULT) {
+      // fall through - we don't evaluate the label
+      bool isCase = lex->tk==LEX_R_CASE;
+      JSP_ASSERT_MATCH(lex->tk);
+      if (isCase) {
+        JSP_SAVE_EXECUTE();
+        jspSetNoExecute();
+        jsvUnLock(jspeAssignmentExpression());
+        JSP_RESTORE_EXECUTE();
+      }
+      JSP_MATCH(':');
+    } else if (endPos>=0 && !JSP_SHOULD_EXECUTE) {
+      // break/return/etc - we know where the end is so don't bother lexing the rest
+      jslSeekTo((size_t)endPos);
+    } else
       jsvUnLock(jspeBlockOrStatement());
-    if (execute && !hasExecuted)
-      execInfo.execute = execInfo.execute & (JsExecFlags)~EXEC_BREAK;
-    JSP_RESTORE_EXECUTE();
   }
+  if (execute && (execInfo.execute&EXEC_RUN_MASK)==EXEC_BREAK)
+    execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_RUN_MASK) | EXEC_YES;
+  execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_IN_SWITCH) | (oldExecute & EXEC_IN_SWITCH);
   JSP_MATCH('}');
   return 0;
 }
@@ -1950,6 +2514,129 @@ NO_INLINE JsVar *jspeStatementDoOrWhile(bool isWhile) {
   return 0;
 }
 
+/// A 'for' loop of the form `for (...; i<bound; i++)` where we can handle the counter natively
+typedef struct {
+  JsVar *counter; ///< Name of the counter variable (locked)
+  int op;         ///< '<', '>', LEX_LEQUAL or LEX_GEQUAL
+  JsVarInt step;  ///< What we add to the counter each time around
+  bool boundIsConstant; ///< If the bound was an integer literal we don't need to parse it each time
+  JsVarInt bound; ///< The bound, if boundIsConstant
+} JspCountedLoop;
+
+/** See if a for loop's condition and iterator are of the form `i <|<=|>|>= bound;` and
+ * `i++`, `++i`, `i--`, `--i`, `i+=int` or `i-=int`. If so fill in 'loop' and return true. */
+static bool jspeForCountedLoopInit(JspCountedLoop *loop, JslCharPos *condStart, JslCharPos *iterStart) {
+  char name[JSLEX_MAX_TOKEN_LENGTH];
+  jslSeekToP(condStart);
+  if (lex->tk != LEX_ID) return false;
+  strncpy(name, jslGetTokenValueAsString(), JSLEX_MAX_TOKEN_LENGTH);
+  jslGetNextToken();
+  loop->op = lex->tk;
+  if (loop->op!='<' && loop->op!='>' && loop->op!=LEX_LEQUAL && loop->op!=LEX_GEQUAL) return false;
+  jslGetNextToken();
+  loop->boundIsConstant = false;
+  if (lex->tk == LEX_INT) {
+    long long bound = stringToInt(jslGetTokenValueAsString());
+    jslGetNextToken();
+    if (lex->tk==';' && bound>=INT32_MIN && bound<=INT32_MAX) {
+      loop->boundIsConstant = true;
+      loop->bound = (JsVarInt)bound;
+    }
+  }
+  if (!loop->boundIsConstant) {
+    // the bound has to be the whole of the rest of the condition
+    jslSeekToP(condStart);
+    jslGetNextToken();
+    jslGetNextToken();
+    JSP_SAVE_EXECUTE();
+    jspSetNoExecute();
+    jsvUnLock(__jspeBinaryExpression(jspeUnaryExpression(), jspeGetBinaryExpressionPrecedence(loop->op)));
+    JSP_RESTORE_EXECUTE();
+    if (lex->tk != ';') return false;
+  }
+  // now the iterator
+  jslSeekToP(iterStart);
+  bool isPrefix = lex->tk==LEX_PLUSPLUS || lex->tk==LEX_MINUSMINUS;
+  if (isPrefix) {
+    loop->step = (lex->tk==LEX_PLUSPLUS) ? 1 : -1;
+    jslGetNextToken();
+  }
+  if (lex->tk != LEX_ID || strcmp(name, jslGetTokenValueAsString())!=0) return false;
+  jslGetNextToken();
+  if (!isPrefix) {
+    if (lex->tk==LEX_PLUSPLUS || lex->tk==LEX_MINUSMINUS) {
+      loop->step = (lex->tk==LEX_PLUSPLUS) ? 1 : -1;
+    } else if (lex->tk==LEX_PLUSEQUAL || lex->tk==LEX_MINUSEQUAL) {
+      bool isMinus = lex->tk==LEX_MINUSEQUAL;
+      jslGetNextToken();
+      if (lex->tk != LEX_INT) return false;
+      long long step = stringToInt(jslGetTokenValueAsString());
+      if (step<=0 || step>0xFFFF) return false;
+      loop->step = (JsVarInt)(isMinus ? -step : step);
+    } else
+      return false;
+    jslGetNextToken();
+  }
+  if (lex->tk != ')') return false;
+  loop->counter = jspeiFindInScopes(name);
+  return loop->counter!=0;
+}
+
+/// Work out the condition of a counted for loop - the bound is only parsed if it wasn't constant
+static bool jspeForCountedLoopCondition(JspCountedLoop *loop, JslCharPos *condStart) {
+  // JS reads the counter before the bound
+  JsVar *counterValue = jsvSkipName(loop->counter);
+  JsVar *boundVar = 0;
+  JsVarInt bound = loop->bound;
+  bool isInt = jsvIsInt(counterValue);
+  if (!loop->boundIsConstant) {
+    jslSeekToP(condStart);
+    jslGetNextToken(); // counter
+    jslGetNextToken(); // comparison
+    boundVar = jsvSkipNameAndUnLock(__jspeBinaryExpression(jspeUnaryExpression(), jspeGetBinaryExpressionPrecedence(loop->op)));
+    if (jsvIsInt(boundVar)) bound = jsvGetInteger(boundVar);
+    else isInt = false;
+  }
+  bool cond;
+  if (isInt) {
+    JsVarInt i = jsvGetInteger(counterValue);
+    switch (loop->op) {
+      case '<': cond = i<bound; break;
+      case '>': cond = i>bound; break;
+      case LEX_LEQUAL: cond = i<=bound; break;
+      default: cond = i>=bound; break;
+    }
+  } else {
+    // not integers (or the counter was changed to something else) - do it the normal way
+    if (!boundVar) boundVar = jsvNewFromInteger(bound);
+    cond = jsvGetBoolAndUnLock(jsvMathsOp(counterValue, boundVar, loop->op));
+  }
+  jsvUnLock2(counterValue, boundVar);
+  return cond;
+}
+
+/// Step a counted for loop's counter. Return false if it wasn't an integer, so it must be done the normal way
+static bool jspeForCountedLoopStep(JspCountedLoop *loop) {
+  JsVar *counterValue = jsvSkipName(loop->counter);
+  bool ok = jsvIsInt(counterValue);
+  if (ok) {
+    JsVarInt i = jsvGetInteger(counterValue);
+    if (loop->step>0 ? i>INT32_MAX-loop->step : i<INT32_MIN-loop->step) {
+      ok = false; // would overflow into a float
+    } else if (jsvGetRefs(counterValue)==1 && jsvGetLocks(counterValue)==1) {
+      // only the counter uses this value, so just change it
+      counterValue->varData.integer = i+loop->step;
+    } else {
+      JsVar *newValue = jsvNewFromInteger(i+loop->step);
+      if (newValue) jsvSetValueOfName(loop->counter, newValue);
+      else ok = false;
+      jsvUnLock(newValue);
+    }
+  }
+  jsvUnLock(counterValue);
+  return ok;
+}
+
 NO_INLINE JsVar *jspeStatementFor() {
   JSP_ASSERT_MATCH(LEX_R_FOR);
   JSP_MATCH('(');
@@ -2102,19 +2789,26 @@ NO_INLINE JsVar *jspeStatementFor() {
       jslSeekToP(&forIterStart);
       if (lex->tk != ')') jsvUnLock(jspeExpression());
     }
+    // If this is a simple counted loop, handle the counter natively rather than parsing it each time
+    JspCountedLoop counted;
+    bool isCounted = !hasHadBreak && JSP_SHOULD_EXECUTE && loopCond &&
+                     jspeForCountedLoopInit(&counted, &forCondStart, &forIterStart);
     while (!hasHadBreak && JSP_SHOULD_EXECUTE && loopCond
 #ifdef JSPARSE_MAX_LOOP_ITERATIONS
         && loopCount-->0
 #endif
     ) {
-      jslSeekToP(&forCondStart);
-      ;
-      if (lex->tk == ';') {
-        loopCond = true;
+      if (isCounted) {
+        loopCond = jspeForCountedLoopCondition(&counted, &forCondStart);
       } else {
-        JsVar *cond = jspeAssignmentExpression();
-        loopCond = jsvGetBoolAndUnLock(jsvSkipName(cond));
-        jsvUnLock(cond);
+        jslSeekToP(&forCondStart);
+        if (lex->tk == ';') {
+          loopCond = true;
+        } else {
+          JsVar *cond = jspeAssignmentExpression();
+          loopCond = jsvGetBoolAndUnLock(jsvSkipName(cond));
+          jsvUnLock(cond);
+        }
       }
       if (JSP_SHOULD_EXECUTE && loopCond) {
         jslSeekToP(&forBodyStart);
@@ -2129,11 +2823,13 @@ NO_INLINE JsVar *jspeStatementFor() {
           hasHadBreak = true;
         }
       }
-      if (JSP_SHOULD_EXECUTE && loopCond && !hasHadBreak) {
+      if (JSP_SHOULD_EXECUTE && loopCond && !hasHadBreak &&
+          !(isCounted && jspeForCountedLoopStep(&counted))) {
         jslSeekToP(&forIterStart);
         if (lex->tk != ')') jsvUnLock(jspeExpression());
       }
     }
+    if (isCounted) jsvUnLock(counted.counter);
     jslSeekToP(&forBodyEnd);
 
     jslCharPosFree(&forCondStart);
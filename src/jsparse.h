@@ -23,6 +23,14 @@ void jspKill();
 // jspSoft* - 'release' or 'claim' anything we are using, but ensure that it doesn't get freed
 void jspSoftInit(); ///< used when recovering from or saving to flash
 void jspSoftKill(); ///< used when recovering from or saving to flash
+
+#define JSP_SWITCH_CACHE_NAME "swCache" ///< Name of the switch statement jump table cache in hiddenRoot
+#define JSP_SWITCH_CACHE_SIZE 16 ///< Maximum number of switch statements in the cache
+#define JSP_LITERAL_CACHE_NAME "litCache" ///< Name of the array/object literal template cache in hiddenRoot
+#define JSP_LITERAL_CACHE_SIZE 32 ///< Maximum number of array/object literals in the cache
+#define JSP_LITERAL_TEMPLATE_MAX 1024 ///< Maximum number of values in a cached constant array/object literal
+/// Empty the switch statement, literal, line index and built-in function caches. Returns true if anything was freed
+bool jspCodeCacheFlush();
 /** Returns true if the constructor function given is the same as that
  * of the object with the given name. */
 bool jspIsConstructor(JsVar *constructor, const char *constructorName);
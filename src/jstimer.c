@@ -22,7 +22,11 @@ volatile unsigned char utilTimerTasksTail = 0;
 
 volatile bool utilTimerOn = false;
 unsigned int utilTimerBit;
+#ifdef LINUX
+__thread bool utilTimerInIRQ = false; // the util timer has its own thread on Linux - other threads must still lock
+#else
 bool utilTimerInIRQ = false;
+#endif
 unsigned int utilTimerData;
 uint16_t utilTimerReload0H, utilTimerReload0L, utilTimerReload1H, utilTimerReload1L;
 
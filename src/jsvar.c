@@ -33,10 +33,19 @@
  * more blocks can be allocated. We can't use realloc on one big block as
  * this may change the address of vars that are already locked!
  *
+ * With MMAP_JSVARS we instead reserve a big range of address space up
+ * front and just commit more of it as we need it. Vars never move, so
+ * it can still be treated as one big array.
  */
 
 #ifdef RESIZABLE_JSVARS
+#ifdef MMAP_JSVARS
+#include <sys/mman.h>
+JsVar *jsVars = 0; ///< Reserved with mmap - only the first jsVarsSize vars are actually usable
+#define JSVAR_MMAP_MAX_VARS (1U<<24) ///< How many vars we reserve address space for
+#else
 JsVar **jsVarBlocks = 0;
+#endif
 unsigned int jsVarsSize = 0;
 #define JSVAR_BLOCK_SIZE 4096
 #define JSVAR_BLOCK_SHIFT 12
@@ -46,6 +55,7 @@ unsigned int jsVarsSize = JSVAR_CACHE_SIZE;
 #endif
 
 volatile JsVarRef jsVarFirstEmpty; ///< reference of first unused variable (variables are in a linked list)
+volatile unsigned int jsVarsUsed; ///< How many variables are in use (updated as we allocate/free, so we don't have to count)
 volatile bool isMemoryBusy; ///< Are we doing garbage collection or similar, so can't access memory?
 
 // ----------------------------------------------------------------------------
@@ -104,7 +114,7 @@ ALWAYS_INLINE bool jsvIsIterable(const JsVar *v) {
  * This is effectively a Lock without locking! */
 static ALWAYS_INLINE JsVar *jsvGetAddressOf(JsVarRef ref) {
   assert(ref);
-#ifdef RESIZABLE_JSVARS
+#if defined(RESIZABLE_JSVARS) && !defined(MMAP_JSVARS)
   JsVarRef t = ref-1;
   return &jsVarBlocks[t>>JSVAR_BLOCK_SHIFT][t&(JSVAR_BLOCK_SIZE-1)];
 #else
@@ -116,6 +126,10 @@ JsVar *_jsvGetAddressOf(JsVarRef ref) {
   return jsvGetAddressOf(ref);
 }
 
+ALWAYS_INLINE JsVar *jsvGetAddressOfBorrowed(JsVarRef ref) {
+  return jsvGetAddressOf(ref);
+}
+
 #ifdef JSVARREF_PACKED_BITS
 #define JSVARREF_PACKED_BIT_MASK ((1U<<JSVARREF_PACKED_BITS)-1)
 JsVarRef jsvGetFirstChild(const JsVar *v) { return (JsVarRef)(v->varData.ref.firstChild | (((v->varData.ref.pack)&JSVARREF_PACKED_BIT_MASK))<<8); }
@@ -168,6 +182,7 @@ void jsvCreateEmptyVarList() {
   JsVar firstVar; // temporary var to simplify code in the loop below
   jsvSetNextSibling(&firstVar, 0);
   JsVar *lastEmpty = &firstVar;
+  unsigned int freeCount = 0;
 
   JsVarRef i;
   for (i=1;i<=jsVarsSize;i++) {
@@ -175,6 +190,7 @@ void jsvCreateEmptyVarList() {
     if ((var->flags&JSV_VARTYPEMASK) == JSV_UNUSED) {
       jsvSetNextSibling(lastEmpty, i);
       lastEmpty = var;
+      freeCount++;
     } else if (jsvIsFlatString(var)) {
       // skip over used blocks for flat strings
       i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
@@ -182,12 +198,14 @@ void jsvCreateEmptyVarList() {
   }
   jsvSetNextSibling(lastEmpty, 0);
   jsVarFirstEmpty = jsvGetNextSibling(&firstVar);
+  jsVarsUsed = jsVarsSize - freeCount;
   isMemoryBusy = false;
 }
 
 /* Removes the empty variable counter, cleaving clear runs of 0s
  where no data resides. This helps if compressing the variables
- for storage. */
+ for storage. jsVarsUsed is left alone, as the variables are
+ still unused - they're just not linked. */
 void jsvClearEmptyVarList() {
   assert(!isMemoryBusy);
   isMemoryBusy = true;
@@ -232,16 +250,32 @@ static JsVarRef jsvInitJsVars(JsVarRef start, unsigned int count) {
 void jsvInit() {
 #ifdef RESIZABLE_JSVARS
   jsVarsSize = JSVAR_BLOCK_SIZE;
+#ifdef MMAP_JSVARS
+  // reserve address space, but only commit what we're going to use
+  void *p = mmap(0, sizeof(JsVar) * JSVAR_MMAP_MAX_VARS, PROT_NONE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (p == MAP_FAILED || mprotect(p, sizeof(JsVar) * JSVAR_BLOCK_SIZE, PROT_READ | PROT_WRITE)) {
+    jsError("Unable to reserve memory for variables");
+    exit(1);
+  }
+  jsVars = (JsVar*)p;
+#else
   jsVarBlocks = malloc(sizeof(JsVar*)); // just 1
   jsVarBlocks[0] = malloc(sizeof(JsVar) * JSVAR_BLOCK_SIZE);
+#endif
 #endif
 
   jsVarFirstEmpty = jsvInitJsVars(1/*first*/, jsVarsSize);
+  jsVarsUsed = 0;
   jsvSoftInit();
 }
 
 void jsvKill() {
-#ifdef RESIZABLE_JSVARS
+#ifdef MMAP_JSVARS
+  munmap(jsVars, sizeof(JsVar) * JSVAR_MMAP_MAX_VARS);
+  jsVars = 0;
+  jsVarsSize = 0;
+#elif defined(RESIZABLE_JSVARS)
   unsigned int i;
   for (i=0;i<jsVarsSize>>JSVAR_BLOCK_SHIFT;i++)
     free(jsVarBlocks[i]);
@@ -264,20 +298,7 @@ JsVar *jsvFindOrCreateRoot() {
 
 /// Get number of memory records (JsVars) used
 unsigned int jsvGetMemoryUsage() {
-  unsigned int usage = 0;
-  unsigned int i;
-  for (i=1;i<=jsVarsSize;i++) {
-    JsVar *v = jsvGetAddressOf((JsVarRef)i);
-    if ((v->flags&JSV_VARTYPEMASK) != JSV_UNUSED) {
-      usage++;
-      if (jsvIsFlatString(v)) {
-        unsigned int b = (unsigned int)jsvGetFlatStringBlocks(v);
-        i+=b;
-        usage+=b;
-      }
-    }
-  }
-  return usage;
+  return jsVarsUsed;
 }
 
 /// Get total amount of memory records
@@ -289,19 +310,35 @@ unsigned int jsvGetMemoryTotal() {
 void jsvSetMemoryTotal(unsigned int jsNewVarCount) {
 #ifdef RESIZABLE_JSVARS
   assert(!isMemoryBusy);
-  isMemoryBusy = true;
   if (jsNewVarCount <= jsVarsSize) return; // never allow us to have less!
+  isMemoryBusy = true;
   // When resizing, we just allocate a bunch more
   unsigned int oldSize = jsVarsSize;
-  unsigned int oldBlockCount = jsVarsSize >> JSVAR_BLOCK_SHIFT;
   unsigned int newBlockCount = (jsNewVarCount+JSVAR_BLOCK_SIZE-1) >> JSVAR_BLOCK_SHIFT;
+#ifdef MMAP_JSVARS
+  if ((newBlockCount << JSVAR_BLOCK_SHIFT) > JSVAR_MMAP_MAX_VARS)
+    newBlockCount = JSVAR_MMAP_MAX_VARS >> JSVAR_BLOCK_SHIFT;
+  // commit the extra address space - everything below it stays where it is
+  if (mprotect(jsVars, sizeof(JsVar) * (newBlockCount << JSVAR_BLOCK_SHIFT), PROT_READ | PROT_WRITE))
+    newBlockCount = oldSize >> JSVAR_BLOCK_SHIFT;
+  jsVarsSize = newBlockCount << JSVAR_BLOCK_SHIFT;
+  if (jsVarsSize == oldSize) { // couldn't get any more
+    isMemoryBusy = false;
+    return;
+  }
+#else
+  unsigned int oldBlockCount = jsVarsSize >> JSVAR_BLOCK_SHIFT;
   jsVarsSize = newBlockCount << JSVAR_BLOCK_SHIFT;
-  // resize block table
+  /* resize block table - the util timer may be following a waveform's
+   * buffer through this (jstimer.c) so it mustn't run while it moves */
+  jshInterruptOff();
   jsVarBlocks = realloc(jsVarBlocks, sizeof(JsVar*)*newBlockCount);
+  jshInterruptOn();
   // allocate more blocks
   unsigned int i;
   for (i=oldBlockCount;i<newBlockCount;i++)
     jsVarBlocks[i] = malloc(sizeof(JsVar) * JSVAR_BLOCK_SIZE);
+#endif
   /** and now reset all the newly allocated vars. We know jsVarFirstEmpty
    * is 0 (because jsiFreeMoreMemory returned 0) so we can just assign it.  */
   assert(!jsVarFirstEmpty);
@@ -316,15 +353,7 @@ void jsvSetMemoryTotal(unsigned int jsNewVarCount) {
 
 bool jsvMoreFreeVariablesThan(unsigned int vars) {
   if (!vars) return false;
-  JsVarRef r = jsVarFirstEmpty;
-  while (r) {
-    if (!vars) return true;
-    vars--;
-
-    JsVar *v = jsvGetAddressOf(r);
-    r = jsvGetNextSibling(v);
-  }
-  return false;
+  return jsVarsSize - jsVarsUsed > vars;
 }
 
 /// Get whether memory is full or not
@@ -376,16 +405,28 @@ void jsvResetVariable(JsVar *v, JsVarFlags flags) {
   v->flags = flags | JSV_LOCK_ONE;
 }
 
+/* Boards where variables are never allocated or freed from an IRQ (or
+ * another thread) define JSVARS_NO_IRQ_ALLOC in their board config, so
+ * they don't pay for jshInterruptOff on every allocation */
+#ifdef JSVARS_NO_IRQ_ALLOC
+#define jsvFreeListLock()
+#define jsvFreeListUnlock()
+#else
+#define jsvFreeListLock() jshInterruptOff()
+#define jsvFreeListUnlock() jshInterruptOn()
+#endif
+
 JsVar *jsvNewWithFlags(JsVarFlags flags) {
   if (isMemoryBusy) {
     jsErrorFlags |= JSERR_MEMORY_BUSY;
     return 0;
   }
   if (jsVarFirstEmpty!=0) {
-    jshInterruptOff(); // to allow this to be used from an IRQ
+    jsvFreeListLock(); // to allow this to be used from an IRQ
     JsVar *v = jsvGetAddressOf(jsVarFirstEmpty); // jsvResetVariable will lock
     jsVarFirstEmpty = jsvGetNextSibling(v); // move our reference to the next in the fr
-    jshInterruptOn();
+    jsVarsUsed++;
+    jsvFreeListUnlock();
     assert(v->flags == JSV_UNUSED);
     // Cope with IRQs/multi-threading when getting a new free variable
  /*   JsVarRef empty;
@@ -413,26 +454,28 @@ JsVar *jsvNewWithFlags(JsVarFlags flags) {
   }
   /* We couldn't claim any more memory by Garbage collecting... */
 #ifdef RESIZABLE_JSVARS
+  unsigned int oldSize = jsVarsSize;
   jsvSetMemoryTotal(jsVarsSize*2);
-  return jsvNewWithFlags(flags);
-#else
+  if (jsVarsSize > oldSize)
+    return jsvNewWithFlags(flags);
+#endif
   // On a micro, we're screwed.
   if (!(jsErrorFlags&JSERR_MEMORY))
     jsError("Out of Memory!");
   jsErrorFlags |= JSERR_MEMORY;
   jspSetInterrupted(true);
   return 0;
-#endif
 }
 
 ALWAYS_INLINE void jsvFreePtrInternal(JsVar *var) {
   assert(jsvGetLocks(var)==0);
   var->flags = JSV_UNUSED;
   // add this to our free list
-  jshInterruptOff(); // to allow this to be used from an IRQ
+  jsvFreeListLock(); // to allow this to be used from an IRQ
   jsvSetNextSibling(var, jsVarFirstEmpty);
   jsVarFirstEmpty = jsvGetRef(var);
-  jshInterruptOn();
+  jsVarsUsed--;
+  jsvFreeListUnlock();
 }
 
 ALWAYS_INLINE void jsvFreePtr(JsVar *var) {
@@ -535,7 +578,7 @@ ALWAYS_INLINE void jsvFreePtr(JsVar *var) {
 /// Get a reference from a var - SAFE for null vars
 ALWAYS_INLINE JsVarRef jsvGetRef(JsVar *var) {
   if (!var) return 0;
-#ifdef RESIZABLE_JSVARS
+#if defined(RESIZABLE_JSVARS) && !defined(MMAP_JSVARS)
   unsigned int i, c = jsVarsSize>>JSVAR_BLOCK_SHIFT;
   for (i=0;i<c;i++) {
     if (var>=jsVarBlocks[i] && var<&jsVarBlocks[i][JSVAR_BLOCK_SIZE]) {
@@ -664,7 +707,7 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
   // Now try and find them
   unsigned int blockCount = 0;
 
-#ifdef RESIZABLE_JSVARS
+#if defined(RESIZABLE_JSVARS) && !defined(MMAP_JSVARS)
   JsVar *lastVar = 0;
 #endif
 
@@ -672,6 +715,7 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
   JsVar firstVar; // temporary var to simplify code in the loop below
   jsvSetNextSibling(&firstVar, 0);
   JsVar *lastEmpty = &firstVar;
+  unsigned int freeCount = 0;
 
   JsVarRef i, j;
 
@@ -679,11 +723,18 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
   for (i=1;i<=jsVarsSize;i++)  {
     JsVar *var = jsvGetAddressOf(i);
     if ((var->flags&JSV_VARTYPEMASK) == JSV_UNUSED) {
-#ifdef RESIZABLE_JSVARS
+#if defined(RESIZABLE_JSVARS) && !defined(MMAP_JSVARS)
       /** With RESIZABLE_JSVARS (Linux), we have chunks of variables that may
        * not be contiguous - so we can't allocate a flat string across them!  */
-      if (var != lastVar+1)
+      if (var != lastVar+1) {
+        // add the blocks we skipped back to the free list
+        for (j=(JsVarRef)(i-blockCount);j<i;j++) {
+          jsvSetNextSibling(lastEmpty, j);
+          lastEmpty = jsvGetAddressOf(j);
+          freeCount++;
+        }
         blockCount = 0;
+      }
       lastVar = var;
 #endif
       blockCount++;
@@ -705,6 +756,7 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
         JsVar *v = jsvGetAddressOf(j);
         jsvSetNextSibling(lastEmpty, j);
         lastEmpty = v;
+        freeCount++;
       }
       // start again...
       blockCount = 0; // non-continuous
@@ -712,6 +764,14 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
         i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
     }
   }
+  if (!flatString) {
+    // we ran off the end of memory - add the final run of free blocks back to the free list
+    for (j=(JsVarRef)(i-blockCount);j<i;j++) {
+      jsvSetNextSibling(lastEmpty, j);
+      lastEmpty = jsvGetAddressOf(j);
+      freeCount++;
+    }
+  }
   /* continue where we left off, and keep re-linking the
    * free variable list */
   for (;i<=jsVarsSize;i++)  {
@@ -719,6 +779,7 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
     if ((var->flags&JSV_VARTYPEMASK) == JSV_UNUSED) {
       jsvSetNextSibling(lastEmpty, i);
       lastEmpty = var;
+      freeCount++;
     } else if (jsvIsFlatString(var)) {
       // skip over used blocks for flat strings
       i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
@@ -726,6 +787,7 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
   }
   jsvSetNextSibling(lastEmpty, 0);
   jsVarFirstEmpty = jsvGetNextSibling(&firstVar);
+  jsVarsUsed = jsVarsSize - freeCount;
   isMemoryBusy = false;
   // Return whatever we had (0 if we couldn't manage it)
   return flatString;
@@ -990,24 +1052,17 @@ bool jsvIsBasicVarEqual(JsVar *a, JsVar *b) {
       }
     }
   } else if (jsvIsString(a) && jsvIsString(b)) {
+    // nothing here can allocate, so we don't need to lock each StringExt
     JsvStringIterator ita, itb;
-    jsvStringIteratorNew(&ita, a, 0);
-    jsvStringIteratorNew(&itb, b, 0);
+    jsvStringIteratorNewBorrowed(&ita, a, 0);
+    jsvStringIteratorNewBorrowed(&itb, b, 0);
     while (true) {
       char a = jsvStringIteratorGetChar(&ita);
       char b = jsvStringIteratorGetChar(&itb);
-      if (a != b) {
-        jsvStringIteratorFree(&ita);
-        jsvStringIteratorFree(&itb);
-        return false;
-      }
-      if (!a) { // equal, but end of string
-        jsvStringIteratorFree(&ita);
-        jsvStringIteratorFree(&itb);
-        return true;
-      }
-      jsvStringIteratorNext(&ita);
-      jsvStringIteratorNext(&itb);
+      if (a != b) return false;
+      if (!a) return true; // equal, but end of string
+      jsvStringIteratorNextBorrowed(&ita);
+      jsvStringIteratorNextBorrowed(&itb);
     }
     // we never get here
     return false; // make compiler happy
@@ -1468,20 +1523,16 @@ JsVar *jsvVarPrintf( const char *fmt, ...) {
 void jsvAppendStringVar(JsVar *var, const JsVar *str, size_t stridx, size_t maxLength) {
   assert(jsvIsString(var));
 
+  // If appending to ourselves, make sure we don't read the characters we're adding
+  if (var==str) {
+    size_t len = jsvGetStringLength(str);
+    if (stridx >= len) return;
+    if (maxLength > len-stridx) maxLength = len-stridx;
+  }
   JsvStringIterator dst;
   jsvStringIteratorNew(&dst, var, 0);
   jsvStringIteratorGotoEnd(&dst);
-  // now start appending
-  /* This isn't as fast as something single-purpose, but it's not that bad,
-     * and is less likely to break :) */
-  JsvStringIterator it;
-  jsvStringIteratorNewConst(&it, str, stridx);
-  while (jsvStringIteratorHasChar(&it) && (maxLength-->0)) {
-    char ch = jsvStringIteratorGetChar(&it);
-    jsvStringIteratorAppend(&dst, ch);
-    jsvStringIteratorNext(&it);
-  }
-  jsvStringIteratorFree(&it);
+  jsvStringIteratorAppendString(&dst, (JsVar*)str, stridx, maxLength);
   jsvStringIteratorFree(&dst);
 }
 
@@ -1864,19 +1915,15 @@ bool jsvIsStringEqualOrStartsWith(JsVar *var, const char *str, bool isStartsWith
   }
 
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, var, 0);
+  jsvStringIteratorNewBorrowed(&it, var, 0);
   while (jsvStringIteratorHasChar(&it) && *str) {
-    if (jsvStringIteratorGetChar(&it) != *str) {
-      jsvStringIteratorFree(&it);
+    if (jsvStringIteratorGetChar(&it) != *str)
       return false;
-    }
     str++;
-    jsvStringIteratorNext(&it);
+    jsvStringIteratorNextBorrowed(&it);
   }
-  bool eq = (isStartsWith && !*str) ||
-            jsvStringIteratorGetChar(&it)==*str; // should both be 0 if equal
-  jsvStringIteratorFree(&it);
-  return eq;
+  return (isStartsWith && !*str) ||
+         jsvStringIteratorGetChar(&it)==*str; // should both be 0 if equal
 }
 
 // Also see jsvIsBasicVarEqual
@@ -1898,26 +1945,21 @@ bool jsvIsStringEqualAndUnLock(JsVar *var, const char *str) {
  *  */
 int jsvCompareString(JsVar *va, JsVar *vb, size_t starta, size_t startb, bool equalAtEndOfString) {
   JsvStringIterator ita, itb;
-  jsvStringIteratorNew(&ita, va, starta);
-  jsvStringIteratorNew(&itb, vb, startb);
+  jsvStringIteratorNewBorrowed(&ita, va, starta);
+  jsvStringIteratorNewBorrowed(&itb, vb, startb);
   // step to first positions
   while (true) {
     int ca = jsvStringIteratorGetCharOrMinusOne(&ita);
     int cb = jsvStringIteratorGetCharOrMinusOne(&itb);
 
     if (ca != cb) {
-      jsvStringIteratorFree(&ita);
-      jsvStringIteratorFree(&itb);
       if ((ca<0 || cb<0) && equalAtEndOfString) return 0;
       return ca - cb;
     }
-    if (ca < 0) { // both equal, but end of string
-      jsvStringIteratorFree(&ita);
-      jsvStringIteratorFree(&itb);
+    if (ca < 0) // both equal, but end of string
       return 0;
-    }
-    jsvStringIteratorNext(&ita);
-    jsvStringIteratorNext(&itb);
+    jsvStringIteratorNextBorrowed(&ita);
+    jsvStringIteratorNextBorrowed(&itb);
   }
   // never get here, but the compiler warns...
   return true;
@@ -2022,6 +2064,44 @@ JsVar *jsvCopyNameOnly(JsVar *src, bool linkChildren, bool keepAsName) {
   return dst;
 }
 
+/// Get the ref of the flat string holding an object's native state, or 0. This never allocates.
+static JsVarRef jsvObjectGetNativeStateRef(JsVar *obj) {
+  if (!jsvHasChildren(obj) || !jsvGetFirstChild(obj)) return 0;
+  // Nothing here can allocate, so we don't need to lock
+  JsVar *name = jsvGetAddressOfBorrowed(jsvGetFirstChild(obj));
+  if (jsvIsName(name) && jsvIsString(name) &&
+      name->varData.str[0]==JS_HIDDEN_CHAR && // quick check - this is usually __proto__
+      jsvIsStringEqualOrStartsWith(name, JSV_NATIVE_STATE_NAME, false)) {
+    JsVarRef stateRef = jsvGetFirstChild(name);
+    if (stateRef && jsvIsFlatString(jsvGetAddressOfBorrowed(stateRef)))
+      return stateRef;
+  }
+  return 0;
+}
+
+/** jsvCopy links the copy's children to the same values as the original's, but native state
+ * can't be shared. Give 'dst' its own copy of src's block, then let the class (see jswCopyState)
+ * copy anything else the state refers to. If we're out of memory 'dst' just has no state. */
+static void jsvCopyNativeState(JsVar *src, JsVar *dst) {
+  JsVarRef srcStateRef = jsvObjectGetNativeStateRef(src);
+  // jsvCopy kept the order of the children, so the state's name should be the first child of 'dst' too
+  if (!srcStateRef || jsvObjectGetNativeStateRef(dst)!=srcStateRef) return;
+  JsVar *name = jsvLock(jsvGetFirstChild(dst));
+  JsVar *srcState = jsvLock(srcStateRef);
+  size_t len = jsvGetStringLength(srcState);
+  JsVar *state = jsvNewFlatStringOfLength((unsigned int)len);
+  if (state) {
+    char *ptr = jsvGetFlatStringPointer(state);
+    memcpy(ptr, jsvGetFlatStringPointer(srcState), len);
+    jsvSetValueOfName(name, state);
+    jswCopyState(src, dst, (unsigned char)ptr[len-1]);
+    jsvUnLock(state);
+  } else {
+    jsvRemoveChild(dst, name);
+  }
+  jsvUnLock2(srcState, name);
+}
+
 JsVar *jsvCopy(JsVar *src) {
   if (jsvIsFlatString(src)) {
     // Copy a Flat String into a non-flat string - it's just safer
@@ -2082,6 +2162,7 @@ JsVar *jsvCopy(JsVar *src) {
       vr = jsvGetNextSibling(name);
       jsvUnLock(name);
     }
+    jsvCopyNativeState(src, dst);
   } else {
     assert(jsvIsBasic(src)); // in case we missed something!
   }
@@ -2279,13 +2360,13 @@ JsVar *jsvFindChildFromVar(JsVar *parent, JsVar *childName, bool addIfNotFound)
   JsVarRef childref = jsvGetFirstChild(parent);
 
   while (childref) {
-    child = jsvLock(childref);
+    // Comparing names can't allocate, so just borrow each child and only lock the one we return
+    child = jsvGetAddressOfBorrowed(childref);
     if (jsvIsBasicVarEqual(child, childName)) {
       // found it! unlock parent but leave child locked
-      return child;
+      return jsvLockAgain(child);
     }
     childref = jsvGetNextSibling(child);
-    jsvUnLock(child);
   }
 
   child = 0;
@@ -2397,6 +2478,51 @@ void jsvObjectSetChildAndUnLock(JsVar *obj, const char *name, JsVar *child) {
   jsvUnLock(jsvObjectSetChild(obj, name, child));
 }
 
+/* Native state is a flat string holding a C struct, stored under a hidden
+ * name as the *first* child of an object. That way we can find it without
+ * searching, and it still gets saved, copied and garbage collected with the
+ * object. It mustn't contain JsVarRefs that it expects to keep alive.
+ *
+ * The byte after the struct is 'typeId', so we never hand back one class's
+ * state as another's (eg. if a method is called with the wrong 'this'). */
+void *jsvObjectNewNativeState(JsVar *obj, size_t size, unsigned char typeId) {
+  assert(jsvHasChildren(obj));
+  assert(typeId);
+  JsVar *state = jsvNewFlatStringOfLength((unsigned int)(size+1));
+  if (!state) return 0; // out of memory
+  char *ptr = jsvGetFlatStringPointer(state);
+  memset(ptr, 0, size);
+  ptr[size] = (char)typeId;
+  JsVar *name = jsvMakeIntoVariableName(jsvNewFromString(JSV_NATIVE_STATE_NAME), state);
+  jsvUnLock(state);
+  if (!name) return 0; // out of memory
+  name = jsvRef(name);
+  // link in right at the start
+  JsVarRef first = jsvGetFirstChild(obj);
+  if (first) {
+    JsVar *firstChild = jsvLock(first);
+    jsvSetPrevSibling(firstChild, jsvGetRef(name));
+    jsvUnLock(firstChild);
+    jsvSetNextSibling(name, first);
+  } else {
+    jsvSetLastChild(obj, jsvGetRef(name));
+  }
+  jsvSetFirstChild(obj, jsvGetRef(name));
+  jsvUnLock(name);
+  return ptr;
+}
+
+void *jsvObjectGetNativeState(JsVar *obj, size_t size, unsigned char typeId) {
+  JsVarRef stateRef = jsvObjectGetNativeStateRef(obj);
+  if (!stateRef) return 0;
+  JsVar *state = jsvGetAddressOfBorrowed(stateRef);
+  if (jsvGetStringLength(state)==size+1) {
+    char *ptr = jsvGetFlatStringPointer(state);
+    if ((unsigned char)ptr[size]==typeId) return ptr;
+  }
+  return 0;
+}
+
 int jsvGetChildren(JsVar *v) {
   //OPT: could length be stored as the value of the array?
   int children = 0;
@@ -2498,23 +2624,23 @@ size_t jsvCountJsVarsUsed(JsVar *v) {
 
 
 JsVar *jsvGetArrayItem(const JsVar *arr, JsVarInt index) {
+  /* Nothing in the search can allocate, so we just borrow each index
+   * and only lock the value we find */
   JsVarRef childref = jsvGetLastChild(arr);
   JsVarInt lastArrayIndex = 0;
   // Look at last non-string element!
   while (childref) {
-    JsVar *child = jsvLock(childref);
+    JsVar *child = jsvGetAddressOfBorrowed(childref);
     if (jsvIsInt(child)) {
       lastArrayIndex = child->varData.integer;
       // it was the last element... sorted!
       if (lastArrayIndex == index) {
-        return jsvSkipNameAndUnLock(child);
+        return jsvSkipName(child);
       }
-      jsvUnLock(child);
       break;
     }
     // if not an int, keep going
     childref = jsvGetPrevSibling(child);
-    jsvUnLock(child);
   }
   // it's not in this array - don't search the whole lot...
   if (index > lastArrayIndex)
@@ -2523,27 +2649,25 @@ JsVar *jsvGetArrayItem(const JsVar *arr, JsVarInt index) {
   if (index > lastArrayIndex/2) {
     // it's in the final half of the array (probably) - search backwards
     while (childref) {
-      JsVar *child = jsvLock(childref);
+      JsVar *child = jsvGetAddressOfBorrowed(childref);
 
       assert(jsvIsInt(child));
       if (child->varData.integer == index) {
-        return jsvSkipNameAndUnLock(child);
+        return jsvSkipName(child);
       }
       childref = jsvGetPrevSibling(child);
-      jsvUnLock(child);
     }
   } else {
     // it's in the first half of the array (probably) - search forwards
     childref = jsvGetFirstChild(arr);
     while (childref) {
-      JsVar *child = jsvLock(childref);
+      JsVar *child = jsvGetAddressOfBorrowed(childref);
 
       assert(jsvIsInt(child));
       if (child->varData.integer == index) {
-        return jsvSkipNameAndUnLock(child);
+        return jsvSkipName(child);
       }
       childref = jsvGetNextSibling(child);
-      jsvUnLock(child);
     }
   }
   return 0; // undefined
@@ -2571,8 +2695,33 @@ JsVar *jsvGetArrayIndexOf(JsVar *arr, JsVar *value, bool matchExact) {
   assert(jsvIsArray(arr) || jsvIsObject(arr));
   indexref = jsvGetFirstChild(arr);
   while (indexref) {
-    JsVar *childIndex = jsvLock(indexref);
+    JsVar *childIndex = jsvGetAddressOfBorrowed(indexref);
     assert(jsvIsName(childIndex));
+    indexref = jsvGetNextSibling(childIndex);
+    if (!jsvIsNameInt(childIndex) && !jsvIsNameIntBool(childIndex)) {
+      /* Fast path: borrow the value. Pointers, numbers and strings can all
+       * be compared without allocating, and a type mismatch is never equal */
+      JsVarRef childValueRef = jsvGetFirstChild(childIndex);
+      JsVar *childValue = childValueRef ? jsvGetAddressOfBorrowed(childValueRef) : 0;
+      if (childValue==value)
+        return jsvLockAgain(childIndex);
+      if (matchExact || !childValue || !value || jsvIsName(childValue))
+        continue;
+      if ((jsvIsInt(childValue)||jsvIsFloat(childValue)) && (jsvIsInt(value)||jsvIsFloat(value))) {
+        if (jsvIsBasicVarEqual(childValue, value))
+          return jsvLockAgain(childIndex);
+        continue;
+      }
+      if (jsvIsString(childValue) && jsvIsString(value)) {
+        if (jsvIsBasicVarEqual(childValue, value))
+          return jsvLockAgain(childIndex);
+        continue;
+      }
+      if ((childValue->flags & JSV_VARTYPEMASK) != (value->flags & JSV_VARTYPEMASK))
+        continue;
+    }
+    // Anything else may call valueOf, so do it properly with locks
+    jsvLockAgain(childIndex);
     JsVar *childValue = jsvSkipName(childIndex);
     if (childValue==value ||
         (!matchExact && jsvMathsOpTypeEqual(childValue, value))) {
@@ -2580,7 +2729,7 @@ JsVar *jsvGetArrayIndexOf(JsVar *arr, JsVar *value, bool matchExact) {
       return childIndex;
     }
     jsvUnLock(childValue);
-    indexref = jsvGetNextSibling(childIndex);
+    indexref = jsvGetNextSibling(childIndex); // the array may have changed
     jsvUnLock(childIndex);
   }
   return 0; // undefined
@@ -2788,6 +2937,25 @@ JsVar *jsvMathsOpSkipNames(JsVar *a, JsVar *b, int op) {
 }
 
 
+/** Is this a basic string that nothing references, and that only the caller
+ * has locked? If so it can be modified in place rather than copied. */
+bool jsvIsUnsharedString(JsVar *v) {
+  return jsvIsBasicString(v) && jsvGetRefs(v)==0 && jsvGetLocks(v)==1;
+}
+
+/** If a is an unshared string (eg. the result of a previous '+'), append
+ * b to it as `a+b` would and return true. If not, return false - and
+ * jsvMathsOp should be used to create a copy instead. */
+bool jsvMathsOpAppendInPlace(JsVar *a, JsVar *b) {
+  if (!jsvIsUnsharedString(a)) return false;
+  JsVar *pb = jsvSkipName(b);
+  JsVar *ob = jsvGetValueOf(pb);
+  JsVar *str = jsvAsString(ob, false);
+  if (str) jsvAppendStringVarComplete(a, str);
+  jsvUnLock3(pb, ob, str);
+  return true;
+}
+
 JsVar *jsvMathsOpError(int op, const char *datatype) {
   char opName[32];
   jslTokenAsString(op, opName, sizeof(opName));
@@ -2925,8 +3093,9 @@ JsVar *jsvMathsOp(JsVar *a, JsVar *b, int op) {
       return 0;
     }
     if (op=='+') {
-      JsVar *v = jsvCopy(da);
-      // TODO: can we be fancy and not copy da if we know it isn't reffed? what about locks?
+      /* If da was created just for us (eg. a number converted to a string)
+       * then we can append to it rather than copying it */
+      JsVar *v = jsvIsUnsharedString(da) ? jsvLockAgain(da) : jsvCopy(da);
       if (v) // could be out of memory
         jsvAppendStringVarComplete(v, db);
       jsvUnLock2(da, db);
@@ -3186,6 +3355,7 @@ bool jsvGarbageCollect() {
   JsVar firstVar; // temporary var to simplify code in the loop below
   jsvSetNextSibling(&firstVar, 0);
   JsVar *lastEmpty = &firstVar;
+  unsigned int freeCount = 0;
   for (i=1;i<=jsVarsSize;i++)  {
     JsVar *var = jsvGetAddressOf(i);
     if (var->flags & JSV_GARBAGE_COLLECT) {
@@ -3198,6 +3368,7 @@ bool jsvGarbageCollect() {
         // add this to our free list
         jsvSetNextSibling(lastEmpty, i);
         lastEmpty = var;
+        freeCount++;
         // free subsequent blocks
         while (count-- > 0) {
           i++;
@@ -3206,6 +3377,7 @@ bool jsvGarbageCollect() {
           // add this to our free list
           jsvSetNextSibling(lastEmpty, i);
           lastEmpty = var;
+          freeCount++;
         }
       } else {
         // otherwise just free 1 block
@@ -3243,6 +3415,7 @@ bool jsvGarbageCollect() {
         // add this to our free list
         jsvSetNextSibling(lastEmpty, i);
         lastEmpty = var;
+        freeCount++;
       }
     } else if (jsvIsFlatString(var)) {
       // if we have a flat string, skip forward that many blocks
@@ -3251,12 +3424,14 @@ bool jsvGarbageCollect() {
       // this is already free - add it to the free list
       jsvSetNextSibling(lastEmpty, i);
       lastEmpty = var;
+      freeCount++;
     }
   }
   /* Now find the first variable in our list, using
    * our fake 'firstVar' variable */
   jsvSetNextSibling(lastEmpty, 0);
   jsVarFirstEmpty = jsvGetNextSibling(&firstVar);
+  jsVarsUsed = jsVarsSize - freeCount;
   isMemoryBusy = false;
   return freedSomething;
 }
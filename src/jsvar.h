@@ -333,6 +333,11 @@ ALWAYS_INLINE JsVarRef jsvGetRef(JsVar *var);
 /// SCARY - only to be used for vital stuff like load/save
 ALWAYS_INLINE JsVar *_jsvGetAddressOf(JsVarRef ref);
 
+/** Return a pointer to the variable WITHOUT locking it (a 'borrowed' reference) - UNSAFE for null refs.
+ * This is only valid while something else keeps the variable alive (eg. a locked parent) and
+ * nothing is done that could allocate, GC or run JS. Never jsvUnLock the result. */
+ALWAYS_INLINE JsVar *jsvGetAddressOfBorrowed(JsVarRef ref);
+
 /// Lock this reference and return a pointer - UNSAFE for null refs
 ALWAYS_INLINE JsVar *jsvLock(JsVarRef ref);
 
@@ -627,6 +632,10 @@ JsVar *jsvAsName(JsVar *var);
 JsVar *jsvMathsOpSkipNames(JsVar *a, JsVar *b, int op);
 bool jsvMathsOpTypeEqual(JsVar *a, JsVar *b);
 JsVar *jsvMathsOp(JsVar *a, JsVar *b, int op);
+/// Is this a basic string that nothing references, and only the caller has locked? (so can be modified in place)
+bool jsvIsUnsharedString(JsVar *v);
+/// If a is an unshared string, append b to it as `a+b` would and return true. Otherwise return false
+bool jsvMathsOpAppendInPlace(JsVar *a, JsVar *b);
 /// Negates an integer/double value
 JsVar *jsvNegateAndUnLock(JsVar *v);
 
@@ -659,6 +668,12 @@ JsVar *jsvObjectGetChild(JsVar *obj, const char *name, JsVarFlags createChild);
 JsVar *jsvObjectSetChild(JsVar *obj, const char *name, JsVar *child);
 /// Set the named child of an object, and unlock the child
 void jsvObjectSetChildAndUnLock(JsVar *obj, const char *name, JsVar *child);
+/** Add a zeroed, hidden block of 'size' bytes of native state to an object, tagged with 'typeId'
+ * (non-zero). Returns a pointer to it (valid for as long as the object is) or 0. Must be called
+ * before anything else adds native state. See the "state" field of the JSON class definition */
+void *jsvObjectNewNativeState(JsVar *obj, size_t size, unsigned char typeId);
+/// Get the native state block from jsvObjectNewNativeState without searching, or 0 if there's none (or it's a different size or typeId)
+void *jsvObjectGetNativeState(JsVar *obj, size_t size, unsigned char typeId);
 
 int jsvGetChildren(JsVar *v); ///< number of children of a variable. also see jsvGetArrayLength and jsvGetLength
 JsVar *jsvGetFirstName(JsVar *v); ///< Get the first child's name from an object,array or function
@@ -140,41 +140,54 @@ unsigned int jsvIterateCallbackToBytes(JsVar *var, unsigned char *data, unsigned
 
 // --------------------------------------------------------------------------------------------
 
-void jsvStringIteratorNew(JsvStringIterator *it, JsVar *str, size_t startIdx) {
+/** Set up a string iterator at startIdx. If 'borrowed', no locks are taken on
+ * the string or any of its blocks (see jsvStringIteratorNewBorrowed) */
+static ALWAYS_INLINE void jsvStringIteratorInit(JsvStringIterator *it, JsVar *str, size_t startIdx, bool borrowed) {
   assert(jsvHasCharacterData(str));
-  it->var = jsvLockAgain(str);
+  it->var = borrowed ? str : jsvLockAgain(str);
   it->varIndex = 0;
   it->charsInVar = jsvGetCharactersInVar(str);
   it->charIdx = startIdx;
   if (jsvIsFlatString(str)) {
-    it->ptr = jsvGetFlatStringPointer(it->var);
+    it->ptr = jsvGetFlatStringPointer(str);
   } else if (jsvIsNativeString(str)) {
-    it->ptr = (char*)it->var->varData.nativeStr.ptr;
-  } else{
-    it->ptr = &it->var->varData.str[0];
+    it->ptr = (char*)str->varData.nativeStr.ptr;
+  } else {
+    it->ptr = &str->varData.str[0];
   }
   while (it->charIdx>0 && it->charIdx >= it->charsInVar) {
     it->charIdx -= it->charsInVar;
     it->varIndex += it->charsInVar;
-    if (it->var) {
-      if (jsvGetLastChild(it->var)) {
-        JsVar *next = jsvLock(jsvGetLastChild(it->var));
-        jsvUnLock(it->var);
-        it->var = next;
-        it->ptr = &next->varData.str[0];
-        it->charsInVar = jsvGetCharactersInVar(it->var);
+    if (it->var && jsvGetLastChild(it->var)) {
+      JsVar *next;
+      if (borrowed) {
+        next = jsvGetAddressOfBorrowed(jsvGetLastChild(it->var));
       } else {
+        next = jsvLock(jsvGetLastChild(it->var));
         jsvUnLock(it->var);
-        it->var = 0;
-        it->ptr = 0;
-        it->charsInVar = 0;
-        it->varIndex = startIdx - it->charIdx;
-        return; // at end of string - get out of loop
       }
+      it->var = next;
+      it->ptr = &next->varData.str[0];
+      it->charsInVar = jsvGetCharactersInVar(it->var);
+    } else {
+      if (!borrowed) jsvUnLock(it->var);
+      it->var = 0;
+      it->ptr = 0;
+      it->charsInVar = 0;
+      it->varIndex = startIdx - it->charIdx;
+      return; // at end of string - get out of loop
     }
   }
 }
 
+void jsvStringIteratorNew(JsvStringIterator *it, JsVar *str, size_t startIdx) {
+  jsvStringIteratorInit(it, str, startIdx, false);
+}
+
+void jsvStringIteratorNewBorrowed(JsvStringIterator *it, JsVar *str, size_t startIdx) {
+  jsvStringIteratorInit(it, str, startIdx, true);
+}
+
 JsvStringIterator jsvStringIteratorClone(JsvStringIterator *it) {
   JsvStringIterator i = *it;
   if (i.var) jsvLockAgain(i.var);
@@ -238,6 +251,39 @@ void jsvStringIteratorAppend(JsvStringIterator *it, char ch) {
   jsvSetCharactersInVar(it->var, it->charsInVar);
 }
 
+/// Append up to maxLength characters of str (starting at startIdx) TO THE END of a string iterator
+void jsvStringIteratorAppendString(JsvStringIterator *it, JsVar *str, size_t startIdx, size_t maxLength) {
+  JsvStringIterator sit;
+  jsvStringIteratorNew(&sit, str, startIdx);
+  while (jsvStringIteratorHasChar(&sit) && maxLength>0) {
+    // Append one character normally - this allocates a new StringExt if needed
+    jsvStringIteratorAppend(it, jsvStringIteratorGetChar(&sit));
+    if (!it->var) break; // out of memory
+    maxLength--;
+    /* Now copy whatever else fits in both the source and destination
+     * blocks directly, rather than going a character at a time */
+    size_t maxChars = jsvGetMaxCharactersInVar(it->var);
+    size_t n = sit.charsInVar - (sit.charIdx+1);
+    if (n > maxLength) n = maxLength;
+    if (it->charsInVar >= maxChars) n = 0; // full (or a flat string)
+    else if (n > maxChars - it->charsInVar) n = maxChars - it->charsInVar;
+    if (n) {
+      char *dst = &it->ptr[it->charIdx+1];
+      const char *src = &sit.ptr[sit.charIdx+1];
+      size_t i;
+      for (i=0;i<n;i++)
+        dst[i] = (char)READ_FLASH_UINT8(&src[i]);
+      it->charIdx += n;
+      it->charsInVar += n;
+      jsvSetCharactersInVar(it->var, it->charsInVar);
+      sit.charIdx += n;
+      maxLength -= n;
+    }
+    jsvStringIteratorNext(&sit);
+  }
+  jsvStringIteratorFree(&sit);
+}
+
 // --------------------------------------------------------------------------------------------
 
 void jsvObjectIteratorNew(JsvObjectIterator *it, JsVar *obj) {
@@ -428,6 +474,10 @@ void   jsvArrayBufferIteratorSetValue(JsvArrayBufferIterator *it, JsVar *value)
 
   if (JSV_ARRAYBUFFER_IS_FLOAT(it->type)) {
     jsvArrayBufferIteratorFloatToData(data, dataLen, it->type, jsvGetFloat(value));
+  } else if (JSV_ARRAYBUFFER_IS_CLAMPED(it->type)) {
+    // saturate from the float value, as the integer may already have wrapped around
+    JsVarFloat f = jsvGetFloat(value);
+    data[0] = (char)(!(f>0) ? 0 : (f>=255 ? 255 : (int)f));
   } else {
     jsvArrayBufferIteratorIntToData(data, dataLen, it->type, jsvGetInteger(value));
   }
@@ -45,6 +45,12 @@ typedef struct JsvStringIterator {
 /// Create a new String iterator from a string, starting from a specific character. NOTE: This does not keep a lock to the first element, so make sure you do or the string will be freed!
 void jsvStringIteratorNew(JsvStringIterator *it, JsVar *str, size_t startIdx);
 
+/** Create a new String iterator that 'borrows' the StringExts it passes rather than locking them.
+ * Only use this in native code that cannot allocate, GC or run JS while the iterator is in use
+ * (so nothing can free or change the string). Use jsvStringIteratorNextBorrowed to move on, and
+ * don't call jsvStringIteratorFree. */
+void jsvStringIteratorNewBorrowed(JsvStringIterator *it, JsVar *str, size_t startIdx);
+
 /// Clone the string iterator
 JsvStringIterator jsvStringIteratorClone(JsvStringIterator *it);
 
@@ -98,6 +104,23 @@ static ALWAYS_INLINE void jsvStringIteratorNextInline(JsvStringIterator *it) {
   }
 }
 
+/// Move to next character of an iterator created with jsvStringIteratorNewBorrowed
+static ALWAYS_INLINE void jsvStringIteratorNextBorrowed(JsvStringIterator *it) {
+  it->charIdx++;
+  if (it->charIdx >= it->charsInVar) {
+    it->charIdx -= it->charsInVar;
+    it->varIndex += it->charsInVar;
+    if (it->var && jsvGetLastChild(it->var)) {
+      it->var = jsvGetAddressOfBorrowed(jsvGetLastChild(it->var));
+      it->ptr = &it->var->varData.str[0];
+      it->charsInVar = jsvGetCharactersInVar(it->var);
+    } else {
+      it->var = 0;
+      it->ptr = 0;
+      it->charsInVar = 0;
+    }
+  }
+}
 
 /// Go to the end of the string iterator - for use with jsvStringIteratorAppend
 void jsvStringIteratorGotoEnd(JsvStringIterator *it);
@@ -105,6 +128,9 @@ void jsvStringIteratorGotoEnd(JsvStringIterator *it);
 /// Append a character TO THE END of a string iterator
 void jsvStringIteratorAppend(JsvStringIterator *it, char ch);
 
+/// Append up to maxLength characters of str (starting at startIdx) TO THE END of a string iterator
+void jsvStringIteratorAppendString(JsvStringIterator *it, JsVar *str, size_t startIdx, size_t maxLength);
+
 static ALWAYS_INLINE void jsvStringIteratorFree(JsvStringIterator *it) {
   jsvUnLock(it->var);
 }
@@ -134,6 +134,126 @@ Instantiate this in order to efficiently store arrays of data (Espruino's normal
  */
 
 
+/* Conversion kernels for copying between typed arrays whose data is contiguous
+ * (a flat string, or a single string block). There's one loop per (source type,
+ * destination type) pair so the compiler can do each conversion inline, and a
+ * straight memmove when the types are the same. Conversions match what the
+ * generic path does for a single element - floats are truncated (NaN and
+ * Infinity become 0) - except that Uint8ClampedArray saturates properly for
+ * values outside the range of an int. */
+
+/// Get a pointer to element 0 of a typed array if its data is contiguous and aligned, or 0
+static char *jswrap_arraybufferview_getData(JsVar *view) {
+  JsVarDataArrayBufferViewType type = view->varData.arraybuffer.type;
+  size_t elementSize = JSV_ARRAYBUFFER_GET_SIZE(type);
+  size_t byteOffset = view->varData.arraybuffer.byteOffset;
+  size_t byteLength = view->varData.arraybuffer.length * elementSize;
+  JsVar *str = jsvGetArrayBufferBackingString(view);
+  char *data = 0;
+  if (jsvIsFlatString(str)) {
+    if (byteOffset+byteLength <= jsvGetCharactersInVar(str))
+      data = jsvGetFlatStringPointer(str) + byteOffset;
+  } else if (!jsvIsNativeString(str) && !jsvGetLastChild(str) &&
+             byteOffset+byteLength <= jsvGetCharactersInVar(str)) {
+    data = &str->varData.str[byteOffset]; // it all fits in one block
+  }
+  jsvUnLock(str); // still referenced by the view, so this stays valid while the view is locked
+  if (data && ((size_t)data & (elementSize-1))) data = 0; // unaligned
+  return data;
+}
+
+static ALWAYS_INLINE long long jswrap_arraybufferview_floatToInt(double f) {
+  return isfinite(f) ? (long long)f : 0;
+}
+static ALWAYS_INLINE uint8_t jswrap_arraybufferview_clampInt(long long v) {
+  return (uint8_t)(v<0 ? 0 : (v>255 ? 255 : v));
+}
+static ALWAYS_INLINE uint8_t jswrap_arraybufferview_clampFloat(double f) {
+  return (uint8_t)(!(f>0) ? 0 : (f>=255 ? 255 : (int)f));
+}
+
+#define JSWRAP_ABV_LOOP(SRCTYPE, DSTTYPE, CONVERT) { \
+    const SRCTYPE *s = (const SRCTYPE*)src; \
+    DSTTYPE *d = (DSTTYPE*)dst; \
+    size_t i; \
+    for (i=0;i<count;i++) { SRCTYPE v = s[i]; d[i] = (DSTTYPE)(CONVERT); } \
+    return; }
+
+/// Every destination for an integer source type
+#define JSWRAP_ABV_FROM_INT(SRCTYPE) \
+    switch ((int)dstType) { \
+    case ARRAYBUFFERVIEW_ARRAYBUFFER: \
+    case ARRAYBUFFERVIEW_UINT8: JSWRAP_ABV_LOOP(SRCTYPE, uint8_t, v); \
+    case ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED: JSWRAP_ABV_LOOP(SRCTYPE, uint8_t, jswrap_arraybufferview_clampInt(v)); \
+    case ARRAYBUFFERVIEW_INT8: JSWRAP_ABV_LOOP(SRCTYPE, int8_t, v); \
+    case ARRAYBUFFERVIEW_UINT16: JSWRAP_ABV_LOOP(SRCTYPE, uint16_t, v); \
+    case ARRAYBUFFERVIEW_INT16: JSWRAP_ABV_LOOP(SRCTYPE, int16_t, v); \
+    case ARRAYBUFFERVIEW_UINT32: JSWRAP_ABV_LOOP(SRCTYPE, uint32_t, v); \
+    case ARRAYBUFFERVIEW_INT32: JSWRAP_ABV_LOOP(SRCTYPE, int32_t, v); \
+    case ARRAYBUFFERVIEW_FLOAT32: JSWRAP_ABV_LOOP(SRCTYPE, float, v); \
+    case ARRAYBUFFERVIEW_FLOAT64: JSWRAP_ABV_LOOP(SRCTYPE, double, v); \
+    default: break; \
+    }
+
+/// Every destination for a floating point source type
+#define JSWRAP_ABV_FROM_FLOAT(SRCTYPE) \
+    switch ((int)dstType) { \
+    case ARRAYBUFFERVIEW_ARRAYBUFFER: \
+    case ARRAYBUFFERVIEW_UINT8: JSWRAP_ABV_LOOP(SRCTYPE, uint8_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED: JSWRAP_ABV_LOOP(SRCTYPE, uint8_t, jswrap_arraybufferview_clampFloat(v)); \
+    case ARRAYBUFFERVIEW_INT8: JSWRAP_ABV_LOOP(SRCTYPE, int8_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_UINT16: JSWRAP_ABV_LOOP(SRCTYPE, uint16_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_INT16: JSWRAP_ABV_LOOP(SRCTYPE, int16_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_UINT32: JSWRAP_ABV_LOOP(SRCTYPE, uint32_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_INT32: JSWRAP_ABV_LOOP(SRCTYPE, int32_t, jswrap_arraybufferview_floatToInt(v)); \
+    case ARRAYBUFFERVIEW_FLOAT32: JSWRAP_ABV_LOOP(SRCTYPE, float, v); \
+    case ARRAYBUFFERVIEW_FLOAT64: JSWRAP_ABV_LOOP(SRCTYPE, double, v); \
+    default: break; \
+    }
+
+static void jswrap_arraybufferview_convert(char *dst, JsVarDataArrayBufferViewType dstType, const char *src, JsVarDataArrayBufferViewType srcType, size_t count) {
+  switch ((int)srcType) {
+  case ARRAYBUFFERVIEW_ARRAYBUFFER:
+  case ARRAYBUFFERVIEW_UINT8:
+  case ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED: JSWRAP_ABV_FROM_INT(uint8_t); break;
+  case ARRAYBUFFERVIEW_INT8: JSWRAP_ABV_FROM_INT(int8_t); break;
+  case ARRAYBUFFERVIEW_UINT16: JSWRAP_ABV_FROM_INT(uint16_t); break;
+  case ARRAYBUFFERVIEW_INT16: JSWRAP_ABV_FROM_INT(int16_t); break;
+  case ARRAYBUFFERVIEW_UINT32: JSWRAP_ABV_FROM_INT(uint32_t); break;
+  case ARRAYBUFFERVIEW_INT32: JSWRAP_ABV_FROM_INT(int32_t); break;
+  case ARRAYBUFFERVIEW_FLOAT32: JSWRAP_ABV_FROM_FLOAT(float); break;
+  case ARRAYBUFFERVIEW_FLOAT64: JSWRAP_ABV_FROM_FLOAT(double); break;
+  default: break;
+  }
+  assert(0);
+}
+
+/** Copy 'count' elements from src[srcIndex] to dst[dstIndex] (both typed arrays) with a conversion
+ * kernel. Returns false if we can't (the data isn't contiguous, or it overlaps and needs converting) -
+ * in which case the caller must use the generic path */
+static bool jswrap_arraybufferview_copy(JsVar *dst, size_t dstIndex, JsVar *src, size_t srcIndex, size_t count) {
+  char *dstData = jswrap_arraybufferview_getData(dst);
+  char *srcData = dstData ? jswrap_arraybufferview_getData(src) : 0;
+  if (!srcData) return false;
+  JsVarDataArrayBufferViewType dstType = dst->varData.arraybuffer.type;
+  JsVarDataArrayBufferViewType srcType = src->varData.arraybuffer.type;
+  size_t dstSize = JSV_ARRAYBUFFER_GET_SIZE(dstType);
+  size_t srcSize = JSV_ARRAYBUFFER_GET_SIZE(srcType);
+  dstData += dstIndex*dstSize;
+  srcData += srcIndex*srcSize;
+  // An ArrayBuffer is just bytes, and clamping makes no difference when copying Uint8 to Uint8
+  JsVarDataArrayBufferViewType dstBase = (dstType==ARRAYBUFFERVIEW_ARRAYBUFFER) ? ARRAYBUFFERVIEW_UINT8 : (dstType & ~ARRAYBUFFERVIEW_CLAMPED);
+  JsVarDataArrayBufferViewType srcBase = (srcType==ARRAYBUFFERVIEW_ARRAYBUFFER) ? ARRAYBUFFERVIEW_UINT8 : (srcType & ~ARRAYBUFFERVIEW_CLAMPED);
+  if (dstBase == srcBase) {
+    memmove(dstData, srcData, count*dstSize);
+    return true;
+  }
+  if (dstData < srcData+count*srcSize && srcData < dstData+count*dstSize)
+    return false; // overlapping, so converting in place would overwrite source data
+  jswrap_arraybufferview_convert(dstData, dstType, srcData, srcType, count);
+  return true;
+}
+
 /*JSON{
   "type" : "constructor",
   "class" : "ArrayBuffer",
@@ -345,7 +465,10 @@ JsVar *jswrap_typedarray_constructor(JsVarDataArrayBufferViewType type, JsVar *a
     typedArr->varData.arraybuffer.length = (unsigned short)length;
     jsvSetFirstChild(typedArr, jsvGetRef(jsvRef(arrayBuffer)));
 
-    if (copyData) {
+    if (copyData && jsvIsArrayBuffer(arr) &&
+        jswrap_arraybufferview_copy(typedArr, 0, arr, 0, (size_t)length)) {
+      // copied from another typed array with a conversion kernel
+    } else if (copyData) {
       // if we were given an array, populate this ArrayBuffer
       JsvIterator it;
       jsvIteratorNew(&it, arr);
@@ -413,12 +536,21 @@ void jswrap_arraybufferview_set(JsVar *parent, JsVar *arr, int offset) {
     jsExceptionHere(JSET_ERROR, "Expecting first argument to be an array, not %t", arr);
     return;
   }
+  if (jsvIsArrayBuffer(arr) && offset>=0) {
+    // both typed arrays - try and copy with a conversion kernel
+    size_t dstLength = parent->varData.arraybuffer.length;
+    size_t count = arr->varData.arraybuffer.length;
+    if ((size_t)offset > dstLength) count = 0;
+    else if (count > dstLength-(size_t)offset) count = dstLength-(size_t)offset;
+    if (jswrap_arraybufferview_copy(parent, (size_t)offset, arr, 0, count))
+      return;
+  }
   JsvIterator itsrc;
   jsvIteratorNew(&itsrc, arr);
   JsvArrayBufferIterator itdst;
   jsvArrayBufferIteratorNew(&itdst, parent, (size_t)offset);
 
-  bool useInts = !JSV_ARRAYBUFFER_IS_FLOAT(itdst.type) || jsvIsString(arr);
+  bool useInts = !(JSV_ARRAYBUFFER_IS_FLOAT(itdst.type) || JSV_ARRAYBUFFER_IS_CLAMPED(itdst.type)) || jsvIsString(arr);
 
   while (jsvIteratorHasElement(&itsrc) && jsvArrayBufferIteratorHasElement(&itdst)) {
     if (useInts) {
@@ -473,37 +605,78 @@ JsVar *jswrap_arraybufferview_map(JsVar *parent, JsVar *funcVar, JsVar *thisVar)
   if (!array) return 0;
 
   // now iterate
-  JsvIterator it; // TODO: if we really are limited to ArrayBuffers, this could be an ArrayBufferIterator.
-  jsvIteratorNew(&it, parent);
+  JsvArrayBufferIterator it;
+  jsvArrayBufferIteratorNew(&it, parent, 0);
   JsvArrayBufferIterator itdst;
   jsvArrayBufferIteratorNew(&itdst, array, 0);
 
-  while (jsvIteratorHasElement(&it)) {
-    JsVar *index = jsvIteratorGetKey(&it);
-    if (jsvIsInt(index)) {
-      JsVarInt idxValue = jsvGetInteger(index);
-
-      JsVar *args[3], *mapped;
-      args[0] = jsvIteratorGetValue(&it);
-      args[1] = jsvNewFromInteger(idxValue); // child is a variable name, create a new variable for the index
-      args[2] = parent;
-      mapped = jspeFunctionCall(funcVar, 0, thisVar, false, 3, args);
-      jsvUnLockMany(2,args);
-      if (mapped) {
-        jsvArrayBufferIteratorSetValue(&itdst, mapped);
-        jsvUnLock(mapped);
-      }
+  while (jsvArrayBufferIteratorHasElement(&it)) {
+    JsVar *args[3], *mapped;
+    args[0] = jsvArrayBufferIteratorGetValue(&it);
+    args[1] = jsvArrayBufferIteratorGetIndex(&it);
+    args[2] = parent;
+    mapped = jspeFunctionCall(funcVar, 0, thisVar, false, 3, args);
+    jsvUnLockMany(2,args);
+    if (mapped) {
+      jsvArrayBufferIteratorSetValue(&itdst, mapped);
+      jsvUnLock(mapped);
     }
-    jsvUnLock(index);
-    jsvIteratorNext(&it);
+    jsvArrayBufferIteratorNext(&it);
     jsvArrayBufferIteratorNext(&itdst);
   }
-  jsvIteratorFree(&it);
+  jsvArrayBufferIteratorFree(&it);
   jsvArrayBufferIteratorFree(&itdst);
 
   return array;
 }
 
+/*JSON{
+  "type" : "method",
+  "class" : "ArrayBufferView",
+  "name" : "slice",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_arraybufferview_slice",
+  "params" : [
+    ["start","int","Start index"],
+    ["end","JsVar","End index (optional)"]
+  ],
+  "return" : ["JsVar","A new array"],
+  "return_object" : "ArrayBufferView"
+}
+Return a copy of a portion of this array (in a new array of the same type).
+ */
+JsVar *jswrap_arraybufferview_slice(JsVar *parent, JsVarInt start, JsVar *endVar) {
+  if (!jsvIsArrayBuffer(parent)) {
+    jsExceptionHere(JSET_ERROR, "ArrayBufferView.slice can only be called on an ArrayBufferView");
+    return 0;
+  }
+  JsVarInt len = (JsVarInt)parent->varData.arraybuffer.length;
+  JsVarInt end = jsvIsUndefined(endVar) ? len : jsvGetInteger(endVar);
+  if (start<0) start = (len+start > 0) ? len+start : 0;
+  else if (start>len) start = len;
+  if (end<0) end = (len+end > 0) ? len+end : 0;
+  else if (end>len) end = len;
+  JsVarInt count = (end>start) ? end-start : 0;
+
+  JsVar *array = jsvNewTypedArray(parent->varData.arraybuffer.type, count);
+  if (!array || !count) return array;
+  if (!jswrap_arraybufferview_copy(array, 0, parent, (size_t)start, (size_t)count)) {
+    JsvArrayBufferIterator it, itdst;
+    jsvArrayBufferIteratorNew(&it, parent, (size_t)start);
+    jsvArrayBufferIteratorNew(&itdst, array, 0);
+    while (jsvArrayBufferIteratorHasElement(&itdst)) {
+      JsVar *v = jsvArrayBufferIteratorGetValue(&it);
+      jsvArrayBufferIteratorSetValue(&itdst, v);
+      jsvUnLock(v);
+      jsvArrayBufferIteratorNext(&it);
+      jsvArrayBufferIteratorNext(&itdst);
+    }
+    jsvArrayBufferIteratorFree(&it);
+    jsvArrayBufferIteratorFree(&itdst);
+  }
+  return array;
+}
+
 
 // -----------------------------------------------------------------------------------------------------
 //                                                                      Steal Array's methods for this
@@ -600,20 +773,4 @@ Fill this array with the given value, for every index `>= start` and `< end`
 }
 Reverse the contents of this arraybuffer in-place
  */
-/*JSON{
-  "type" : "method",
-  "class" : "ArrayBufferView",
-  "name" : "slice",
-  "ifndef" : "SAVE_ON_FLASH",
-  "generate" : "jswrap_array_slice",
-  "params" : [
-    ["start","int","Start index"],
-    ["end","JsVar","End index (optional)"]
-  ],
-  "return" : ["JsVar","A new array"],
-  "return_object" : "Array"
-}
-Return a copy of a portion of this array (in a new array).
 
- **Note:** This currently returns a normal Array, not an ArrayBuffer
- */
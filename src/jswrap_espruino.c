@@ -616,6 +616,60 @@ JsVar *jswrap_espruino_getErrorFlags() {
   return arr;
 }
 
+/*JSON{
+  "type" : "event",
+  "class" : "E",
+  "name" : "lowMemory",
+  "params" : [
+    ["level","int","How low memory is - 1 is the first threshold (10% free by default), 2 the next (3%), and so on"]
+  ]
+}
+This event is called when the amount of free memory drops below one of the
+thresholds set with `E.setLowMemoryThresholds`. It's called each time a new
+(lower) threshold is passed, and only once for each threshold until free
+memory has risen a little (2%) above it again.
+
+Use this to free anything you can regenerate (caches, buffers, loaded modules)
+*before* Espruino actually runs out of memory:
+
+```
+E.on('lowMemory', function(level) {
+  myCache = {};
+  if (level>1) Modules.removeAllCached();
+});
+```
+ */
+
+/*JSON{
+  "type" : "staticmethod",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "E",
+  "name" : "setLowMemoryThresholds",
+  "generate" : "jswrap_espruino_setLowMemoryThresholds",
+  "params" : [
+    ["thresholds","JsVar","An array of percentages of free memory, highest first (eg. `[20,10,5]`), or undefined for the default of `[10,3]`"]
+  ]
+}
+Set the percentages of free memory at which `E.on('lowMemory', ...)` is
+called. The level passed to the event is the number of thresholds that free
+memory is currently below. Up to 4 thresholds can be given. `reset()` puts
+back the defaults.
+ */
+void jswrap_espruino_setLowMemoryThresholds(JsVar *thresholds) {
+  if (jsvIsUndefined(thresholds)) {
+    jsiSetLowMemoryThresholds(0);
+    return;
+  }
+  if (!jsvIsIterable(thresholds)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting an array, got %t", thresholds);
+    return;
+  }
+  unsigned char t[JSI_LOW_MEMORY_LEVELS];
+  memset(t, 0, sizeof(t));
+  jsvIterateCallbackToBytes(thresholds, t, sizeof(t));
+  jsiSetLowMemoryThresholds(t);
+}
+
 /*JSON{
   "type" : "staticmethod",
   "class" : "E",
@@ -27,6 +27,7 @@ JsVarFloat jswrap_espruino_interpolate2d(JsVar *array, int width, JsVarFloat x,
 
 void jswrap_espruino_enableWatchdog(JsVarFloat time);
 JsVar *jswrap_espruino_getErrorFlags();
+void jswrap_espruino_setLowMemoryThresholds(JsVar *thresholds);
 JsVar *jswrap_espruino_toArrayBuffer(JsVar *str);
 JsVar *jswrap_espruino_toUint8Array(JsVar *args);
 JsVar *jswrap_espruino_toString(JsVar *args);
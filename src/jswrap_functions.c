@@ -55,6 +55,95 @@ JsVar *jswrap_arguments() {
 }
 Creates a function
  */
+#ifndef SAVE_ON_FLASH
+/* A small cache of code that has been passed to new Function(), keyed on a
+ * hash of the source text. Each entry is a copy of the source - flat where
+ * it's big enough - that is shared between every Function created from the
+ * same text, so code that keeps building functions from received or
+ * concatenated strings only stores each one once.
+ *
+ * This saves memory, not time. Espruino parses code as it executes it, so
+ * calling a Function still lexes and parses its body every time, and hashing
+ * and comparing the source makes new Function() itself slower. eval() doesn't
+ * use the cache, as it doesn't keep its code so there's nothing to share.
+ *
+ * It's emptied by jsiFreeMoreMemory when we run low on memory, and on reset. */
+static unsigned int functionCacheHits = 0;
+static unsigned int functionCacheMisses = 0;
+
+static JsVarInt jswrap_function_cache_hash(JsVar *str) {
+  unsigned int h = 0;
+  JsvStringIterator it;
+  jsvStringIteratorNewBorrowed(&it, str, 0);
+  while (jsvStringIteratorHasChar(&it)) {
+    h = h*31 + (unsigned char)jsvStringIteratorGetChar(&it);
+    jsvStringIteratorNextBorrowed(&it);
+  }
+  return (JsVarInt)(h & 0x7FFFFFFF);
+}
+
+JsVar *jswrap_function_cache_get(JsVar *code) {
+  assert(jsvIsString(code) && !jsvIsName(code));
+  size_t len = jsvGetStringLength(code);
+  if (len > FUNCTION_CACHE_MAX_LENGTH) return 0;
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, FUNCTION_CACHE_NAME, JSV_OBJECT);
+  if (!cache) return 0;
+  JsVarInt hash = jswrap_function_cache_hash(code);
+  // Look for it - nothing here allocates, so we can just borrow each entry
+  JsVar *prepared = 0;
+  int entries = 0;
+  JsVarRef childref = jsvGetFirstChild(cache);
+  while (childref) {
+    JsVar *child = jsvGetAddressOfBorrowed(childref);
+    if (child->varData.integer == hash && jsvGetFirstChild(child)) {
+      JsVar *entry = jsvGetAddressOfBorrowed(jsvGetFirstChild(child));
+      if (entry==code ||
+          (jsvGetStringLength(entry)==len && jsvCompareString(entry, code, 0, 0, false)==0)) {
+        prepared = jsvLockAgain(entry);
+        break;
+      }
+    }
+    entries++;
+    childref = jsvGetNextSibling(child);
+  }
+  if (prepared) {
+    functionCacheHits++;
+  } else {
+    functionCacheMisses++;
+    // Not found - make a flat copy (unless it's small, or flat already) and add it
+    if (jsvIsFlatString(code) || jsvIsNativeString(code) || len <= JSV_FLAT_STRING_BREAK_EVEN)
+      prepared = jsvLockAgain(code);
+    else
+      prepared = jsvAsFlatString(code);
+    if (prepared) {
+      // Throw out the oldest entry if we're full
+      if (entries >= FUNCTION_CACHE_SIZE) {
+        JsVar *oldest = jsvLock(jsvGetFirstChild(cache));
+        jsvRemoveChild(cache, oldest);
+        jsvUnLock(oldest);
+      }
+      JsVar *name = jsvMakeIntoVariableName(jsvNewFromInteger(hash), prepared);
+      if (name) {
+        jsvAddName(cache, name);
+        jsvUnLock(name);
+      }
+    }
+  }
+  jsvUnLock(cache);
+  return prepared;
+}
+
+bool jswrap_function_cache_flush() {
+  JsVar *cacheName = jsvFindChildFromString(execInfo.hiddenRoot, FUNCTION_CACHE_NAME, false);
+  if (!cacheName) return false;
+  JsVar *cache = jsvSkipName(cacheName);
+  bool hadEntries = cache && jsvGetFirstChild(cache)!=0;
+  jsvRemoveChild(execInfo.hiddenRoot, cacheName);
+  jsvUnLock2(cache, cacheName);
+  return hadEntries;
+}
+#endif
+
 JsVar *jswrap_function_constructor(JsVar *args) {
   JsVar *fn = jsvNewWithFlags(JSV_FUNCTION);
   if (!fn) return 0;
@@ -85,6 +174,16 @@ JsVar *jswrap_function_constructor(JsVar *args) {
     jsvObjectIteratorNext(&it);
   }
   jsvObjectIteratorFree(&it);
+#ifndef SAVE_ON_FLASH
+  // Functions created from the same source can all share one copy of the code
+  if (jsvIsString(v)) {
+    JsVar *code = jswrap_function_cache_get(v);
+    if (code) {
+      jsvUnLock(v);
+      v = code;
+    }
+  }
+#endif
   jsvObjectSetChildAndUnLock(fn, JSPARSE_FUNCTION_CODE_NAME, v);
   return fn;
 }
@@ -108,6 +207,44 @@ JsVar *jswrap_eval(JsVar *v) {
   return result;
 }
 
+/*JSON{
+  "type" : "kill",
+  "generate" : "jswrap_function_cache_kill",
+  "ifndef" : "SAVE_ON_FLASH"
+}*/
+void jswrap_function_cache_kill() {
+  // don't save cached code
+  jswrap_function_cache_flush();
+}
+
+/*JSON{
+  "type" : "staticmethod",
+  "class" : "E",
+  "name" : "getFunctionCacheStats",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_function_cache_getStats",
+  "return" : ["JsVar","An object containing `hits`, `misses` and `size`"]
+}
+Return information on how well the cache of code passed to `new Function`
+is working. `hits` and `misses` count lookups since startup, and `size` is the
+number of entries currently in the cache.
+
+Functions created from the same source text share one copy of it, which
+saves memory - but each Function's code is still parsed whenever it is called.
+
+The cache is cleared automatically if memory gets low.
+ */
+JsVar *jswrap_function_cache_getStats() {
+  JsVar *o = jsvNewObject();
+  if (!o) return 0;
+  jsvObjectSetChildAndUnLock(o, "hits", jsvNewFromInteger((JsVarInt)functionCacheHits));
+  jsvObjectSetChildAndUnLock(o, "misses", jsvNewFromInteger((JsVarInt)functionCacheMisses));
+  JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, FUNCTION_CACHE_NAME, 0);
+  jsvObjectSetChildAndUnLock(o, "size", jsvNewFromInteger(cache ? jsvGetChildren(cache) : 0));
+  jsvUnLock(cache);
+  return o;
+}
+
 /*JSON{
   "type" : "function",
   "name" : "parseInt",
@@ -199,23 +336,68 @@ bool jswrap_isNaN(JsVar *v) {
 }
 
 
-NO_INLINE static int jswrap_btoa_encode(int c) {
-  c = c & 0x3F;
-  if (c<26) return 'A'+c;
-  if (c<52) return 'a'+c-26;
-  if (c<62) return '0'+c-52;
-  if (c==62) return '+';
-  return '/'; // c==63
+static const char jswrap_btoa_chars[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// base64 character -> sextet, or -1 if not a base64 character (only valid for c<128)
+static const signed char jswrap_atob_sextets[128] = {
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63, // +,/
+  52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-1,-1,-1, // 0-9
+  -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14, // A-O
+  15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1, // P-Z
+  -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40, // a-o
+  41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1, // p-z
+};
+
+static ALWAYS_INLINE int jswrap_atob_decode(char c) {
+  if ((unsigned char)c >= 128) return -1;
+  return jswrap_atob_sextets[(unsigned char)c];
+}
+
+/// Bitmap of the characters (<128) that encodeURIComponent leaves as-is: alphanumerics and `- _ . ! ~ * ' ( )`
+static const uint32_t jswrap_uri_unreserved[4] = {
+  0x00000000, 0x03FF6782, 0x87FFFFFE, 0x47FFFFFE
+};
+
+static const char jswrap_uri_hexChars[16] = "0123456789ABCDEF";
+
+static ALWAYS_INLINE bool jswrap_uri_isUnreserved(char c) {
+  unsigned char u = (unsigned char)c;
+  return u<128 && (jswrap_uri_unreserved[u>>5] & (1U<<(u&31)));
 }
 
-NO_INLINE static int jswrap_atob_decode(int c) {
-  c = c & 0xFF;
-  if (c>='A' && c<='Z') return c-'A';
-  if (c>='a' && c<='z') return 26+c-'a';
-  if (c>='0' && c<='9') return 52+c-'0';
-  if (c=='+') return 62;
-  if (c=='/') return 63;
-  return -1; // not found
+/** Create a string that is exactly byteLength long - flat if it's big enough to be worth it.
+ * The codecs below work out their output size first, so can write straight into this rather
+ * than growing a string as they go. */
+static JsVar *jswrap_newStringOfLength(size_t byteLength) {
+  JsVar *v = 0;
+  if (byteLength > JSV_FLAT_STRING_BREAK_EVEN)
+    v = jsvNewFlatStringOfLength((unsigned int)byteLength);
+  if (!v) v = jsvNewStringOfLength((unsigned int)byteLength);
+  return v;
+}
+
+/** The codecs below check for Ctrl-C once every this many (+1) iterations of their
+ * inner loops - often enough to stay responsive on huge strings, but not per character */
+#define JSWRAP_CODEC_INTERRUPT_MASK 255
+
+static ALWAYS_INLINE bool jswrap_codecInterrupted(unsigned int *n) {
+  return !((*n)++ & JSWRAP_CODEC_INTERRUPT_MASK) && jspIsInterrupted();
+}
+
+static ALWAYS_INLINE void jswrap_putChar(JsvStringIterator *dst, char ch) {
+  jsvStringIteratorSetChar(dst, ch);
+  jsvStringIteratorNextInline(dst);
+}
+
+/// Write 4 base64 characters for up to 3 bytes of data. padding is the number of missing bytes
+static ALWAYS_INLINE void jswrap_btoa_putTriple(JsvStringIterator *dst, unsigned int triple, int padding) {
+  jswrap_putChar(dst, jswrap_btoa_chars[(triple >> 18) & 63]);
+  jswrap_putChar(dst, jswrap_btoa_chars[(triple >> 12) & 63]);
+  jswrap_putChar(dst, (padding>1) ? '=' : jswrap_btoa_chars[(triple >> 6) & 63]);
+  jswrap_putChar(dst, (padding>0) ? '=' : jswrap_btoa_chars[triple & 63]);
 }
 
 /*JSON{
@@ -229,51 +411,124 @@ NO_INLINE static int jswrap_atob_decode(int c) {
   "return" : ["JsVar","A base64 encoded string"]
 }
 Encode the supplied string (or array) into a base64 string
+
+Large amounts of data can be encoded in chunks, as long as every chunk
+except the last is a multiple of 3 bytes long - the results can then just be
+concatenated (or sent) one after the other.
  */
 JsVar *jswrap_btoa(JsVar *binaryData) {
   if (!jsvIsIterable(binaryData)) {
     jsExceptionHere(JSET_ERROR, "Expecting a string or array, got %t", binaryData);
     return 0;
   }
-  JsVar* base64Data = jsvNewFromEmptyString();
+  // Strings and byte arrays can be read directly, anything else goes through an iterator
+  bool isBytes = jsvIsString(binaryData) ||
+      (jsvIsArrayBuffer(binaryData) && JSV_ARRAYBUFFER_GET_SIZE(binaryData->varData.arraybuffer.type)==1);
+  size_t srcLen = 0;
+  const char *srcPtr = isBytes ? jsvGetDataPointer(binaryData, &srcLen) : 0;
+  if (!srcPtr) {
+    if (jsvIsString(binaryData)) {
+      srcLen = jsvGetStringLength(binaryData);
+    } else {
+      JsvIterator it;
+      jsvIteratorNew(&it, binaryData);
+      while (jsvIteratorHasElement(&it) && !jspIsInterrupted()) {
+        srcLen++;
+        jsvIteratorNext(&it);
+      }
+      jsvIteratorFree(&it);
+    }
+  }
+
+  if (jspIsInterrupted()) return 0;
+  unsigned int checks = 1;
+  JsVar* base64Data = jswrap_newStringOfLength(((srcLen+2)/3)*4);
   if (!base64Data) return 0;
-  JsvIterator itsrc;
   JsvStringIterator itdst;
-  jsvIteratorNew(&itsrc, binaryData);
   jsvStringIteratorNew(&itdst, base64Data, 0);
 
-
-  int padding = 0;
-  while (jsvIteratorHasElement(&itsrc) && !jspIsInterrupted()) {
-    int octet_a = (unsigned char)jsvIteratorGetIntegerValue(&itsrc)&255;
-    jsvIteratorNext(&itsrc);
-    int octet_b = 0, octet_c = 0;
-    if (jsvIteratorHasElement(&itsrc)) {
-      octet_b = jsvIteratorGetIntegerValue(&itsrc)&255;
-      jsvIteratorNext(&itsrc);
-      if (jsvIteratorHasElement(&itsrc)) {
-        octet_c = jsvIteratorGetIntegerValue(&itsrc)&255;
+  size_t i = 0;
+  if (srcPtr) {
+    const unsigned char *src = (const unsigned char *)srcPtr;
+    for (i=0; i+3<=srcLen && !jswrap_codecInterrupted(&checks); i+=3) {
+      unsigned int triple = ((unsigned int)READ_FLASH_UINT8(&src[i]) << 16) |
+                            ((unsigned int)READ_FLASH_UINT8(&src[i+1]) << 8) |
+                            (unsigned int)READ_FLASH_UINT8(&src[i+2]);
+      jswrap_btoa_putTriple(&itdst, triple, 0);
+    }
+    if (i<srcLen && srcLen-i<3) {
+      unsigned int triple = (unsigned int)READ_FLASH_UINT8(&src[i]) << 16;
+      if (i+1<srcLen) triple |= (unsigned int)READ_FLASH_UINT8(&src[i+1]) << 8;
+      jswrap_btoa_putTriple(&itdst, triple, (int)(3-(srcLen-i)));
+    }
+  } else if (jsvIsString(binaryData)) {
+    // Nothing in here allocates, so we can borrow the source string's blocks
+    JsvStringIterator itsrc;
+    jsvStringIteratorNewBorrowed(&itsrc, binaryData, 0);
+    while (i<srcLen && !jswrap_codecInterrupted(&checks)) {
+      unsigned int triple = 0;
+      int n;
+      for (n=0;n<3 && i<srcLen;n++,i++) {
+        triple |= (unsigned int)(unsigned char)jsvStringIteratorGetChar(&itsrc) << (16-n*8);
+        jsvStringIteratorNextBorrowed(&itsrc);
+      }
+      jswrap_btoa_putTriple(&itdst, triple, 3-n);
+    }
+  } else {
+    JsvIterator itsrc;
+    jsvIteratorNew(&itsrc, binaryData);
+    while (jsvIteratorHasElement(&itsrc) && !jspIsInterrupted()) {
+      unsigned int triple = 0;
+      int n;
+      for (n=0;n<3 && jsvIteratorHasElement(&itsrc);n++) {
+        triple |= (unsigned int)(jsvIteratorGetIntegerValue(&itsrc)&255) << (16-n*8);
         jsvIteratorNext(&itsrc);
-        padding = 0;
-      } else
-        padding = 1;
-    } else
-      padding = 2;
-
-    int triple = (octet_a << 0x10) + (octet_b << 0x08) + octet_c;
-
-    jsvStringIteratorAppend(&itdst, (char)jswrap_btoa_encode(triple >> 18));
-    jsvStringIteratorAppend(&itdst, (char)jswrap_btoa_encode(triple >> 12));
-    jsvStringIteratorAppend(&itdst, (char)((padding>1)?'=':jswrap_btoa_encode(triple >> 6)));
-    jsvStringIteratorAppend(&itdst, (char)((padding>0)?'=':jswrap_btoa_encode(triple)));
+      }
+      jswrap_btoa_putTriple(&itdst, triple, 3-n);
+    }
+    jsvIteratorFree(&itsrc);
   }
 
-  jsvIteratorFree(&itsrc);
   jsvStringIteratorFree(&itdst);
-
   return base64Data;
 }
 
+/** Decode base64 from the iterator (skipping any leading whitespace). If dst is 0,
+ * just return how many bytes would have been written */
+static size_t jswrap_atob_decodeString(JsVar *base64Data, JsvStringIterator *dst) {
+  size_t count = 0;
+  // Nothing in here allocates, so we can borrow the source string's blocks
+  JsvStringIterator itsrc;
+  jsvStringIteratorNewBorrowed(&itsrc, base64Data, 0);
+  // skip whitespace
+  while (jsvStringIteratorHasChar(&itsrc) &&
+      isWhitespace(jsvStringIteratorGetChar(&itsrc)))
+    jsvStringIteratorNextBorrowed(&itsrc);
+
+  unsigned int checks = 1;
+  while (jsvStringIteratorHasChar(&itsrc) && !jswrap_codecInterrupted(&checks)) {
+    uint32_t triple = 0;
+    int i, valid=0;
+    for (i=0;i<4;i++) {
+      if (jsvStringIteratorHasChar(&itsrc)) {
+        int sextet = jswrap_atob_decode(jsvStringIteratorGetChar(&itsrc));
+        jsvStringIteratorNextBorrowed(&itsrc);
+        if (sextet>=0) {
+          triple |= (unsigned int)(sextet) << ((3-i)*6);
+          valid=i;
+        }
+      }
+    }
+    if (dst) {
+      if (valid>0) jswrap_putChar(dst, (char)(triple >> 16));
+      if (valid>1) jswrap_putChar(dst, (char)(triple >> 8));
+      if (valid>2) jswrap_putChar(dst, (char)(triple));
+    }
+    count += (size_t)valid;
+  }
+  return count;
+}
+
 /*JSON{
   "type" : "function",
   "name" : "atob",
@@ -285,45 +540,24 @@ JsVar *jswrap_btoa(JsVar *binaryData) {
   "return" : ["JsVar","A string containing the decoded data"]
 }
 Decode the supplied base64 string into a normal string
+
+As with `btoa`, large amounts of data can be decoded in chunks as long as
+every chunk except the last is a multiple of 4 characters long.
  */
 JsVar *jswrap_atob(JsVar *base64Data) {
   if (!jsvIsString(base64Data)) {
     jsExceptionHere(JSET_ERROR, "Expecting a string, got %t", base64Data);
     return 0;
   }
-  JsVar* binaryData = jsvNewFromEmptyString();
+  // Work out how big the result is first, so we can allocate it in one go
+  size_t len = jswrap_atob_decodeString(base64Data, 0);
+  if (jspIsInterrupted()) return 0;
+  JsVar* binaryData = jswrap_newStringOfLength(len);
   if (!binaryData) return 0;
-  JsvStringIterator itsrc;
   JsvStringIterator itdst;
-  jsvStringIteratorNew(&itsrc, base64Data, 0);
   jsvStringIteratorNew(&itdst, binaryData, 0);
-  // skip whitespace
-  while (jsvStringIteratorHasChar(&itsrc) &&
-      isWhitespace(jsvStringIteratorGetChar(&itsrc)))
-    jsvStringIteratorNext(&itsrc);
-
-  while (jsvStringIteratorHasChar(&itsrc) && !jspIsInterrupted()) {
-    uint32_t triple = 0;
-    int i, valid=0;
-    for (i=0;i<4;i++) {
-      if (jsvStringIteratorHasChar(&itsrc)) {
-        int sextet = jswrap_atob_decode(jsvStringIteratorGetChar(&itsrc));
-        jsvStringIteratorNext(&itsrc);
-        if (sextet>=0) {
-          triple |= (unsigned int)(sextet) << ((3-i)*6);
-          valid=i;
-        }
-      }
-    }
-
-    if (valid>0) jsvStringIteratorAppend(&itdst, (char)(triple >> 16));
-    if (valid>1) jsvStringIteratorAppend(&itdst, (char)(triple >> 8));
-    if (valid>2) jsvStringIteratorAppend(&itdst, (char)(triple));
-  }
-
-  jsvStringIteratorFree(&itsrc);
+  jswrap_atob_decodeString(base64Data, &itdst);
   jsvStringIteratorFree(&itdst);
-
   return binaryData;
 }
 
@@ -342,40 +576,69 @@ Convert a string with any character not alphanumeric or `- _ . ! ~ * ' ( )` conv
 JsVar *jswrap_encodeURIComponent(JsVar *arg) {
   JsVar *v = jsvAsString(arg, false);
   if (!v) return 0;
-  JsVar *result = jsvNewFromEmptyString();
+  // Work out how big the result is first, so we can allocate it in one go
+  size_t len = 0;
+  unsigned int checks = 1;
+  JsvStringIterator it;
+  jsvStringIteratorNewBorrowed(&it, v, 0);
+  while (jsvStringIteratorHasChar(&it) && !jswrap_codecInterrupted(&checks)) {
+    len += jswrap_uri_isUnreserved(jsvStringIteratorGetChar(&it)) ? 1 : 3;
+    jsvStringIteratorNextBorrowed(&it);
+  }
+  JsVar *result = jspIsInterrupted() ? 0 : jswrap_newStringOfLength(len);
   if (result) {
-    JsvStringIterator it;
-    jsvStringIteratorNew(&it, v, 0);
     JsvStringIterator dst;
     jsvStringIteratorNew(&dst, result, 0);
-    while (jsvStringIteratorHasChar(&it)) {
+    jsvStringIteratorNewBorrowed(&it, v, 0);
+    while (jsvStringIteratorHasChar(&it) && !jswrap_codecInterrupted(&checks)) {
       char ch = jsvStringIteratorGetChar(&it);
-      if (isAlpha(ch) || isNumeric(ch) ||
-          ch=='-' || // _ in isAlpha
-          ch=='.' ||
-          ch=='!' ||
-          ch=='~' ||
-          ch=='*' ||
-          ch=='\'' ||
-          ch=='(' ||
-          ch==')') {
-        jsvStringIteratorAppend(&dst, ch);
+      if (jswrap_uri_isUnreserved(ch)) {
+        jswrap_putChar(&dst, ch);
       } else {
-        jsvStringIteratorAppend(&dst, '%');
-        unsigned int d = ((unsigned)ch)>>4;
-        jsvStringIteratorAppend(&dst, (char)((d>9)?('A'+d-10):('0'+d)));
-        d = ((unsigned)ch)&15;
-        jsvStringIteratorAppend(&dst, (char)((d>9)?('A'+d-10):('0'+d)));
+        jswrap_putChar(&dst, '%');
+        jswrap_putChar(&dst, jswrap_uri_hexChars[((unsigned char)ch)>>4]);
+        jswrap_putChar(&dst, jswrap_uri_hexChars[((unsigned char)ch)&15]);
       }
-      jsvStringIteratorNext(&it);
+      jsvStringIteratorNextBorrowed(&it);
     }
     jsvStringIteratorFree(&dst);
-    jsvStringIteratorFree(&it);
   }
   jsvUnLock(v);
   return result;
 }
 
+/** Decode a URI component. If dst is 0, just return how many bytes would
+ * have been written, or -1 (with an exception) if it's invalid */
+static int jswrap_decodeURIComponent_string(JsVar *v, JsvStringIterator *dst) {
+  int count = 0;
+  unsigned int checks = 1;
+  // Nothing in here allocates (unless we throw), so we can borrow the source string's blocks
+  JsvStringIterator it;
+  jsvStringIteratorNewBorrowed(&it, v, 0);
+  while (jsvStringIteratorHasChar(&it) && !jswrap_codecInterrupted(&checks)) {
+    char ch = jsvStringIteratorGetChar(&it);
+    if (ch>>7) {
+      jsExceptionHere(JSET_ERROR, "ASCII only\n");
+      return -1;
+    }
+    if (ch=='%') {
+      jsvStringIteratorNextBorrowed(&it);
+      int hi = chtod(jsvStringIteratorGetChar(&it));
+      jsvStringIteratorNextBorrowed(&it);
+      int lo = chtod(jsvStringIteratorGetChar(&it));
+      ch = (char)((hi<<4)|lo);
+      if (hi<0 || lo<0 || ch>>7) {
+        jsExceptionHere(JSET_ERROR, "Invalid URI\n");
+        return -1;
+      }
+    }
+    if (dst) jswrap_putChar(dst, ch);
+    count++;
+    jsvStringIteratorNextBorrowed(&it);
+  }
+  return count;
+}
+
 /*JSON{
   "type" : "function",
   "name" : "decodeURIComponent",
@@ -391,36 +654,15 @@ Convert any groups of characters of the form '%ZZ', into characters with hex cod
 JsVar *jswrap_decodeURIComponent(JsVar *arg) {
   JsVar *v = jsvAsString(arg, false);
   if (!v) return 0;
-  JsVar *result = jsvNewFromEmptyString();
+  JsVar *result = 0;
+  // Work out how big the result is (and whether it's valid) first, so we can allocate it in one go
+  int len = jswrap_decodeURIComponent_string(v, 0);
+  if (len>=0 && !jspIsInterrupted()) result = jswrap_newStringOfLength((size_t)len);
   if (result) {
-    JsvStringIterator it;
-    jsvStringIteratorNew(&it, v, 0);
     JsvStringIterator dst;
     jsvStringIteratorNew(&dst, result, 0);
-    while (jsvStringIteratorHasChar(&it)) {
-      char ch = jsvStringIteratorGetChar(&it);
-      if (ch>>7) {
-        jsExceptionHere(JSET_ERROR, "ASCII only\n");
-        break;
-      }
-      if (ch!='%') {
-        jsvStringIteratorAppend(&dst, ch);
-      } else {
-        jsvStringIteratorNext(&it);
-        int hi = chtod(jsvStringIteratorGetChar(&it));
-        jsvStringIteratorNext(&it);
-        int lo = chtod(jsvStringIteratorGetChar(&it));
-        ch = (char)((hi<<4)|lo);
-        if (hi<0 || lo<0 || ch>>7) {
-          jsExceptionHere(JSET_ERROR, "Invalid URI\n");
-          break;
-        }
-        jsvStringIteratorAppend(&dst, ch);
-      }
-      jsvStringIteratorNext(&it);
-    }
+    jswrap_decodeURIComponent_string(v, &dst);
     jsvStringIteratorFree(&dst);
-    jsvStringIteratorFree(&it);
   }
   jsvUnLock(v);
   return result;
@@ -16,6 +16,16 @@
 JsVar *jswrap_arguments();
 JsVar *jswrap_function_constructor(JsVar *code);
 JsVar *jswrap_eval(JsVar *v);
+
+#define FUNCTION_CACHE_NAME "fnCache" ///< Name of the Function code cache in hiddenRoot
+#define FUNCTION_CACHE_SIZE 8 ///< Maximum number of entries in the Function code cache
+#define FUNCTION_CACHE_MAX_LENGTH 1024 ///< Code longer than this isn't cached
+/// Return a locked copy of the given code from the cache (adding it if needed), or 0. This is shared, so don't modify it
+JsVar *jswrap_function_cache_get(JsVar *code);
+/// Empty the Function code cache. Returns true if anything was freed
+bool jswrap_function_cache_flush();
+void jswrap_function_cache_kill();
+JsVar *jswrap_function_cache_getStats();
 JsVar *jswrap_parseInt(JsVar *v, JsVar *radixVar);
 JsVarFloat jswrap_parseFloat(JsVar *v);
 bool jswrap_isNaN(JsVar *v);
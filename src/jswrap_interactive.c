@@ -502,20 +502,7 @@ If no argument is supplied, all timers and intervals are stopped
 void _jswrap_interface_clearTimeoutOrInterval(JsVar *idVar, bool isTimeout) {
   JsVar *timerArrayPtr = jsvLock(timerArray);
   if (jsvIsUndefined(idVar)) {
-    /* Delete all timers EXCEPT those with a 'watch' field,
-     as those were generated by jsinteractive.c for debouncing watches */
-    JsvObjectIterator it;
-    jsvObjectIteratorNew(&it, timerArrayPtr);
-    while (jsvObjectIteratorHasValue(&it)) {
-      JsVar *timerPtr = jsvObjectIteratorGetValue(&it);
-      JsVar *watchPtr = jsvObjectGetChild(timerPtr, "watch", 0);
-      if (!watchPtr)
-        jsvObjectIteratorRemoveAndGotoNext(&it, timerArrayPtr);
-      else
-        jsvObjectIteratorNext(&it); 
-      jsvUnLock2(watchPtr, timerPtr);
-    }
-    jsvObjectIteratorFree(&it);
+    jsvRemoveAllChildren(timerArrayPtr);
   } else {
     JsVar *child = jsvIsBasic(idVar) ? jsvFindChildFromVar(timerArrayPtr, idVar, false) : 0;
     if (child) {
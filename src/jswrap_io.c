@@ -644,17 +644,24 @@ JsVar *jswrap_interface_setWatch(
     // o edge     - ?
     // o callback - The function to be invoked when the IO changes
     JsVar *watchPtr = jsvNewObject();
-    if (watchPtr) {
-      jsvObjectSetChildAndUnLock(watchPtr, "pin", jsvNewFromPin(pin));
-      if (repeat) jsvObjectSetChildAndUnLock(watchPtr, "recur", jsvNewFromBool(repeat));
-      if (debounce>0) jsvObjectSetChildAndUnLock(watchPtr, "debounce", jsvNewFromInteger((JsVarInt)jshGetTimeFromMilliseconds(debounce)));
-      if (edge) jsvObjectSetChildAndUnLock(watchPtr, "edge", jsvNewFromInteger(edge));
-      jsvObjectSetChild(watchPtr, "callback", func); // no unlock intentionally
+    if (!watchPtr) return 0;
+    jsvObjectSetChildAndUnLock(watchPtr, "pin", jsvNewFromPin(pin));
+    if (repeat) jsvObjectSetChildAndUnLock(watchPtr, "recur", jsvNewFromBool(repeat));
+    if (debounce>0) jsvObjectSetChildAndUnLock(watchPtr, "debounce", jsvNewFromInteger((JsVarInt)jshGetTimeFromMilliseconds(debounce)));
+    if (edge) jsvObjectSetChildAndUnLock(watchPtr, "edge", jsvNewFromInteger(edge));
+    jsvObjectSetChild(watchPtr, "callback", func); // no unlock intentionally
+
+    // Add it to the event loop's native watch table
+    bool isWatched = jsiIsWatchingPin(pin);
+    if (!jsiWatchAdd(watchPtr)) {
+      jsvUnLock(watchPtr);
+      jsExceptionHere(JSET_ERROR, "Not enough memory for watch");
+      return 0;
     }
 
     // If nothing already watching the pin, set up a watch
     IOEventFlags exti = EV_NONE;
-    if (!jsiIsWatchingPin(pin))
+    if (!isWatched)
       exti = jshPinWatch(pin, true);
     // disable event callbacks by default
     if (exti) {
@@ -674,9 +681,8 @@ JsVar *jswrap_interface_setWatch(
 
     JsVar *watchArrayPtr = jsvLock(watchArray);
     itemIndex = jsvArrayAddToEnd(watchArrayPtr, watchPtr, 1) - 1;
+    if (itemIndex<0) jsiWatchRemove(watchPtr); // out of memory
     jsvUnLock2(watchArrayPtr, watchPtr);
-
-
   }
   return (itemIndex>=0) ? jsvNewFromInteger(itemIndex) : 0/*undefined*/;
 }
@@ -694,18 +700,9 @@ Clear the Watch that was created with setWatch. If no parameter is supplied, all
 void jswrap_interface_clearWatch(JsVar *idVar) {
 
   if (jsvIsUndefined(idVar)) {
-    JsVar *watchArrayPtr = jsvLock(watchArray);
-    JsvObjectIterator it;
-    jsvObjectIteratorNew(&it, watchArrayPtr);
-    while (jsvObjectIteratorHasValue(&it)) {
-      JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
-      JsVar *watchPin = jsvObjectGetChild(watchPtr, "pin", 0);
-      jshPinWatch(jshGetPinFromVar(watchPin), false);
-      jsvUnLock2(watchPin, watchPtr);
-      jsvObjectIteratorNext(&it);
-    }
-    jsvObjectIteratorFree(&it);
+    jsiWatchRemoveAll();
     // remove all items
+    JsVar *watchArrayPtr = jsvLock(watchArray);
     jsvRemoveAllChildren(watchArrayPtr);
     jsvUnLock(watchArrayPtr);
   } else {
@@ -713,17 +710,14 @@ void jswrap_interface_clearWatch(JsVar *idVar) {
     JsVar *watchNamePtr = jsvFindChildFromVar(watchArrayPtr, idVar, false);
     jsvUnLock(watchArrayPtr);
     if (watchNamePtr) { // child is a 'name'
+      // Remove from the native table - this 'unwatches' the pin if nothing else uses it
       JsVar *watchPtr = jsvSkipName(watchNamePtr);
-      Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChild(watchPtr, "pin", 0));
+      jsiWatchRemove(watchPtr);
       jsvUnLock(watchPtr);
 
       JsVar *watchArrayPtr = jsvLock(watchArray);
       jsvRemoveChild(watchArrayPtr, watchNamePtr);
       jsvUnLock2(watchNamePtr, watchArrayPtr);
-
-      // Now check if this pin is still being watched
-      if (!jsiIsWatchingPin(pin))
-        jshPinWatch(pin, false); // 'unwatch' pin
     } else {
       jsExceptionHere(JSET_ERROR, "Unknown Watch");
     }
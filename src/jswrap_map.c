@@ -0,0 +1,778 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * This file is designed to be parsed during the build process
+ *
+ * ES6 Map and Set, backed by a hash table
+ * ----------------------------------------------------------------------------
+ */
+#include "jswrap_map.h"
+#include "jsparse.h"
+#include "jsinteractive.h"
+#include "jsvariterator.h"
+
+/* Entries are stored in a hidden array in insertion order. For a Map each
+ * entry is two elements - the key, then the value - so the value is always
+ * the key's next sibling. For a Set each element is just the key. Deleting
+ * leaves a gap in the array indices, but that doesn't matter as we never
+ * look entries up by index.
+ *
+ * The hash table is a flat string of JsVarRefs pointing at each key's array
+ * element (the Name, not the key itself), using open addressing with linear
+ * probing. It doesn't keep the elements alive - the array does that, so
+ * garbage collection just sees a normal object with two hidden children. */
+#define JSWRAP_MAP_ENTRIES_NAME JS_HIDDEN_CHAR_STR"ent"
+#define JSWRAP_MAP_TABLE_NAME JS_HIDDEN_CHAR_STR"htb"
+#define JSWRAP_MAP_MIN_SLOTS 8
+/// A slot whose entry was deleted - lookups must carry on past it
+#define JSWRAP_MAP_DELETED ((JsVarRef)~(JsVarRef)0)
+
+#ifndef SAVE_ON_FLASH
+
+/*JSON{
+  "type" : "class",
+  "class" : "Map",
+  "ifndef" : "SAVE_ON_FLASH",
+  "state" : "JswMapState",
+  "copystate" : "jswrap_map_copyState"
+}
+This is the built-in class for ES6 Maps - a collection of key/value pairs where the keys can be
+any value (including Objects), and which remembers the order that keys were added in.
+
+Lookups use a hash table, so unlike using an Object as a map or searching an Array
+they don't get slower as the Map gets bigger.
+ */
+/*JSON{
+  "type" : "class",
+  "class" : "Set",
+  "ifndef" : "SAVE_ON_FLASH",
+  "state" : "JswMapState",
+  "copystate" : "jswrap_map_copyState"
+}
+This is the built-in class for ES6 Sets - a collection of unique values, which remembers the
+order that they were added in.
+
+Lookups use a hash table, so unlike searching an Array with `indexOf` they don't get
+slower as the Set gets bigger.
+ */
+
+// Map and Set share JswMapState, so this works for either
+static JswMapState *jswrap_map_getState(JsVar *parent) {
+  JswMapState *state = jswGetState_Map(parent);
+  if (!state) jsExceptionHere(JSET_TYPEERROR, "Not a Map or Set");
+  return state;
+}
+
+static uint32_t jswrap_map_hashInt(uint32_t i) {
+  return i * 2654435761U;
+}
+
+/// Hash a key so that keys that are the same (according to SameValueZero) hash the same
+static uint32_t jswrap_map_hash(JsVar *key) {
+  if (jsvIsUndefined(key)) return 0x1234;
+  if (jsvIsNull(key)) return 0x5678;
+  if (jsvIsBoolean(key)) return jsvGetBool(key) ? 0x9ABC : 0xDEF0;
+  if (jsvIsString(key)) {
+    uint32_t h = 5381;
+    JsvStringIterator it;
+    jsvStringIteratorNewBorrowed(&it, key, 0);
+    while (jsvStringIteratorHasChar(&it)) {
+      h = h*33 + (unsigned char)jsvStringIteratorGetChar(&it);
+      jsvStringIteratorNextBorrowed(&it);
+    }
+    return h;
+  }
+  if (jsvIsInt(key)) return jswrap_map_hashInt((uint32_t)jsvGetInteger(key));
+  if (jsvIsFloat(key)) {
+    JsVarFloat f = jsvGetFloat(key);
+    if (isnan(f)) return 0x7FF8;
+    // make sure 1.0 hashes the same as 1 (and -0 the same as 0)
+    if (f>=-2147483648.0 && f<=2147483647.0 && f==(JsVarFloat)(JsVarInt)f)
+      return jswrap_map_hashInt((uint32_t)(JsVarInt)f);
+    uint32_t h = 0;
+    unsigned char *b = (unsigned char*)&f;
+    unsigned int i;
+    for (i=0;i<sizeof(f);i++) h = h*33 + b[i];
+    return h;
+  }
+  // Objects, Arrays, Functions, etc are all compared by identity
+  return jswrap_map_hashInt((uint32_t)jsvGetRef(key));
+}
+
+/// Are these keys the same, according to ES6's SameValueZero?
+static bool jswrap_map_keysEqual(JsVar *a, JsVar *b) {
+  if (a==b) return true;
+  if (jsvIsString(a)) return jsvIsString(b) && jsvCompareString(a, b, 0, 0, false)==0;
+  if ((jsvIsInt(a) || jsvIsFloat(a)) && (jsvIsInt(b) || jsvIsFloat(b))) {
+    JsVarFloat fa = jsvGetFloat(a), fb = jsvGetFloat(b);
+    return fa==fb || (isnan(fa) && isnan(fb));
+  }
+  if (jsvIsBoolean(a)) return jsvIsBoolean(b) && jsvGetBool(a)==jsvGetBool(b);
+  if (jsvIsUndefined(a)) return jsvIsUndefined(b);
+  if (jsvIsNull(a)) return jsvIsNull(b);
+  return false; // different objects
+}
+
+static JsVarRef *jswrap_map_getSlots(JsVar *table, uint32_t *slotCount) {
+  *slotCount = (uint32_t)(jsvGetCharactersInVar(table) / sizeof(JsVarRef));
+  return (JsVarRef*)jsvGetFlatStringPointer(table);
+}
+
+/** Look for 'key' in the hash table. Returns true and sets *slot if it's found, or
+ * returns false and sets *slot to where it should be inserted. */
+static bool jswrap_map_find(JsVar *table, JsVar *key, uint32_t *slot) {
+  uint32_t slotCount;
+  JsVarRef *slots = jswrap_map_getSlots(table, &slotCount);
+  uint32_t mask = slotCount-1;
+  uint32_t i = jswrap_map_hash(key) & mask;
+  uint32_t firstDeleted = slotCount;
+  while (slots[i]) {
+    if (slots[i] == JSWRAP_MAP_DELETED) {
+      if (firstDeleted == slotCount) firstDeleted = i;
+    } else {
+      JsVar *name = jsvLock(slots[i]);
+      JsVar *k = jsvSkipName(name);
+      bool equal = jswrap_map_keysEqual(k, key);
+      jsvUnLock2(k, name);
+      if (equal) {
+        *slot = i;
+        return true;
+      }
+    }
+    i = (i+1) & mask;
+  }
+  *slot = (firstDeleted != slotCount) ? firstDeleted : i;
+  return false;
+}
+
+/** Make a new hash table big enough for the current entries (plus a few more), and fill it in.
+ * Returns false if we didn't have the memory. */
+static bool jswrap_map_rehash(JsVar *parent, JswMapState *state, JsVar *entries) {
+  uint32_t slotCount = JSWRAP_MAP_MIN_SLOTS;
+  while ((uint32_t)(state->count+1)*2 > slotCount) slotCount <<= 1;
+  JsVar *table = jsvNewFlatStringOfLength((unsigned int)(slotCount*sizeof(JsVarRef)));
+  if (!table) return false;
+  JsVarRef *slots = (JsVarRef*)jsvGetFlatStringPointer(table);
+  uint32_t mask = slotCount-1;
+  // Keys are already unique, so we only need to find an empty slot for each
+  JsVarRef ref = entries ? jsvGetFirstChild(entries) : 0;
+  while (ref) {
+    JsVar *name = jsvLock(ref);
+    JsVar *k = jsvSkipName(name);
+    uint32_t i = jswrap_map_hash(k) & mask;
+    jsvUnLock(k);
+    while (slots[i]) i = (i+1) & mask;
+    slots[i] = ref;
+    ref = jsvGetNextSibling(name);
+    jsvUnLock(name);
+    if (state->isMap && ref) { // skip the value
+      name = jsvLock(ref);
+      ref = jsvGetNextSibling(name);
+      jsvUnLock(name);
+    }
+  }
+  jsvObjectSetChildAndUnLock(parent, JSWRAP_MAP_TABLE_NAME, table);
+  state->used = state->count;
+  return true;
+}
+
+/** Called when a Map or Set is copied (eg. with clone). 'dst' has its own state, but still shares
+ * the entries array and hash table - so give it copies of the entries (the keys and values
+ * themselves are shared, as in any other clone) and a new table that points at them. */
+void jswrap_map_copyState(JsVar *src, JsVar *dst) {
+  NOT_USED(src);
+  JswMapState *state = jswGetState_Map(dst);
+  if (!state) return;
+  // the table holds refs into the original's entries, so must never be used by the copy
+  jsvRemoveNamedChild(dst, JSWRAP_MAP_TABLE_NAME);
+  JsVar *entries = jsvObjectGetChild(dst, JSWRAP_MAP_ENTRIES_NAME, 0);
+  if (!entries) return; // nothing was ever added
+  JsVar *newEntries = jsvCopy(entries);
+  jsvUnLock(entries);
+  if (newEntries) {
+    jsvObjectSetChild(dst, JSWRAP_MAP_ENTRIES_NAME, newEntries);
+    bool ok = jswrap_map_rehash(dst, state, newEntries);
+    jsvUnLock(newEntries);
+    if (ok) return;
+  }
+  // out of memory - leave the copy empty rather than sharing the original's entries
+  jsvRemoveNamedChild(dst, JSWRAP_MAP_ENTRIES_NAME);
+  jsvRemoveNamedChild(dst, JSWRAP_MAP_TABLE_NAME);
+  state->count = 0;
+  state->used = 0;
+}
+
+/// Find the Name of the key's element in the entries array (or 0), and optionally its slot in the hash table
+static JsVar *jswrap_map_findName(JsVar *parent, JsVar *key, uint32_t *slotOut) {
+  JsVar *table = jsvObjectGetChild(parent, JSWRAP_MAP_TABLE_NAME, 0);
+  if (!table) return 0;
+  uint32_t slot;
+  JsVar *name = 0;
+  if (jswrap_map_find(table, key, &slot)) {
+    uint32_t slotCount;
+    name = jsvLock(jswrap_map_getSlots(table, &slotCount)[slot]);
+    if (slotOut) *slotOut = slot;
+  }
+  jsvUnLock(table);
+  return name;
+}
+
+/// Remove every entry
+static void jswrap_map_removeAll(JsVar *parent, JswMapState *state) {
+  JsVar *entries = jsvObjectGetChild(parent, JSWRAP_MAP_ENTRIES_NAME, 0);
+  if (entries) {
+    jsvRemoveAllChildren(entries);
+    jsvSetArrayLength(entries, 0, false);
+    jsvUnLock(entries);
+  }
+  JsVar *table = jsvObjectGetChild(parent, JSWRAP_MAP_TABLE_NAME, 0);
+  if (table) {
+    if (jsvGetCharactersInVar(table) > JSWRAP_MAP_MIN_SLOTS*sizeof(JsVarRef)) {
+      // don't hang on to a big table we no longer need
+      jsvRemoveNamedChild(parent, JSWRAP_MAP_TABLE_NAME);
+    } else {
+      memset(jsvGetFlatStringPointer(table), 0, jsvGetCharactersInVar(table));
+    }
+    jsvUnLock(table);
+  }
+  state->count = 0;
+  state->used = 0;
+}
+
+/** Add or update an entry. For a Set 'value' is ignored. Returns false if there was an error */
+static bool jswrap_map_put(JsVar *parent, JswMapState *state, JsVar *key, JsVar *value) {
+  JsVar *table = jsvObjectGetChild(parent, JSWRAP_MAP_TABLE_NAME, 0);
+  uint32_t slot;
+  if (table && jswrap_map_find(table, key, &slot)) {
+    if (state->isMap) {
+      uint32_t slotCount;
+      JsVar *name = jsvLock(jswrap_map_getSlots(table, &slotCount)[slot]);
+      JsVar *valueName = jsvLock(jsvGetNextSibling(name));
+      jsvSetValueOfName(valueName, value);
+      jsvUnLock2(valueName, name);
+    }
+    jsvUnLock(table);
+    return true;
+  }
+
+  JsVar *entries = jsvObjectGetChild(parent, JSWRAP_MAP_ENTRIES_NAME, JSV_ARRAY);
+  if (!entries) {
+    jsvUnLock(table);
+    return false; // out of memory
+  }
+  // keep the table at most 3/4 full (counting deleted slots) so lookups stay short
+  uint32_t slotCount = table ? (uint32_t)(jsvGetCharactersInVar(table) / sizeof(JsVarRef)) : 0;
+  if ((uint32_t)(state->used+1)*4 > slotCount*3) {
+    if (jswrap_map_rehash(parent, state, entries)) {
+      jsvUnLock(table);
+      table = jsvObjectGetChild(parent, JSWRAP_MAP_TABLE_NAME, 0);
+      jswrap_map_find(table, key, &slot);
+    } else if (!table || (uint32_t)state->used+1 >= slotCount) {
+      // We can manage a very full table, but not a completely full one
+      jsvUnLock2(table, entries);
+      jsExceptionHere(JSET_ERROR, "Out of memory while adding to %s", state->isMap?"Map":"Set");
+      return false;
+    }
+  }
+
+  JsVarInt length = jsvGetArrayLength(entries);
+  jsvArrayPush(entries, key);
+  if (state->isMap) jsvArrayPush(entries, value);
+  if (jsvGetArrayLength(entries) != length + (state->isMap?2:1)) {
+    // out of memory - don't leave a key without a value
+    if (state->isMap && jsvGetArrayLength(entries) == length+1) {
+      JsVar *name = jsvLock(jsvGetLastChild(entries));
+      jsvRemoveChild(entries, name);
+      jsvUnLock(name);
+    }
+    jsvUnLock2(table, entries);
+    return false;
+  }
+  JsVarRef ref = jsvGetLastChild(entries);
+  if (state->isMap) {
+    JsVar *valueName = jsvLock(ref);
+    ref = jsvGetPrevSibling(valueName);
+    jsvUnLock(valueName);
+  }
+  JsVarRef *slots = jswrap_map_getSlots(table, &slotCount);
+  if (!slots[slot]) state->used++;
+  slots[slot] = ref;
+  state->count++;
+  jsvUnLock2(table, entries);
+  return true;
+}
+
+/// Add everything in 'iterable' (an Array, Map or Set) to a new Map or Set
+static void jswrap_map_addAll(JsVar *parent, JswMapState *state, JsVar *iterable) {
+  if (jsvIsUndefined(iterable) || jsvIsNull(iterable)) return;
+  JswMapState *srcState = jsvIsObject(iterable) ? jswGetState_Map(iterable) : 0;
+  if (srcState) {
+    // another Map or Set - copy its entries
+    JsVar *entries = jsvObjectGetChild(iterable, JSWRAP_MAP_ENTRIES_NAME, 0);
+    JsVarRef ref = entries ? jsvGetFirstChild(entries) : 0;
+    while (ref && !jspHasError()) {
+      JsVar *name = jsvLock(ref);
+      JsVar *valueName = srcState->isMap ? jsvLock(jsvGetNextSibling(name)) : jsvLockAgain(name);
+      JsVar *k = jsvSkipName(name);
+      JsVar *v = jsvSkipName(valueName);
+      if (srcState->isMap && !state->isMap) { // new Set(map) adds [key,value] pairs
+        JsVar *pair[2] = {k, v};
+        JsVar *arr = jsvNewArray(pair, 2);
+        jswrap_map_put(parent, state, arr, 0);
+        jsvUnLock(arr);
+      } else if (!srcState->isMap && state->isMap) {
+        jsExceptionHere(JSET_TYPEERROR, "Expecting [key, value] pairs");
+      } else {
+        jswrap_map_put(parent, state, k, v);
+      }
+      ref = jsvGetNextSibling(valueName);
+      jsvUnLock2(k, v);
+      jsvUnLock2(valueName, name);
+    }
+    jsvUnLock(entries);
+  } else if (jsvIsArray(iterable)) {
+    JsvIterator it;
+    jsvIteratorNew(&it, iterable);
+    while (jsvIteratorHasElement(&it) && !jspHasError()) {
+      JsVar *item = jsvIteratorGetValue(&it);
+      if (state->isMap) {
+        if (jsvIsArray(item)) {
+          JsVar *k = jsvGetArrayItem(item, 0);
+          JsVar *v = jsvGetArrayItem(item, 1);
+          jswrap_map_put(parent, state, k, v);
+          jsvUnLock2(k, v);
+        } else {
+          jsExceptionHere(JSET_TYPEERROR, "Expecting [key, value] pairs, got %t", item);
+        }
+      } else {
+        jswrap_map_put(parent, state, item, 0);
+      }
+      jsvUnLock(item);
+      jsvIteratorNext(&it);
+    }
+    jsvIteratorFree(&it);
+  } else {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting an Array, Map or Set, got %t", iterable);
+  }
+}
+
+static JsVar *jswrap_map_new(const char *className, bool isMap, JsVar *iterable) {
+  JsVar *obj = jspNewObject(0, className);
+  JswMapState *state = obj ? (isMap ? jswNewState_Map(obj) : jswNewState_Set(obj)) : 0;
+  if (!state) {
+    jsvUnLock(obj);
+    return 0; // out of memory
+  }
+  state->isMap = isMap;
+  jswrap_map_addAll(obj, state, iterable);
+  return obj;
+}
+
+/*JSON{
+  "type" : "constructor",
+  "class" : "Map",
+  "name" : "Map",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_constructor",
+  "params" : [
+    ["iterable","JsVar","An Array of `[key, value]` pairs, or another Map, to initialise the Map with (optional)"]
+  ],
+  "return" : ["JsVar","A new Map"]
+}
+Create a new Map
+ */
+JsVar *jswrap_map_constructor(JsVar *iterable) {
+  return jswrap_map_new("Map", true, iterable);
+}
+
+/*JSON{
+  "type" : "constructor",
+  "class" : "Set",
+  "name" : "Set",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_set_constructor",
+  "params" : [
+    ["iterable","JsVar","An Array of values, or another Set, to initialise the Set with (optional)"]
+  ],
+  "return" : ["JsVar","A new Set"]
+}
+Create a new Set
+ */
+JsVar *jswrap_set_constructor(JsVar *iterable) {
+  return jswrap_map_new("Set", false, iterable);
+}
+
+/*JSON{
+  "type" : "property",
+  "class" : "Map",
+  "name" : "size",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_size",
+  "return" : ["JsVar","The number of entries in the Map"]
+}
+*/
+/*JSON{
+  "type" : "property",
+  "class" : "Set",
+  "name" : "size",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_size",
+  "return" : ["JsVar","The number of values in the Set"]
+}
+*/
+JsVar *jswrap_map_size(JsVar *parent) {
+  JswMapState *state = jswrap_map_getState(parent);
+  return state ? jsvNewFromInteger(state->count) : 0;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "get",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_get",
+  "params" : [
+    ["key","JsVar","The key to look up"]
+  ],
+  "return" : ["JsVar","The value for this key, or undefined"]
+}
+*/
+JsVar *jswrap_map_get(JsVar *parent, JsVar *key) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return 0;
+  JsVar *name = jswrap_map_findName(parent, key, 0);
+  if (!name) return 0;
+  JsVar *valueName = state->isMap ? jsvLock(jsvGetNextSibling(name)) : jsvLockAgain(name);
+  jsvUnLock(name);
+  return jsvSkipNameAndUnLock(valueName);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "set",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_set",
+  "params" : [
+    ["key","JsVar","The key"],
+    ["value","JsVar","The value to store for it"]
+  ],
+  "return" : ["JsVar","The Map"]
+}
+Set the value for a key, adding it to the end of the Map if it wasn't already there
+*/
+JsVar *jswrap_map_set(JsVar *parent, JsVar *key, JsVar *value) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return 0;
+  if (!state->isMap) {
+    jsExceptionHere(JSET_TYPEERROR, "Not a Map");
+    return 0;
+  }
+  jswrap_map_put(parent, state, key, value);
+  return jsvLockAgain(parent);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "add",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_set_add",
+  "params" : [
+    ["value","JsVar","The value to add"]
+  ],
+  "return" : ["JsVar","The Set"]
+}
+Add a value to the end of the Set, if it isn't already in it
+*/
+JsVar *jswrap_set_add(JsVar *parent, JsVar *value) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return 0;
+  if (state->isMap) {
+    jsExceptionHere(JSET_TYPEERROR, "Not a Set");
+    return 0;
+  }
+  jswrap_map_put(parent, state, value, 0);
+  return jsvLockAgain(parent);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "has",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_has",
+  "params" : [
+    ["key","JsVar","The key to look for"]
+  ],
+  "return" : ["bool","Whether the key is in the Map"]
+}
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "has",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_has",
+  "params" : [
+    ["value","JsVar","The value to look for"]
+  ],
+  "return" : ["bool","Whether the value is in the Set"]
+}
+*/
+bool jswrap_map_has(JsVar *parent, JsVar *key) {
+  if (!jswrap_map_getState(parent)) return false;
+  JsVar *name = jswrap_map_findName(parent, key, 0);
+  jsvUnLock(name);
+  return name!=0;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "delete",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_delete",
+  "params" : [
+    ["key","JsVar","The key to remove"]
+  ],
+  "return" : ["bool","true if the key was in the Map"]
+}
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "delete",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_delete",
+  "params" : [
+    ["value","JsVar","The value to remove"]
+  ],
+  "return" : ["bool","true if the value was in the Set"]
+}
+*/
+bool jswrap_map_delete(JsVar *parent, JsVar *key) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return false;
+  uint32_t slot;
+  JsVar *name = jswrap_map_findName(parent, key, &slot);
+  if (!name) return false;
+  if (state->count==1) {
+    // the last entry - start again, so the array indices don't keep growing
+    jsvUnLock(name);
+    jswrap_map_removeAll(parent, state);
+    return true;
+  }
+  JsVar *entries = jsvObjectGetChild(parent, JSWRAP_MAP_ENTRIES_NAME, 0);
+  JsVar *table = jsvObjectGetChild(parent, JSWRAP_MAP_TABLE_NAME, 0);
+  uint32_t slotCount;
+  jswrap_map_getSlots(table, &slotCount)[slot] = JSWRAP_MAP_DELETED;
+  if (state->isMap) {
+    JsVar *valueName = jsvLock(jsvGetNextSibling(name));
+    jsvRemoveChild(entries, valueName);
+    jsvUnLock(valueName);
+  }
+  jsvRemoveChild(entries, name);
+  jsvUnLock3(name, table, entries);
+  state->count--;
+  return true;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "clear",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_clear"
+}
+Remove everything from the Map
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "clear",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_clear"
+}
+Remove everything from the Set
+*/
+void jswrap_map_clear(JsVar *parent) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (state) jswrap_map_removeAll(parent, state);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "forEach",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_forEach",
+  "params" : [
+    ["function","JsVar","A function of the form `function(value, key, map)`"],
+    ["thisArg","JsVar","if specified, the function is called with 'this' set to thisArg (optional)"]
+  ]
+}
+Call a function for each entry, in the order they were added
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "forEach",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_forEach",
+  "params" : [
+    ["function","JsVar","A function of the form `function(value, value, set)`"],
+    ["thisArg","JsVar","if specified, the function is called with 'this' set to thisArg (optional)"]
+  ]
+}
+Call a function for each value, in the order they were added
+*/
+void jswrap_map_forEach(JsVar *parent, JsVar *funcVar, JsVar *thisArg) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return;
+  if (!jsvIsFunction(funcVar)) {
+    jsExceptionHere(JSET_TYPEERROR, "forEach expects a Function, got %t", funcVar);
+    return;
+  }
+  JsVar *entries = jsvObjectGetChild(parent, JSWRAP_MAP_ENTRIES_NAME, 0);
+  if (!entries) return;
+  JsVar *name = jsvGetFirstChild(entries) ? jsvLock(jsvGetFirstChild(entries)) : 0;
+  while (name && !jspHasError()) {
+    JsVar *valueName = state->isMap ? jsvLock(jsvGetNextSibling(name)) : jsvLockAgain(name);
+    JsVarInt index = jsvGetInteger(valueName);
+    JsVar *args[3];
+    args[0] = jsvSkipName(valueName);
+    args[1] = jsvSkipName(name);
+    args[2] = parent;
+    jsvUnLock(jspeFunctionCall(funcVar, 0, thisArg, false, 3, args));
+    jsvUnLock2(args[0], args[1]);
+    JsVarRef next;
+    if (jsvGetRefs(valueName)) {
+      next = jsvGetNextSibling(valueName);
+    } else {
+      // The callback deleted this entry - find the one that was after it
+      next = jsvGetFirstChild(entries);
+      while (next) {
+        JsVar *n = jsvLock(next);
+        bool after = jsvGetInteger(n) > index;
+        jsvUnLock(n);
+        if (after) break;
+        n = jsvLock(next);
+        next = jsvGetNextSibling(n);
+        jsvUnLock(n);
+      }
+    }
+    jsvUnLock2(valueName, name);
+    name = next ? jsvLock(next) : 0;
+  }
+  jsvUnLock2(name, entries);
+}
+
+/// Return an array of the keys (part==0), values (part==1) or [key,value] pairs (part==2)
+static JsVar *jswrap_map_toArray(JsVar *parent, int part) {
+  JswMapState *state = jswrap_map_getState(parent);
+  if (!state) return 0;
+  JsVar *arr = jsvNewEmptyArray();
+  JsVar *entries = jsvObjectGetChild(parent, JSWRAP_MAP_ENTRIES_NAME, 0);
+  JsVarRef ref = (arr && entries) ? jsvGetFirstChild(entries) : 0;
+  while (ref) {
+    JsVar *name = jsvLock(ref);
+    JsVar *valueName = state->isMap ? jsvLock(jsvGetNextSibling(name)) : jsvLockAgain(name);
+    JsVar *item;
+    if (part==0) item = jsvSkipName(name);
+    else if (part==1) item = jsvSkipName(valueName);
+    else {
+      JsVar *pair[2];
+      pair[0] = jsvSkipName(name);
+      pair[1] = jsvSkipName(valueName);
+      item = jsvNewArray(pair, 2);
+      jsvUnLock2(pair[0], pair[1]);
+    }
+    jsvArrayPushAndUnLock(arr, item);
+    ref = jsvGetNextSibling(valueName);
+    jsvUnLock2(valueName, name);
+  }
+  jsvUnLock(entries);
+  return arr;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "keys",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_keys",
+  "return" : ["JsVar","An Array of keys"]
+}
+Return the keys, in the order they were added. Espruino doesn't have ES6 iterators, so this is an Array.
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "keys",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_keys",
+  "return" : ["JsVar","An Array of values"]
+}
+The same as `Set.values`
+*/
+JsVar *jswrap_map_keys(JsVar *parent) {
+  return jswrap_map_toArray(parent, 0);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "values",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_values",
+  "return" : ["JsVar","An Array of values"]
+}
+Return the values, in the order their keys were added. Espruino doesn't have ES6 iterators, so this is an Array.
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "values",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_values",
+  "return" : ["JsVar","An Array of values"]
+}
+Return the values, in the order they were added. Espruino doesn't have ES6 iterators, so this is an Array.
+*/
+JsVar *jswrap_map_values(JsVar *parent) {
+  return jswrap_map_toArray(parent, 1);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Map",
+  "name" : "entries",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_entries",
+  "return" : ["JsVar","An Array of [key, value] pairs"]
+}
+Return `[key, value]` pairs, in the order they were added. Espruino doesn't have ES6 iterators, so this is an Array.
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "Set",
+  "name" : "entries",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_map_entries",
+  "return" : ["JsVar","An Array of [value, value] pairs"]
+}
+Return `[value, value]` pairs, in the order they were added. Espruino doesn't have ES6 iterators, so this is an Array.
+*/
+JsVar *jswrap_map_entries(JsVar *parent) {
+  return jswrap_map_toArray(parent, 2);
+}
+
+#endif // SAVE_ON_FLASH
@@ -0,0 +1,39 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * ES6 Map and Set, backed by a hash table
+ * ----------------------------------------------------------------------------
+ */
+#include "jsvar.h"
+#include "jswrapper.h"
+
+/// Internal state for each Map or Set - see JSW_NATIVE_STATE
+typedef struct {
+  bool isMap;     ///< Map stores key,value pairs in its entries array - Set just stores keys
+  JsVarInt count; ///< Number of entries
+  JsVarInt used;  ///< Number of hash table slots that aren't empty (entries + deleted slots)
+} JswMapState;
+JSW_NATIVE_STATE(Map, JswMapState)
+JSW_NATIVE_STATE(Set, JswMapState)
+
+void jswrap_map_copyState(JsVar *src, JsVar *dst);
+JsVar *jswrap_map_constructor(JsVar *iterable);
+JsVar *jswrap_set_constructor(JsVar *iterable);
+JsVar *jswrap_map_size(JsVar *parent);
+JsVar *jswrap_map_get(JsVar *parent, JsVar *key);
+JsVar *jswrap_map_set(JsVar *parent, JsVar *key, JsVar *value);
+JsVar *jswrap_set_add(JsVar *parent, JsVar *value);
+bool jswrap_map_has(JsVar *parent, JsVar *key);
+bool jswrap_map_delete(JsVar *parent, JsVar *key);
+void jswrap_map_clear(JsVar *parent);
+void jswrap_map_forEach(JsVar *parent, JsVar *funcVar, JsVar *thisArg);
+JsVar *jswrap_map_keys(JsVar *parent);
+JsVar *jswrap_map_values(JsVar *parent);
+JsVar *jswrap_map_entries(JsVar *parent);
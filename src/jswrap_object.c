@@ -172,11 +172,9 @@ Returns an array of all properties (enumerable or not) found directly on a given
  **Note:** This doesn't currently work as it should for built-in objects and their prototypes. See bug #380
  */
 
-/** This is for Object.keys and Object. However it uses a callback so doesn't allocate anything */
-void jswrap_object_keys_or_property_names_cb(
+/// Call the callback for each of the object's own (visible) keys. These are always unique
+static void jswrap_object_own_keys_cb(
     JsVar *obj,
-    bool includeNonEnumerable,  ///< include 'hidden' items
-    bool includePrototype, ///< include items for the prototype too (for autocomplete)
     void (*callback)(void *data, JsVar *name),
     void *data
 ) {
@@ -203,56 +201,122 @@ void jswrap_object_keys_or_property_names_cb(
     }
     jsvIteratorFree(&it);
   }
+}
 
+/// Call the callback for each of the object's builtin (non-enumerable) symbols. These may duplicate own keys
+static void jswrap_object_builtin_keys_cb(
+    JsVar *obj,
+    bool includePrototype,
+    void (*callback)(void *data, JsVar *name),
+    void *data
+) {
   /* Search our built-in symbol table
      Assume that ALL builtins are non-enumerable. This isn't great but
      seems to work quite well right now! */
-  if (includeNonEnumerable) {
-    const JswSymList *symbols = 0;
-
-    JsVar *protoOwner = jspGetPrototypeOwner(obj);
-    if (protoOwner) {
-      // If protoOwner then this is the prototype (protoOwner is the object)
-      symbols = jswGetSymbolListForObjectProto(protoOwner);
-      jsvUnLock(protoOwner);
-    } else if (!jsvIsObject(obj) || jsvIsRoot(obj)) {
-      // get symbols, but only if we're not doing it on a basic object
-      symbols = jswGetSymbolListForObject(obj);
-    }
+  const JswSymList *symbols = 0;
+
+  JsVar *protoOwner = jspGetPrototypeOwner(obj);
+  if (protoOwner) {
+    // If protoOwner then this is the prototype (protoOwner is the object)
+    symbols = jswGetSymbolListForObjectProto(protoOwner);
+    jsvUnLock(protoOwner);
+  } else if (!jsvIsObject(obj) || jsvIsRoot(obj)) {
+    // get symbols, but only if we're not doing it on a basic object
+    symbols = jswGetSymbolListForObject(obj);
+  }
 
-    while (symbols) {
-      unsigned int i;
-      unsigned char symbolCount = READ_FLASH_UINT8(&symbols->symbolCount);
-      for (i=0;i<symbolCount;i++) {
-        unsigned short strOffset = READ_FLASH_UINT16(&symbols->symbols[i].strOffset);
+  while (symbols) {
+    unsigned int i;
+    unsigned char symbolCount = READ_FLASH_UINT8(&symbols->symbolCount);
+    for (i=0;i<symbolCount;i++) {
+      unsigned short strOffset = READ_FLASH_UINT16(&symbols->symbols[i].strOffset);
 #ifndef USE_FLASH_MEMORY
-        JsVar *name = jsvNewFromString(&symbols->symbolChars[strOffset]);
+      JsVar *name = jsvNewFromString(&symbols->symbolChars[strOffset]);
 #else
-        // On the esp8266 the string is in flash, so we have to copy it to RAM first
-        // We can't use flash_strncpy here because it assumes that strings start on a word
-        // boundary and that's not the case here.
-        char buf[64], *b = buf, c; const char *s = &symbols->symbolChars[strOffset];
-        do { c = READ_FLASH_UINT8(s++); *b++ = c; } while (c && b != buf+64);
-        JsVar *name = jsvNewFromString(buf);
+      // On the esp8266 the string is in flash, so we have to copy it to RAM first
+      // We can't use flash_strncpy here because it assumes that strings start on a word
+      // boundary and that's not the case here.
+      char buf[64], *b = buf, c; const char *s = &symbols->symbolChars[strOffset];
+      do { c = READ_FLASH_UINT8(s++); *b++ = c; } while (c && b != buf+64);
+      JsVar *name = jsvNewFromString(buf);
 #endif
-        //os_printf_plus("OBJ cb %s\n", buf);
-        callback(data, name);
-        jsvUnLock(name);
-      }
+      //os_printf_plus("OBJ cb %s\n", buf);
+      callback(data, name);
+      jsvUnLock(name);
+    }
 
-      symbols = 0;
-      if (includePrototype) {
-        includePrototype = false;
-        symbols = jswGetSymbolListForObjectProto(obj);
-      }
+    symbols = 0;
+    if (includePrototype) {
+      includePrototype = false;
+      symbols = jswGetSymbolListForObjectProto(obj);
     }
+  }
 
-    if (jsvIsArray(obj) || jsvIsString(obj)) {
-      JsVar *name = jsvNewFromString("length");
-      callback(data, name);
-      jsvUnLock(name);
+  if (jsvIsArray(obj) || jsvIsString(obj)) {
+    JsVar *name = jsvNewFromString("length");
+    callback(data, name);
+    jsvUnLock(name);
+  }
+}
+
+/** This is for Object.keys and Object. However it uses a callback so doesn't allocate anything */
+void jswrap_object_keys_or_property_names_cb(
+    JsVar *obj,
+    bool includeNonEnumerable,  ///< include 'hidden' items
+    bool includePrototype, ///< include items for the prototype too (for autocomplete)
+    void (*callback)(void *data, JsVar *name),
+    void *data
+) {
+  jswrap_object_own_keys_cb(obj, callback, data);
+  if (includeNonEnumerable)
+    jswrap_object_builtin_keys_cb(obj, includePrototype, callback, data);
+}
+
+#define JSWRAP_OBJECT_KEYS_HASH_BITS 256
+typedef struct {
+  JsVar *arr; ///< The array of keys we're building
+  uint32_t hashes[JSWRAP_OBJECT_KEYS_HASH_BITS/32]; ///< Transient hash set of the keys in arr. If a key's bit is clear it's definitely not in arr
+} JswObjectKeysData;
+
+static unsigned int jswrap_object_keys_hash(JsVar *name) {
+  unsigned int h = 0;
+  if (jsvIsInt(name)) {
+    h = (unsigned int)name->varData.integer;
+  } else if (jsvIsString(name)) {
+    JsvStringIterator it;
+    jsvStringIteratorNewBorrowed(&it, name, 0);
+    while (jsvStringIteratorHasChar(&it)) {
+      h = h*31 + (unsigned char)jsvStringIteratorGetChar(&it);
+      jsvStringIteratorNextBorrowed(&it);
+    }
+  }
+  return h % JSWRAP_OBJECT_KEYS_HASH_BITS;
+}
+
+/// Own keys are already unique, so we just add them (and remember their hash)
+static void jswrap_object_keys_add(JswObjectKeysData *data, JsVar *name) {
+  unsigned int h = jswrap_object_keys_hash(name);
+  data->hashes[h>>5] |= 1U<<(h&31);
+  jsvArrayPush(data->arr, name);
+}
+
+/// Just add own keys to the array (when we don't need the hashes)
+static void jswrap_object_keys_push(JsVar *arr, JsVar *name) {
+  jsvArrayPush(arr, name);
+}
+
+/// Builtin symbols may already be in the array - only do a full search if the hash says they might be
+static void jswrap_object_keys_add_unique(JswObjectKeysData *data, JsVar *name) {
+  unsigned int h = jswrap_object_keys_hash(name);
+  if (data->hashes[h>>5] & (1U<<(h&31))) {
+    JsVar *idx = jsvGetArrayIndexOf(data->arr, name, false);
+    if (idx) {
+      jsvUnLock(idx);
+      return;
     }
   }
+  data->hashes[h>>5] |= 1U<<(h&31);
+  jsvArrayPush(data->arr, name);
 }
 
 JsVar *jswrap_object_keys_or_property_names(
@@ -260,12 +324,21 @@ JsVar *jswrap_object_keys_or_property_names(
     bool includeNonEnumerable,  ///< include 'hidden' items
     bool includePrototype ///< include items for the prototype too (for autocomplete)
     ) {
-  JsVar *arr = jsvNewEmptyArray();
-  if (!arr) return 0;
+  JswObjectKeysData data;
+  data.arr = jsvNewEmptyArray();
+  if (!data.arr) return 0;
+  memset(data.hashes, 0, sizeof(data.hashes));
 
-  jswrap_object_keys_or_property_names_cb(obj, includeNonEnumerable, includePrototype, (void (*)(void *, JsVar *))jsvArrayAddUnique, arr);
+  /* An object's own keys can't contain duplicates, so we only need to check
+   * for them when we merge in the builtin symbols */
+  if (includeNonEnumerable) {
+    jswrap_object_own_keys_cb(obj, (void (*)(void *, JsVar *))jswrap_object_keys_add, &data);
+    jswrap_object_builtin_keys_cb(obj, includePrototype, (void (*)(void *, JsVar *))jswrap_object_keys_add_unique, &data);
+  } else {
+    jswrap_object_own_keys_cb(obj, (void (*)(void *, JsVar *))jswrap_object_keys_push, data.arr);
+  }
 
-  return arr;
+  return data.arr;
 }
 
 /*JSON{
@@ -845,18 +918,33 @@ JsVar *jswrap_function_apply_or_call(JsVar *parent, JsVar *thisArg, JsVar *argsA
     }
     args = (JsVar**)alloca((size_t)argC * sizeof(JsVar*));
     for (i=0;i<argC;i++) args[i] = 0;
-    // TODO: Use jsvGetArrayItems?
-    JsvIterator it;
-    jsvIteratorNew(&it, argsArray);
-    while (jsvIteratorHasElement(&it)) {
-      JsVarInt idx = jsvGetIntegerAndUnLock(jsvIteratorGetKey(&it));
-      if (idx>=0 && idx<(int)argC) {
-        assert(!args[idx]); // just in case there were dups
-        args[idx] = jsvIteratorGetValue(&it);
+    if (jsvIsArray(argsArray)) {
+      // Fast path - walk the array's indices directly, only locking the values we pass on
+      JsVarRef childref = jsvGetFirstChild(argsArray);
+      while (childref) {
+        JsVar *child = jsvGetAddressOfBorrowed(childref);
+        childref = jsvGetNextSibling(child);
+        if (jsvIsInt(child)) {
+          JsVarInt idx = child->varData.integer;
+          if (idx>=0 && idx<(int)argC) {
+            assert(!args[idx]); // just in case there were dups
+            args[idx] = jsvSkipName(child);
+          }
+        }
       }
-      jsvIteratorNext(&it);
+    } else {
+      JsvIterator it;
+      jsvIteratorNew(&it, argsArray);
+      while (jsvIteratorHasElement(&it)) {
+        JsVarInt idx = jsvGetIntegerAndUnLock(jsvIteratorGetKey(&it));
+        if (idx>=0 && idx<(int)argC) {
+          assert(!args[idx]); // just in case there were dups
+          args[idx] = jsvIteratorGetValue(&it);
+        }
+        jsvIteratorNext(&it);
+      }
+      jsvIteratorFree(&it);
     }
-    jsvIteratorFree(&it);
   } else if (!jsvIsUndefined(argsArray)) {
     jsExceptionHere(JSET_ERROR, "Second argument to Function.apply must be iterable, got %t", argsArray);
     return 0;
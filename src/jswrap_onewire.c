@@ -19,12 +19,15 @@
 
 /*JSON{
   "type" : "class",
-  "class" : "OneWire"
+  "class" : "OneWire",
+  "state" : "JswOneWireState"
 }
 This class provides a software-defined OneWire master. It is designed to be similar to Arduino's OneWire library.
  */
 
 static Pin onewire_getpin(JsVar *parent) {
+  JswOneWireState *state = jswGetState_OneWire(parent);
+  if (state) return state->pin;
   return jshGetPinFromVarAndUnLock(jsvObjectGetChild(parent, "pin", 0));
 }
 
@@ -103,6 +106,8 @@ Create a software OneWire implementation on the given pin
 JsVar *jswrap_onewire_constructor(Pin pin) {
   JsVar *ow = jspNewObject(0, "OneWire");
   if (!ow) return 0;
+  JswOneWireState *state = jswNewState_OneWire(ow);
+  if (state) state->pin = pin;
   jsvObjectSetChildAndUnLock(ow, "pin", jsvNewFromPin(pin));
   return ow;
 }
@@ -13,6 +13,13 @@
  */
 #include "jsvar.h"
 #include "jspin.h"
+#include "jswrapper.h"
+
+/// Internal state for each OneWire - see JSW_NATIVE_STATE
+typedef struct {
+  Pin pin;
+} JswOneWireState;
+JSW_NATIVE_STATE(OneWire, JswOneWireState)
 
 JsVar *jswrap_onewire_constructor(Pin pin);
 bool jswrap_onewire_reset(JsVar *parent);
@@ -183,12 +183,24 @@ Unless `force` is set to true, changes in the connection state of the board
   "generate" : "jswrap_serial_setup",
   "params" : [
     ["baudrate","JsVar","The baud rate - the default is 9600"],
-    ["options","JsVar",["An optional structure containing extra information on initialising the serial port.","```{rx:pin,tx:pin,bytesize:8,parity:null/'none'/'o'/'odd'/'e'/'even',stopbits:1,flow:null/undefined/'none'/'xon'}```","You can find out which pins to use by looking at [your board's reference page](#boards) and searching for pins with the `UART`/`USART` markers.","Note that even after changing the RX and TX pins, if you have called setup before then the previous RX and TX pins will still be connected to the Serial port as well - until you set them to something else using digitalWrite"]]
+    ["options","JsVar",["An optional structure containing extra information on initialising the serial port.","```{rx:pin,tx:pin,bytesize:8,parity:null/'none'/'o'/'odd'/'e'/'even',stopbits:1,flow:null/undefined/'none'/'xon',txOverflow:undefined/'block'/'dropNewest'/'dropOldest'/'queue'}```","You can find out which pins to use by looking at [your board's reference page](#boards) and searching for pins with the `UART`/`USART` markers.","Note that even after changing the RX and TX pins, if you have called setup before then the previous RX and TX pins will still be connected to the Serial port as well - until you set them to something else using digitalWrite"]]
   ]
 }
 Setup this Serial port with the given baud rate and options.
 
 If not specified in options, the default pins are used (usually the lowest numbered pins on the lowest port that supports this peripheral)
+
+`txOverflow` says what happens when you write faster than the data can be sent
+and the output buffer fills up:
+
+* `'block'` (the default) - wait until there is space, so nothing is lost but
+everything else stops
+* `'dropNewest'` - throw away the data being written
+* `'dropOldest'` - throw away the oldest data that hasn't been sent yet
+* `'queue'` - store the data in memory (up to 1024 bytes) and send it when
+Espruino is idle
+
+Anything that is thrown away is counted - see `Serial.getDropped()`.
  */
 void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
   IOEventFlags device = jsiGetDeviceFromClass(parent);
@@ -204,6 +216,10 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
 
   JsVar *parity = 0;
   JsVar *flow = 0;
+  JsVar *txOverflow = 0;
+#ifdef LINUX
+  JsVar *path = 0;
+#endif
   jsvConfigObject configs[] = {
       {"rx", JSV_PIN, &inf.pinRX},
       {"tx", JSV_PIN, &inf.pinTX},
@@ -212,6 +228,10 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
       {"stopbits", JSV_INTEGER, &inf.stopbits},
       {"parity", JSV_OBJECT /* a variable */, &parity},
       {"flow", JSV_OBJECT /* a variable */, &flow},
+      {"txOverflow", JSV_OBJECT /* a variable */, &txOverflow},
+#ifdef LINUX
+      {"path", JSV_OBJECT /* a variable */, &path},
+#endif
   };
 
 
@@ -224,8 +244,10 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
       inf.baudRate = b;
   }
 
-  bool ok = true;
-  if (jsvReadConfigObject(options, configs, sizeof(configs) / sizeof(jsvConfigObject))) {
+  JshTxOverflowPolicy txPolicy = JSH_TX_OVERFLOW_BLOCK;
+  // if the options are bad, leave everything (including the overflow policy and dropped count) as it was
+  bool ok = jsvReadConfigObject(options, configs, sizeof(configs) / sizeof(jsvConfigObject));
+  if (ok) {
     // sort out parity
     inf.parity = 0;
     if(jsvIsString(parity)) {
@@ -252,19 +274,39 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
       }
     }
 
+    if (ok) {
+      if (jsvIsUndefined(txOverflow) || jsvIsStringEqual(txOverflow, "block"))
+        txPolicy = JSH_TX_OVERFLOW_BLOCK;
+      else if (jsvIsStringEqual(txOverflow, "dropNewest"))
+        txPolicy = JSH_TX_OVERFLOW_DROP_NEWEST;
+      else if (jsvIsStringEqual(txOverflow, "dropOldest"))
+        txPolicy = JSH_TX_OVERFLOW_DROP_OLDEST;
+      else if (jsvIsStringEqual(txOverflow, "queue"))
+        txPolicy = JSH_TX_OVERFLOW_QUEUE;
+      else {
+        jsExceptionHere(JSET_ERROR, "Invalid txOverflow: %q", txOverflow);
+        ok = false;
+      }
+    }
+
 #ifdef LINUX
     if (ok && jsvIsObject(options))
-      jsvObjectSetChildAndUnLock(parent, "path", jsvObjectGetChild(options, "path", 0));
+      jsvObjectSetChild(parent, "path", path);
 #endif
   }
+#ifdef LINUX
+  jsvUnLock(path);
+#endif
   jsvUnLock(parity);
   jsvUnLock(flow);
+  jsvUnLock(txOverflow);
   if (!ok) {
     jsvUnLock(options);
     return;
   }
 
   jshUSARTSetup(device, &inf);
+  jshSetTxOverflowPolicy(device, txPolicy);
   // Set baud rate in object, so we can initialise it on startup
   jsvObjectSetChildAndUnLock(parent, USART_BAUDRATE_NAME, jsvNewFromInteger(inf.baudRate));
   // Do the same for options
@@ -274,6 +316,18 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
     jsvRemoveNamedChild(parent, DEVICE_OPTIONS_NAME);
 }
 
+/*JSON{
+  "type" : "method",
+  "class" : "Serial",
+  "name" : "getDropped",
+  "generate_full" : "(JsVarInt)jshGetTxDroppedCount(jsiGetDeviceFromClass(parent))",
+  "return" : ["int","The number of bytes thrown away"]
+}
+Return how many bytes written to this Serial port have been thrown away
+because the output buffer was full, since `Serial.setup` was last called.
+
+This is always 0 unless `txOverflow` was set in `Serial.setup`'s options.
+ */
 
 static void _jswrap_serial_print_cb(int data, void *userData) {
   IOEventFlags device = *(IOEventFlags*)userData;
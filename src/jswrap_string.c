@@ -15,6 +15,7 @@
  */
 #include "jswrap_string.h"
 #include "jsvariterator.h"
+#include "jsparse.h" // for jspIsInterrupted
 
 /*JSON{
   "type" : "class",
@@ -189,7 +190,7 @@ int jswrap_string_indexOf(JsVar *parent, JsVar *substring, JsVar *fromIndex, boo
     }
   }
 
-  for (;idx!=end;idx+=dir) {
+  for (;idx!=end && !jspIsInterrupted();idx+=dir) {
     if (jsvCompareString(parent, substring, (size_t)idx, 0, true)==0) {
       jsvUnLock(substring);
       return idx;
@@ -334,7 +335,7 @@ JsVar *jswrap_string_split(JsVar *parent, JsVar *split) {
   int splitlen = jsvIsUndefined(split) ? 0 : (int)jsvGetStringLength(split);
   int l = (int)jsvGetStringLength(parent) + 1 - splitlen;
 
-  for (idx=0;idx<=l;idx++) {
+  for (idx=0;idx<=l && !jspIsInterrupted();idx++) {
     if (splitlen==0 && idx==0) continue; // special case for where split string is ""
     if (idx==l || splitlen==0 || jsvCompareString(parent, split, (size_t)idx, 0, true)==0) {
       if (idx==l) {
@@ -27,7 +27,8 @@
 /*JSON{
   "type" : "class",
   "ifndef" : "SAVE_ON_FLASH",
-  "class" : "Waveform"
+  "class" : "Waveform",
+  "state" : "JswWaveformState"
 }
 This class handles waveforms. In Espruino, a Waveform is a set of data that you want to input or output.
  */
@@ -59,8 +60,9 @@ bool jswrap_waveform_idle() {
     jsvObjectIteratorNew(&it, waveforms);
     while (jsvObjectIteratorHasValue(&it)) {
       JsVar *waveform = jsvObjectIteratorGetValue(&it);
+      JswWaveformState *state = jswGetState_Waveform(waveform);
 
-      bool running = jsvGetBoolAndUnLock(jsvObjectGetChild(waveform, "running", 0));
+      bool running = state && state->running;
       if (running) {
         JsVar *buffer = jswrap_waveform_getBuffer(waveform,0,0);
         UtilTimerTask task;
@@ -71,17 +73,17 @@ bool jswrap_waveform_idle() {
           jsiQueueObjectCallbacks(waveform, JS_EVENT_PREFIX"finish", &arrayBuffer, 1);
           jsvUnLock(arrayBuffer);
           running = false;
+          state->running = false;
           jsvObjectSetChildAndUnLock(waveform, "running", jsvNewFromBool(running));
         } else {
           // If the timer task is still there...
           if (task.data.buffer.nextBuffer &&
               task.data.buffer.nextBuffer != task.data.buffer.currentBuffer) {
             // if it is a double-buffered task
-            int currentBuffer = (jsvGetRef(buffer)==task.data.buffer.currentBuffer) ? 0 : 1;
-            int oldBuffer = jsvGetIntegerAndUnLock(jsvObjectGetChild(waveform, "currentBuffer", JSV_INTEGER));
-            if (oldBuffer != currentBuffer) {
+            unsigned char currentBuffer = (jsvGetRef(buffer)==task.data.buffer.currentBuffer) ? 0 : 1;
+            if (state->currentBuffer != currentBuffer) {
               // buffers have changed - fire off a 'buffer' event with the buffer that needs to be filled
-              jsvObjectSetChildAndUnLock(waveform, "currentBuffer", jsvNewFromInteger(currentBuffer));
+              state->currentBuffer = currentBuffer;
               JsVar *arrayBuffer = jsvObjectGetChild(waveform, (currentBuffer==0) ? "buffer2" : "buffer", 0);
               jsiQueueObjectCallbacks(waveform, JS_EVENT_PREFIX"buffer", &arrayBuffer, 1);
               jsvUnLock(arrayBuffer);
@@ -115,13 +117,14 @@ void jswrap_waveform_kill() { // be sure to remove all waveforms...
     jsvObjectIteratorNew(&it, waveforms);
     while (jsvObjectIteratorHasValue(&it)) {
       JsVar *waveform = jsvObjectIteratorGetValue(&it);
-      bool running = jsvGetBoolAndUnLock(jsvObjectGetChild(waveform, "running", 0));
-      if (running) {
+      JswWaveformState *state = jswGetState_Waveform(waveform);
+      if (state && state->running) {
         JsVar *buffer = jswrap_waveform_getBuffer(waveform,0,0);
         if (!jstStopBufferTimerTask(buffer)) {
           jsExceptionHere(JSET_ERROR, "Waveform couldn't be stopped");
         }
         jsvUnLock(buffer);
+        state->running = false;
       }
       jsvUnLock(waveform);
       // if not running, remove waveform from this list
@@ -176,8 +179,8 @@ JsVar *jswrap_waveform_constructor(int samples, JsVar *options) {
   if (doubleBuffer) arrayBuffer2 = jsvNewTypedArray(bufferType, samples);
   JsVar *waveform = jspNewObject(0, "Waveform");
 
-
-  if (!waveform || !arrayBuffer || (doubleBuffer && !arrayBuffer2)) {
+  if (!waveform || !arrayBuffer || (doubleBuffer && !arrayBuffer2) ||
+      !jswNewState_Waveform(waveform)) {
     jsvUnLock3(waveform,arrayBuffer,arrayBuffer2); // out of memory
     return 0;
   }
@@ -188,8 +191,12 @@ JsVar *jswrap_waveform_constructor(int samples, JsVar *options) {
 }
 
 static void jswrap_waveform_start(JsVar *waveform, Pin pin, JsVarFloat freq, JsVar *options, bool isWriting) {
-  bool running = jsvGetBoolAndUnLock(jsvObjectGetChild(waveform, "running", 0));
-  if (running) {
+  JswWaveformState *state = jswGetState_Waveform(waveform);
+  if (!state) {
+    jsExceptionHere(JSET_ERROR, "Not a Waveform");
+    return;
+  }
+  if (state->running) {
     jsExceptionHere(JSET_ERROR, "Waveform is already running");
     return;
   }
@@ -229,6 +236,8 @@ static void jswrap_waveform_start(JsVar *waveform, Pin pin, JsVarFloat freq, JsV
   // And finally set it up
   if (!jstStartSignal(startTime, jshGetTimeFromMilliseconds(1000.0 / freq), pin, buffer, repeat?(buffer2?buffer2:buffer):0, eventType))
     jsWarn("Unable to schedule a timer");
+  state->running = true;
+  state->currentBuffer = 0;
   jsvUnLock2(buffer,buffer2);
 
   jsvObjectSetChildAndUnLock(waveform, "running", jsvNewFromBool(true));
@@ -290,8 +299,8 @@ void jswrap_waveform_startInput(JsVar *waveform, Pin pin, JsVarFloat freq, JsVar
 Stop a waveform that is currently outputting
  */
 void jswrap_waveform_stop(JsVar *waveform) {
-  bool running = jsvGetBoolAndUnLock(jsvObjectGetChild(waveform, "running", 0));
-  if (!running) {
+  JswWaveformState *state = jswGetState_Waveform(waveform);
+  if (!state || !state->running) {
     jsExceptionHere(JSET_ERROR, "Waveform is not running");
     return;
   }
@@ -12,6 +12,14 @@
  * ----------------------------------------------------------------------------
  */
 #include "jshardware.h"
+#include "jswrapper.h"
+
+/// Internal state for each Waveform - see JSW_NATIVE_STATE
+typedef struct {
+  bool running;
+  unsigned char currentBuffer; ///< Which buffer the timer is using (when double-buffered)
+} JswWaveformState;
+JSW_NATIVE_STATE(Waveform, JswWaveformState)
 
 bool jswrap_waveform_idle();
 void jswrap_waveform_kill();
@@ -80,12 +80,36 @@ typedef struct {
   unsigned char symbolCount;
 } PACKED_JSW_SYM JswSymList;
 
+/// A built-in symbol that has been found, copied out of its symbol table
+typedef struct {
+  void (*functionPtr)(void);
+  unsigned short functionSpec; // JsnArgumentType
+} JswBuiltInSymbol;
+
+/// Do a binary search of the symbol table list, and fill in 'symbol' if 'name' is found
+bool jswBinarySearchSymbol(const JswSymList *symbolsPtr, const char *name, JswBuiltInSymbol *symbol);
+
 /// Do a binary search of the symbol table list
 JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name);
 
+#define JSW_NATIVE_FUNCTION_CACHE_NAME "nfCache" ///< Name of the cache of functions for built-in symbols in hiddenRoot
+#define JSW_NATIVE_FUNCTION_CACHE_SIZE 16 ///< Maximum number of functions for built-in symbols in the cache
+
+/// Get a function for a built-in symbol (which isn't JSWAT_EXECUTE_IMMEDIATELY), reusing one from the cache if we can
+JsVar *jswGetNativeFunction(const JswBuiltInSymbol *symbol);
+
+/** Call a native function. Argument specifiers used by builtins have a generated thunk that
+ * converts the arguments and calls the function directly, anything else falls back to jsnCallFunction.
+ * With SAVE_ON_FLASH the thunks aren't generated and everything uses jsnCallFunction */
+JsVar *jswCallFunction(void *function, JsnArgumentType argumentSpecifier, JsVar *thisParam, JsVar **paramData, int paramCount);
+
 /** If 'name' is something that belongs to an internal function, execute it.  */
 JsVar *jswFindBuiltInFunction(JsVar *parent, const char *name);
 
+/** Like jswFindBuiltInFunction, but just find the symbol for 'name' in 'parent' (which mustn't
+ * be 0 or root) without calling or creating anything. Returns false if there isn't one */
+bool jswFindBuiltInSymbol(JsVar *parent, const char *name, JswBuiltInSymbol *symbol);
+
 /// Given an object, return the list of symbols for it
 const JswSymList *jswGetSymbolListForObject(JsVar *parent);
 
@@ -109,6 +133,22 @@ const char *jswGetBasicObjectName(JsVar *var);
  *  */
 const char *jswGetBasicObjectPrototypeName(const char *name);
 
+/** Declare the functions build_jswrapper.py generates for a class with `"state" : "TYPE"` in
+ * its JSON definition. jswNewState_CLASS adds a zeroed TYPE to a new instance (do this in the
+ * constructor, before anything else adds native state) and jswGetState_CLASS returns it
+ * without a search - or 0 if 'parent' doesn't have one, or has one of a different TYPE. The
+ * block is tagged with TYPE (not CLASS), so classes that declare the same TYPE (eg. Map and
+ * Set) will accept each other's instances. */
+#define JSW_NATIVE_STATE(CLASS, TYPE) \
+  TYPE *jswNewState_##CLASS(JsVar *parent); \
+  TYPE *jswGetState_##CLASS(JsVar *parent);
+
+/** Called by jsvCopy once 'dst' has its own copy of src's native state block (tagged 'typeId').
+ * jsvCopy only links dst's other children to the same values, so a class whose state refers to
+ * those (eg. Map's hash table) sets `"copystate"` in its JSON definition to make the copy
+ * independent. */
+void jswCopyState(JsVar *src, JsVar *dst, unsigned char typeId);
+
 /** Tasks to run on Idle. Returns true if either one of the tasks returned true (eg. they're doing something and want to avoid sleeping) */
 bool jswIdle();
 
@@ -16,6 +16,7 @@
  #include <stdio.h>
  #include <unistd.h>
  #include <sys/time.h>
+ #include <time.h>
 #ifdef __MINGW32__
  #include <conio.h>
 #else//!__MINGW32__
@@ -30,6 +31,7 @@
 #include "jsutils.h"
 #include "jsparse.h"
 #include "jsinteractive.h"
+#include "jstimer.h"
 
 #include <pthread.h>
 
@@ -92,6 +94,30 @@ JsVarInt sysfs_read_int(const char *path) {
   sysfs_read(path, buf, sizeof(buf));
   return stringToIntWithRadix(buf, 10, 0);
 }
+
+/* The 'value' file of each exported pin is opened once and kept open, so
+ * reading or writing a pin is a single pread/pwrite rather than
+ * open/write/close with a freshly built path every time */
+int gpioValueFile[JSH_PIN_COUNT]; // file descriptor for gpioN/value, or -1
+char gpioLastWritten[JSH_PIN_COUNT]; // '0'/'1' last written to an output, or 0 if unknown
+
+static void sysfs_gpio_path(Pin pin, const char *file, char *path) {
+  strcpy(path, SYSFS_GPIO_DIR"/gpio");
+  itostr(pin, &path[strlen(path)], 10);
+  strcat(path, file);
+}
+
+static int sysfs_gpio_value_file(Pin pin) {
+  if (gpioValueFile[pin]<0) {
+    // may fail right after export while udev sets permissions - so we retry next time
+    char path[sizeof(SYSFS_GPIO_DIR)+24];
+    sysfs_gpio_path(pin, "/value", path);
+    gpioValueFile[pin] = open(path, O_RDWR);
+    if (gpioValueFile[pin]<0)
+      gpioValueFile[pin] = open(path, O_RDONLY);
+  }
+  return gpioValueFile[pin];
+}
 #endif
 // ----------------------------------------------------------------------------
 #ifdef USE_WIRINGPI
@@ -134,6 +160,12 @@ void (*irqEXTIs[16])(void) = {
 #endif
 // ----------------------------------------------------------------------------
 IOEventFlags gpioEventFlags[JSH_PIN_COUNT];
+#if !defined(SYSFS_GPIO_DIR) && !defined(USE_WIRINGPI)
+/* No real GPIO. Pins remember what they were set to, and changing a watched
+ * pin pushes an EXTI event just like an interrupt would - so that watches can
+ * be tested */
+bool gpioSimState[JSH_PIN_COUNT];
+#endif
 
 IOEventFlags pinToEVEXTI(Pin pin) {
   return gpioEventFlags[pin];
@@ -221,8 +253,8 @@ int getch()
 {
     int r;
     unsigned char c;
-    if ((r = (int)read(STDIN_FILENO, &c, sizeof(c))) < 0) {
-        return r;
+    if ((r = (int)read(STDIN_FILENO, &c, sizeof(c))) <= 0) {
+        return -1; // error, or end of file
     } else {
         return c;
     }
@@ -232,6 +264,45 @@ int getch()
 pthread_t inputThread;
 bool isInitialised;
 
+/* The utility timer runs in its own thread, which sleeps on a condition
+ * variable until the next task is due. The same (recursive) mutex stands in
+ * for 'interrupts off', so the main thread's jshInterruptOff/On excludes the
+ * timer handler just like disabling the timer IRQ would on a microcontroller */
+pthread_t utilTimerThread;
+pthread_mutex_t utilTimerMutex;
+pthread_cond_t utilTimerCond; ///< uses CLOCK_MONOTONIC
+bool utilTimerActive;
+JsSysTime utilTimerTarget; ///< monotonic time (us) at which the timer should fire
+
+/// Microseconds from CLOCK_MONOTONIC - unaffected by changes to the wall clock
+static JsSysTime jshGetMonotonicTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (JsSysTime)ts.tv_sec*1000000L + ts.tv_nsec/1000;
+}
+
+void *jshUtilTimerThread(void *arg) {
+  NOT_USED(arg);
+  pthread_mutex_lock(&utilTimerMutex);
+  while (isInitialised) {
+    if (!utilTimerActive) {
+      pthread_cond_wait(&utilTimerCond, &utilTimerMutex);
+    } else if (jshGetMonotonicTime() >= utilTimerTarget) {
+      // The handler will call jshUtilTimerReschedule if there is more to do
+      utilTimerActive = false;
+      jstUtilTimerInterruptHandler();
+    } else {
+      struct timespec ts;
+      ts.tv_sec = (time_t)(utilTimerTarget / 1000000L);
+      ts.tv_nsec = (long)(utilTimerTarget % 1000000L)*1000;
+      // we recheck the time afterwards, so don't care why we woke up
+      pthread_cond_timedwait(&utilTimerCond, &utilTimerMutex, &ts);
+    }
+  }
+  pthread_mutex_unlock(&utilTimerMutex);
+  return 0;
+}
+
 void jshInputThread() {
   while (isInitialised) {
     bool shortSleep = false;
@@ -244,7 +315,9 @@ void jshInputThread() {
     while (kbhit()) {
       int ch = getch();
       if (ch<0) break;
+      jshInterruptOff(); // the util timer thread may be pushing events too
       jshPushIOCharEvent(EV_USBSERIAL, (char)ch);
+      jshInterruptOn();
     }
     // Read from any open devices - if we have space
     if (jshGetEventsUsed() < IOBUFFERMASK/2) {
@@ -256,7 +329,9 @@ void jshInputThread() {
           int bytes = (int)read(ioDevices[i], buf, sizeof(buf));
           if (bytes>0) {
             //int j; for (j=0;j<bytes;j++) printf("]] '%c'\r\n", buf[j]);
+            jshInterruptOff();
             jshPushIOCharEvents(i, buf, (unsigned int)bytes);
+            jshInterruptOn();
             shortSleep = true;
           }
         }
@@ -282,7 +357,9 @@ void jshInputThread() {
         shortSleep = true;
         bool state = jshPinGetValue(pin);
         if (state != gpioLastState[pin]) {
+          jshInterruptOff();
           jshPushIOEvent(pinToEVEXTI(pin) | (state?EV_EXTI_IS_HIGH:0), jshGetSystemTime());
+          jshInterruptOn();
           gpioLastState[pin] = state;
         }
       }
@@ -333,6 +410,8 @@ void jshInit() {
 #ifdef SYSFS_GPIO_DIR
   for (i=0;i<JSH_PIN_COUNT;i++) {
     gpioShouldWatch[i] = false;    
+    gpioValueFile[i] = -1;
+    gpioLastWritten[i] = 0;
   }
 #endif
 
@@ -340,6 +419,21 @@ void jshInit() {
   int err = pthread_create(&inputThread, NULL, &jshInputThread, NULL);
   if (err != 0)
       printf("Unable to create input thread, %s", strerror(err));
+
+  pthread_mutexattr_t mutexAttr;
+  pthread_mutexattr_init(&mutexAttr);
+  pthread_mutexattr_settype(&mutexAttr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&utilTimerMutex, &mutexAttr);
+  pthread_mutexattr_destroy(&mutexAttr);
+  pthread_condattr_t condAttr;
+  pthread_condattr_init(&condAttr);
+  pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+  pthread_cond_init(&utilTimerCond, &condAttr);
+  pthread_condattr_destroy(&condAttr);
+  utilTimerActive = false;
+  err = pthread_create(&utilTimerThread, NULL, &jshUtilTimerThread, NULL);
+  if (err != 0)
+      printf("Unable to create timer thread, %s", strerror(err));
 }
 
 void jshReset() {
@@ -349,7 +443,13 @@ void jshReset() {
 void jshKill() {
   int i;
 
+  pthread_mutex_lock(&utilTimerMutex);
   isInitialised = false;
+  pthread_cond_signal(&utilTimerCond);
+  pthread_mutex_unlock(&utilTimerMutex);
+  pthread_join(utilTimerThread, NULL);
+  pthread_mutex_destroy(&utilTimerMutex);
+  pthread_cond_destroy(&utilTimerCond);
 
   for (i=0;i<=EV_DEVICE_MAX;i++)
     if (ioDevices[i]) {
@@ -360,14 +460,20 @@ void jshKill() {
 #ifdef SYSFS_GPIO_DIR
 
   // unexport any GPIO that we exported
-  for (i=0;i<JSH_PIN_COUNT;i++)
+  for (i=0;i<JSH_PIN_COUNT;i++) {
+    if (gpioValueFile[i]>=0) {
+      close(gpioValueFile[i]);
+      gpioValueFile[i] = -1;
+    }
     if (gpioState[i] != JSHPINSTATE_UNDEFINED)
       sysfs_write_int(SYSFS_GPIO_DIR"/unexport", i);
+  }
 #endif
 }
 
 void jshIdle() {
-  // all done in the thread now...
+  // all done in the thread now... apart from console output, which jshTransmit buffers
+  fflush(stdout);
 }
 
 // ----------------------------------------------------------------------------
@@ -413,9 +519,11 @@ void jshSetRegistrationCode(unsigned int code) {
 // ----------------------------------------------------------------------------
 
 void jshInterruptOff() {
+  pthread_mutex_lock(&utilTimerMutex);
 }
 
 void jshInterruptOn() {
+  pthread_mutex_unlock(&utilTimerMutex);
 }
 
 void jshDelayMicroseconds(int microsec) {
@@ -427,10 +535,11 @@ void jshPinSetState(Pin pin, JshPinState state) {
   if (gpioState[pin] != state) {
     if (gpioState[pin] == JSHPINSTATE_UNDEFINED)
       sysfs_write_int(SYSFS_GPIO_DIR"/export", pin);
-    char path[64] = SYSFS_GPIO_DIR"/gpio";
-    itostr(pin, &path[strlen(path)], 10);
-    strcat(&path[strlen(path)], "/direction");
+    char path[sizeof(SYSFS_GPIO_DIR)+24];
+    sysfs_gpio_path(pin, "/direction", path);
     sysfs_write(path, JSHPINSTATE_IS_OUTPUT(state)?"out":"in");
+    gpioLastWritten[pin] = 0; // changing direction may have changed the value
+    sysfs_gpio_value_file(pin);
   }
 #endif
 #ifdef USE_WIRINGPI
@@ -458,26 +567,45 @@ JshPinState jshPinGetState(Pin pin) {
 
 void jshPinSetValue(Pin pin, bool value) {
 #ifdef SYSFS_GPIO_DIR
-  char path[64] = SYSFS_GPIO_DIR"/gpio";
-  itostr(pin, &path[strlen(path)], 10);
-  strcat(&path[strlen(path)], "/value");
-  sysfs_write_int(path, value?1:0);
+  /* Only outputs we set ourselves are cached, so writes that wouldn't change
+   * anything (eg. most of the pins in digitalWrite([pins],value)) are skipped.
+   * The cache is forgotten when the direction changes or a read disagrees with it */
+  char ch = value ? '1' : '0';
+  if (gpioLastWritten[pin] != ch) {
+    int f = sysfs_gpio_value_file(pin);
+    if (f>=0 && pwrite(f, &ch, 1, 0)==1)
+      gpioLastWritten[pin] = ch;
+  }
 #endif
 #ifdef USE_WIRINGPI
   digitalWrite(pin,value);
 #endif
+#if !defined(SYSFS_GPIO_DIR) && !defined(USE_WIRINGPI)
+  if (gpioSimState[pin] != value) {
+    gpioSimState[pin] = value;
+    if (gpioEventFlags[pin]) {
+      // we may be on the main thread or the util timer thread (eg. digitalPulse)
+      jshInterruptOff();
+      jshPushIOEvent(gpioEventFlags[pin] | (value?EV_EXTI_IS_HIGH:0), jshGetSystemTime());
+      jshInterruptOn();
+    }
+  }
+#endif
 }
 
 bool jshPinGetValue(Pin pin) {
 #ifdef SYSFS_GPIO_DIR
-  char path[64] = SYSFS_GPIO_DIR"/gpio";
-  itostr(pin, &path[strlen(path)], 10);
-  strcat(&path[strlen(path)], "/value");
-  return sysfs_read_int(path);
+  char ch = '0';
+  int f = sysfs_gpio_value_file(pin);
+  if (f>=0) pread(f, &ch, 1, 0);
+  // something else changed it - so the next jshPinSetValue must really write
+  if (gpioLastWritten[pin] && gpioLastWritten[pin]!=ch)
+    gpioLastWritten[pin] = 0;
+  return ch=='1';
 #elif defined(USE_WIRINGPI)
   return digitalRead(pin);
 #else
-  return false;
+  return gpioSimState[pin];
 #endif
 }
 
@@ -497,6 +625,11 @@ JsVarFloat jshGetMillisecondsFromTime(JsSysTime time) {
 
 #ifdef USE_WIRINGPI
 JsSysTime baseSystemTime = 0;
+#else
+/* Added to the monotonic clock to get the system time. It starts out at the
+ * wall clock time, but after that getTime() never jumps if the clock is set */
+JsSysTime systemTimeOffset = 0;
+bool systemTimeOffsetSet = false;
 #endif
 
 JsSysTime jshGetSystemTime() {
@@ -511,15 +644,22 @@ JsSysTime jshGetSystemTime() {
   lastUs = us;
   return baseSystemTime + (JsSysTime)us;
 #else
-  struct timeval tm;
-  gettimeofday(&tm, 0);
-  return (JsSysTime)(tm.tv_sec)*1000000L + tm.tv_usec;
+  if (!systemTimeOffsetSet) {
+    struct timeval tm;
+    gettimeofday(&tm, 0);
+    systemTimeOffset = (JsSysTime)(tm.tv_sec)*1000000L + tm.tv_usec - jshGetMonotonicTime();
+    systemTimeOffsetSet = true;
+  }
+  return jshGetMonotonicTime() + systemTimeOffset;
 #endif
 }
 
 void jshSetSystemTime(JsSysTime time) {
 #ifdef USE_WIRINGPI
   baseSystemTime = time - micros();
+#else
+  systemTimeOffset = time - jshGetMonotonicTime();
+  systemTimeOffsetSet = true;
 #endif
 }
 
@@ -548,12 +688,24 @@ JshPinFunction jshPinAnalogOutput(Pin pin, JsVarFloat value, JsVarFloat freq, Js
 }
 
 void jshPinPulse(Pin pin, bool value, JsVarFloat time) {
-  if (jshIsPinValid(pin)) {
-    jshPinSetState(pin, JSHPINSTATE_GPIO_OUT);
-    jshPinSetValue(pin, value);
-    usleep(time*1000000);
-    jshPinSetValue(pin, !value);
-  } else jsError("Invalid pin!");
+  if (!jshIsPinValid(pin)) {
+    jsError("Invalid pin!");
+    return;
+  }
+  if (time<=0) {
+    // just wait for everything to complete
+    jstUtilTimerWaitEmpty();
+    return;
+  }
+  // find out if we already had a timer scheduled
+  UtilTimerTask task;
+  if (!jstGetLastPinTimerTask(pin, &task)) {
+    // no timer - just start the pulse now!
+    jshPinOutput(pin, value);
+    task.time = jshGetSystemTime();
+  }
+  // Now set the end of the pulse to happen on the util timer
+  jstPinOutputAtTime(task.time + jshGetTimeFromMilliseconds(time), &pin, 1, !value);
 }
 
 bool jshCanWatch(Pin pin) {
@@ -768,18 +920,30 @@ bool jshSleep(JsSysTime timeUntilWake) {
     usecs=1000; // don't sleep much if we have watches - we need to keep polling them
   if (usecs > 50000)
     usecs = 50000; // don't want to sleep too much (user input/HTTP/etc)
+  fflush(stdout); // don't leave console output waiting while we sleep
   if (usecs >= 1000)  
     usleep(usecs); 
   return true;
 }
 
 void jshUtilTimerDisable() {
+  pthread_mutex_lock(&utilTimerMutex);
+  utilTimerActive = false;
+  pthread_mutex_unlock(&utilTimerMutex);
 }
 
 void jshUtilTimerReschedule(JsSysTime period) {
+  if (period < 0) period = 0;
+  pthread_mutex_lock(&utilTimerMutex);
+  utilTimerTarget = jshGetMonotonicTime() + period;
+  utilTimerActive = true;
+  // wake the timer thread so it waits for the new time (no-op if we're in the handler)
+  pthread_cond_signal(&utilTimerCond);
+  pthread_mutex_unlock(&utilTimerMutex);
 }
 
 void jshUtilTimerStart(JsSysTime period) {
+  jshUtilTimerReschedule(period);
 }
 
 JshPinFunction jshGetCurrentPinFunction(Pin pin) {
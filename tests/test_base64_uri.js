@@ -0,0 +1,22 @@
+// btoa/atob/encodeURIComponent/decodeURIComponent over flat and non-flat data
+var bin = "";
+for (var i=0;i<300;i++) bin += String.fromCharCode((i*7)&255);
+var flat = E.toString(new Uint8Array(300).map(function(x,i){return (i*7)&255;}));
+
+var r = [
+  btoa("")=="", btoa("a")=="YQ==", btoa("ab")=="YWI=", btoa("abc")=="YWJj",
+  btoa([1,2,3,250])=="AQID+g==", btoa(new Uint8Array([1,2,3,4,5]))=="AQIDBAU=",
+  btoa(new Uint16Array([257,2]))=="AQI=",
+  btoa(bin)==btoa(flat), atob(btoa(bin))==bin, atob(btoa(flat))==flat,
+  // chunks that are a multiple of 3 bytes can be encoded separately
+  btoa(bin.substr(0,150))+btoa(bin.substr(150))==btoa(bin),
+  atob("  YWJj")=="abc", atob("YQ==")=="a", atob("YWI")=="ab",
+  encodeURIComponent("Hello World!~*'()-_.,/?&=")=="Hello%20World!~*'()-_.%2C%2F%3F%26%3D",
+  decodeURIComponent("a%20b%2Fc")=="a b/c",
+  decodeURIComponent(encodeURIComponent("x y/z\n\t%"))=="x y/z\n\t%"
+];
+var threw = false;
+try { decodeURIComponent("abc%2"); } catch (e) { threw = true; }
+r.push(threw);
+
+result = r.every(function(x) { return x; });
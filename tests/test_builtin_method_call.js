@@ -0,0 +1,35 @@
+// Built-in methods that are called directly (eg. `a.push(x)`) don't get a function created for them - check they still behave
+var r = [];
+var a = [1,2];
+for (var i=0;i<3;i++) a.push(i);
+r.push(a.join() == "1,2,0,1,2" && a.length == 5);
+r.push(Math.sin(0) == 0 && Math.max(1, 5, 3) == 5);
+// chained calls, and calls on the result of a call
+r.push("Ab".toUpperCase().toLowerCase() == "ab");
+r.push([3,1,2].sort().map(function(x) { return x*2; }).join("-") == "2-4-6");
+// overridden on the object or its prototype
+var o = { push : function(x) { return "mine"+x; } };
+r.push(o.push(1) == "mine1");
+Array.prototype.foo = function() { return "foo"+this.length; };
+r.push([1,2].foo() == "foo2");
+delete Array.prototype.foo;
+// getters are still called
+r.push("hello".length == 5 && new Uint8Array(4).length == 4);
+// used as values
+var max = Math.max;
+r.push(max(1, 7) == 7 && Math.sin === Math.sin && typeof Math.sin == "function");
+r.push(Math.max.apply(null, [4,9,2]) == 9 && Math.max.call(null, 7, 8) == 8);
+var b = [].push.bind(a);
+b(9);
+r.push(a[5] == 9);
+// constructors with members
+var d = new Date(0);
+r.push(d.getTime() == 0 && new Array(3).length == 3);
+// errors in arguments
+var caught = false;
+try { a.push(undefinedVariable); } catch (e) { caught = true; }
+r.push(caught && a.push(1) == a.length);
+// 'this' inside a native call is the object it was called on
+r.push([1,2,3].indexOf(3) == 2 && "abc".charAt(1) == "b");
+
+result = r.every(function(x) { return x; });
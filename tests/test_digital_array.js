@@ -0,0 +1,12 @@
+// Writing and reading groups of pins - the last pin in the array is the least significant bit
+digitalWrite([D1,D2,D3,D4], 0b1010);
+var a = digitalRead([D1,D2,D3,D4]);
+// Rewriting with only some bits changed
+digitalWrite([D1,D2,D3,D4], 0b1011);
+var b = digitalRead([D1,D2,D3,D4]);
+var c = digitalRead([D4,D3,D2,D1]);
+// the same pin more than once - the rightmost bit is written first
+digitalWrite([D5,D5], 0b10);
+var d = digitalRead(D5);
+
+result = a==0b1010 && b==0b1011 && c==0b1101 && d==1 && digitalRead(D1)==1 && digitalRead(D2)==0;
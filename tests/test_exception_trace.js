@@ -0,0 +1,36 @@
+// Stack traces are recorded as frames and only formatted if printed - check catching lots of exceptions doesn't keep hold of anything
+function thrower(depth) {
+  if (depth<=0) throw new Error("bottom");
+  return thrower(depth-1) + 1;
+}
+function validate(str) {
+  try {
+    return JSON.parse(str);
+  } catch (e) {
+    return "bad";
+  }
+}
+function deep(n) {
+  try {
+    thrower(n);
+  } catch (e) {
+    return e instanceof Error;
+  }
+  return false;
+}
+
+var ok = true, i, after;
+deep(5); validate("{"); // warm up
+var before = process.memory().usage;
+for (i=0;i<50;i++) {
+  ok = ok && deep(i%5);
+  ok = ok && validate("{a:")=="bad" && validate("{\"a\":"+i+"}").a==i;
+}
+after = process.memory().usage;
+// an exception thrown from inside a catch block still works
+var nested = "";
+try {
+  try { thrower(3); } catch (e) { nested += "a"; throw "again"; }
+} catch (e) { nested += e; }
+
+result = ok && after<=before && nested=="aagain";
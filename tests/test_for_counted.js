@@ -0,0 +1,77 @@
+// Simple counted for loops are run natively - make sure they still behave like JS
+
+var r = [];
+function t(name, got, expected) {
+  if (got !== expected) console.log(name, "got", got, "expected", expected);
+  r.push(got === expected);
+}
+
+var s = 0;
+for (var i=0;i<10;i++) s+=i;
+t("sum", s, 45);
+t("after", i, 10);
+
+// the values the counter had must be separate from each other
+var saved = [], o = {};
+for (i=0;i<4;i++) { saved.push(i); var j = i; o.x = i; }
+t("saved", saved.join(), "0,1,2,3");
+t("copied", j, 3);
+t("property", o.x, 3);
+
+// body changes the counter
+var seen = [];
+for (i=0;i<10;i++) { seen.push(i); if (i==2) i+=3; }
+t("modified", seen.join(), "0,1,2,6,7,8,9");
+
+// counter turned into something else
+seen = [];
+for (i=0;i<3;i++) { seen.push(i); if (i==1) i=1.5; }
+t("float", seen.join(), "0,1,2.5");
+seen = [];
+for (i=0;i<3;i++) { seen.push(i); if (i==0) i="1"; }
+t("string", seen.join(), "0,2"); // "1"++ is 2
+
+// bounds that change or aren't integers
+var a = [1,2,3];
+seen = [];
+for (i=0;i<a.length;i++) { seen.push(a[i]); if (i==0) a.push(4); }
+t("growing", seen.join(), "1,2,3,4");
+s = 0;
+for (i=0;i<2.5;i++) s++;
+t("float bound", s, 3);
+s = 0;
+for (i=0;i<"5";i++) s++;
+t("string bound", s, 5);
+s = 0;
+var n = 4;
+for (i=0;i<=n;i++) s++;
+t("<=", s, 5);
+
+// other steps
+seen = [];
+for (i=10;i>=0;i-=4) seen.push(i);
+t("-=", seen.join(), "10,6,2");
+seen = [];
+for (i=3;i>0;--i) seen.push(i);
+t("--i", seen.join(), "3,2,1");
+seen = [];
+for (i=0;i<7;i+=3) seen.push(i);
+t("+=", seen.join(), "0,3,6");
+s = 0;
+for (i=0;i<5;++i) { if (i==1) continue; if (i==3) break; s+=i; }
+t("continue/break", s, 2);
+
+// overflowing integers become floats
+seen = [];
+for (i=2147483646;i<2147483649;i++) seen.push(i);
+t("overflow", seen.join(), "2147483646,2147483647,2147483648");
+
+// locals in functions
+function f(n) {
+  var total = 0;
+  for (var k=0;k<n;k++) total += k;
+  return total+","+k;
+}
+t("local", f(5), "10,5");
+
+result = r.every(function(x) { return x; });
@@ -0,0 +1,10 @@
+// Functions created from the same source text share one cached copy of it
+var src = "return a" + "+1";
+var f1 = new Function("a", src);
+var f2 = new Function("a", "return a+" + "1");
+var g = new Function("a", "return a+2");
+var s = E.getFunctionCacheStats();
+
+result = f1(1)==2 && f2(1)==2 && g(1)==3 &&
+         s.hits>=1 && s.size>=2 &&
+         eval("1+" + "2")==3;
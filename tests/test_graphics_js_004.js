@@ -0,0 +1,33 @@
+// Graphics.createCallback with a batched fillRects callback draws the same as setPixel
+
+var W = 32, H = 16;
+var a = new Uint8Array(W*H);
+var b = new Uint8Array(W*H);
+var batches = 0, rects = 0;
+
+var A = Graphics.createCallback(W,H,8,function (x,y,c) { a[x+y*W] = c; });
+var B = Graphics.createCallback(W,H,8,{
+  fillRects:function (r,n) {
+    batches++;
+    rects += n;
+    for (var i=0;i<n*5;i+=5)
+      for (var y=r[i+1];y<=r[i+3];y++)
+        for (var x=r[i];x<=r[i+2];x++)
+          b[x+y*W] = r[i+4];
+  }
+});
+
+function draw(g) {
+  g.setColor(3);
+  g.fillRect(1,1,6,4);
+  g.setColor(7);
+  g.drawLine(0,15,31,0);
+  g.drawString("Hi 42",8,6);
+  g.setColor(9);
+  g.fillPoly([20,2, 30,8, 22,14]);
+  g.setPixel(31,15,5);
+}
+draw(A);
+draw(B);
+
+result = a.join()==b.join() && batches>0 && rects<100;
@@ -0,0 +1,72 @@
+// HTTP server with routes matched natively
+
+var result = 0;
+var http = require("http");
+var got = [];
+
+var keys = [];
+var server = http.createServer(function (req, res) {
+  got.push("default "+req.url);
+  // the request's fields are normal enumerable properties, and the raw header text isn't visible
+  keys.push(Object.keys(req).filter(function(k) { return ["method","url","headers","query","hDat"].indexOf(k)>=0; }).sort().join(" "));
+  var json = JSON.parse(JSON.stringify(req));
+  keys.push(json.method+" "+json.url+" "+json.headers.Host);
+  res.end("default");
+});
+server.route("GET", "/", function (req, res) {
+  got.push("root");
+  res.end("root");
+});
+server.route("GET", "/led/:num/:state", function (req, res) {
+  got.push("led "+req.params.num+" "+req.params.state);
+  res.end("led");
+});
+server.route("get", "/say/:msg", function (req, res) {
+  got.push("say "+req.params.msg);
+  res.end("say");
+});
+server.route(undefined, "/files/*", function (req, res) {
+  got.push("files "+req.method+" "+req.url+" "+JSON.stringify(req.query)+" "+req.headers.Host);
+  var k = []; for (var i in req) k.push(i);
+  keys.push(k.indexOf("method")>=0 && k.indexOf("headers")>=0 && k.indexOf("hDat")<0);
+  res.end("files");
+});
+server.route("POST", "/", function (req, res) {
+  got.push("post");
+  res.end("post");
+});
+server.listen(8080);
+
+var server2 = http.createServer();
+server2.route("GET", "/x", function (req, res) { res.end("x"); });
+server2.listen(8081);
+
+var requests = [
+  "http://localhost:8080/",
+  "http://localhost:8080/led/1/on?x=1",
+  "http://localhost:8080/led/1",
+  "http://localhost:8080/files/a/b.txt?a=1&b=%20c",
+  "http://localhost:8080/files",
+  "http://localhost:8080/say/hello%20there%21",
+  "http://localhost:8080/files/q?a=%4",
+  "http://localhost:8080/say/50%",
+  "http://localhost:8081/nothing"
+];
+var statusCodes = [];
+
+function next() {
+  var url = requests.shift();
+  if (!url) {
+    server.close();
+    server2.close();
+    result = got.join(",") == "root,led 1 on,default /led/1,files GET /files/a/b.txt?a=1&b=%20c {\"a\":\"1\",\"b\":\" c\"} localhost:8080,default /files,say hello there!,files GET /files/q?a=%4 {\"a\":\"%4\"} localhost:8080,say 50%" &&
+             statusCodes.join(",") == "200,200,200,200,200,200,200,200,404" &&
+             keys.join(",") == "headers method query url,GET /led/1 localhost:8080,true,headers method query url,GET /files localhost:8080,true";
+    return;
+  }
+  http.get(url, function(res) {
+    statusCodes.push(res.statusCode);
+    res.on('close', next);
+  });
+}
+next();
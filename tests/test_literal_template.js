@@ -0,0 +1,34 @@
+// Array and object literals are created from cached templates after the first time - check each one is still a new value
+function consts() { return [1, -2, 3.5, -0.25, "str", true, false, null, undefined, [4, [5]], {a:1, "b c":[6]}, , 7]; }
+function obj(x, y) { return { x: x, y: y*2, 3: "three", "0x10": 16, z: [x] }; }
+function dups(x) { return { a: x, a: x+1 }; }
+function keys(x) { return { 1.5: x, true: x, null: x }; }
+
+var r = [], c;
+for (var i=0;i<3;i++) {
+  c = consts();
+  r.push(JSON.stringify(c) == '[1,-2,3.5,-0.25,"str",true,false,null,null,[4,[5]],{"a":1,"b c":[6]},null,7]');
+  r.push(c.length==13 && !(11 in c) && (8 in c));
+  // modifying what we got back mustn't change the next one
+  c[0] = "x"; c[9][1].push(6); c[10].a = 2; c[10]["b c"][0]++; c[4] += "ing"; c.push(8);
+  var o = obj(i, i+1);
+  r.push(JSON.stringify(o) == '{"x":'+i+',"y":'+(i+1)*2+',"3":"three","0x10":16,"z":['+i+']}');
+  r.push(Object.keys(o).join() == "x,y,3,0x10,z" && o[3]=="three");
+  o.x = "changed"; o.w = 1;
+  r.push(JSON.stringify(dups(i)) == '{"a":'+(i+1)+'}');
+  r.push(JSON.stringify(keys(i)) == '{"1.5":'+i+',"true":'+i+',"null":'+i+'}');
+}
+// exceptions part way through a literal
+function thrower(t) { if (t) throw "oops"; return 1; }
+function withThrow(t) { return { a: 1, b: thrower(t), c: 2 }; }
+var caught = "";
+for (i=0;i<3;i++) {
+  try { withThrow(i==1); } catch (e) { caught += e; }
+}
+r.push(caught == "oops" && withThrow(false).c == 2);
+// literals in the same place in different functions
+var f1 = new Function("return [1,2]"), f2 = new Function("return [3,4]");
+r.push(f1().join()+f2().join()+f1().join() == "1,23,41,2");
+r.push(JSON.stringify([[],{},[[]],{a:{}}]) == '[[],{},[[]],{"a":{}}]');
+
+result = r.every(function(x) { return x; });
@@ -0,0 +1,13 @@
+// E.on('lowMemory') should fire once free memory drops below a threshold
+
+var levels = [];
+E.on('lowMemory', function(level) { levels.push(level); });
+// 100% means we're always 'below' the first threshold
+E.setLowMemoryThresholds([100]);
+
+setTimeout(function() {
+  E.setLowMemoryThresholds();
+  var mem = process.memory();
+  result = levels.length==1 && levels[0]==1 &&
+           mem.usage>0 && mem.usage<mem.total && mem.free==mem.total-mem.usage;
+}, 10);
@@ -0,0 +1,62 @@
+// ES6 Map and Set
+var results = [];
+
+var m = new Map();
+var o = {a:1}, o2 = {a:1};
+m.set("a", 1).set(2, "two").set(o, "obj").set(undefined, "u").set(null, "n").set(true, "t");
+results.push(m.size==6);
+results.push(m.get("a")==1 && m.get(2)=="two" && m.get(o)=="obj" && m.get(o2)===undefined);
+results.push(m.get(undefined)=="u" && m.get(null)=="n" && m.get(true)=="t" && m.get(false)===undefined);
+// SameValueZero - 2.0 is the same key as 2, and NaN is the same as NaN
+results.push(m.get(4/2)=="two" && m.get("2")===undefined);
+m.set(NaN, "nan");
+results.push(m.get(0/0)=="nan");
+// strings are compared by value
+var s = "hel"; s += "lo";
+m.set("hello", "world");
+results.push(m.get(s)=="world" && m.has(s) && !m.has("hell"));
+// updating keeps the order, and doesn't change the size
+m.set("a", 11);
+results.push(m.size==8 && m.get("a")==11 && m.keys()[0]=="a");
+results.push(m.delete(o) && !m.delete(o) && m.size==7 && !m.has(o));
+results.push(JSON.stringify(m.keys())=='["a",2,null,null,true,NaN,"hello"]');
+results.push(JSON.stringify(m.entries()[1])=='[2,"two"]');
+var order = [];
+m.forEach(function(v,k,map) { order.push(v); if (k==2) map.delete(null); });
+results.push(order.join(",")=="11,two,u,t,nan,world");
+m.clear();
+results.push(m.size==0 && m.get("a")===undefined && m.keys().length==0);
+
+// lots of entries, with deletes
+var big = new Map();
+for (var i=0;i<500;i++) big.set("k"+i, i);
+for (var i=0;i<500;i+=2) big.delete("k"+i);
+var ok = big.size==250;
+for (var i=0;i<500;i++) if (big.get("k"+i)!==(i&1 ? i : undefined)) ok = false;
+results.push(ok && big.keys()[0]=="k1");
+for (var i=0;i<500;i++) big.delete("k"+i);
+results.push(big.size==0);
+
+// constructor
+var m2 = new Map([[1,"a"],[2,"b"]]);
+var m3 = new Map(m2);
+m2.set(3,"c");
+results.push(m3.size==2 && m3.get(2)=="b" && !m3.has(3));
+
+// Set
+var st = new Set([1,2,2,"x",1]);
+results.push(st.size==3 && st.has(2) && st.has("x") && !st.has(3));
+st.add(o).add(o).add(3);
+results.push(st.size==5 && st.values().join(",")==[1,2,"x",o,3].join(","));
+results.push(st.delete(2) && !st.has(2) && st.size==4);
+var sum = 0;
+st.forEach(function(a,b) { if (a===b && typeof a=="number") sum+=a; });
+results.push(sum==4);
+
+// Maps need [key, value] pairs
+var err = false;
+try { new Map([1,2]); } catch (e) { err = true; }
+results.push(err);
+
+result = results.every(function(x){return x;});
+if (!result) console.log(results);
@@ -0,0 +1,29 @@
+// Cloning a Map or Set gives it its own hash table, so changing one never affects the other
+var m = new Map();
+for (var i=0;i<20;i++) m.set("k"+i, i);
+var c = m.clone();
+// delete most of the copy, then add enough to rehash it
+for (var i=0;i<15;i++) c.delete("k"+i);
+for (var i=100;i<140;i++) c.set("k"+i, i);
+var origOk = m.size==20 && m.get("k3")==3 && m.get("k19")==19 && !m.has("k100");
+var keys = []; m.forEach(function(v,k) { keys.push(k); });
+origOk = origOk && keys.length==20 && keys[0]=="k0" && keys[19]=="k19";
+var copyOk = c.size==45 && !c.has("k3") && c.get("k19")==19 && c.get("k139")==139;
+// and the other way round
+for (var i=0;i<20;i++) m.delete("k"+i);
+for (var i=200;i<260;i++) m.set("k"+i, i);
+copyOk = copyOk && c.size==45 && c.get("k16")==16 && c.get("k120")==120 && !c.has("k200");
+origOk = origOk && m.size==60 && m.get("k259")==259 && !m.has("k16");
+
+var s = new Set([1,2,3,"a"]);
+var sc = s.clone();
+sc.delete(2);
+for (var i=10;i<50;i++) sc.add(i);
+var setOk = s.size==4 && s.has(2) && !s.has(10) && sc.size==43 && !sc.has(2) && sc.has("a") && sc.has(49);
+
+// an empty Map has nothing to copy
+var e = new Map().clone();
+e.set("x", 1);
+var emptyOk = e.size==1 && e.get("x")==1;
+
+result = origOk && copyOk && setOk && emptyOk;
@@ -0,0 +1,27 @@
+// Built-in classes keeping their internal state in a hidden native block
+var w = new Waveform(16);
+var keysOk = Object.keys(w).join()=="buffer" && JSON.stringify(w)=='{"buffer":new Uint8Array(16)}';
+var finished = false;
+w.on("finish", function() { finished = true; });
+w.startOutput(D1, 2000); // 16 samples - finishes after 8ms
+var alreadyRunning = false;
+try { w.startOutput(D1, 2000); } catch (e) { alreadyRunning = true; }
+var notAWaveform = false;
+try { w.stop.call({}); } catch (e) { notAWaveform = true; }
+
+// Another class's native state mustn't be read as ours
+var m = new Map([["a",1],["b",2]]);
+var mapNotWaveform = 0;
+try { w.stop.call(m); } catch (e) { mapNotWaveform++; }
+try { w.startOutput.call(m, D1, 2000); } catch (e) { mapNotWaveform++; }
+var waveformNotMap = false;
+try { m.get.call(w, "a"); } catch (e) { waveformNotMap = e instanceof TypeError; }
+var mapOk = m.size==2 && m.get("b")==2 && !m.running;
+
+var ow = new OneWire(D2);
+var owOk = ow.pin==D2 && Object.keys(ow).join()=="pin";
+
+setTimeout(function() {
+  result = keysOk && finished && alreadyRunning && notAWaveform && owOk && !w.running &&
+           mapNotWaveform==2 && waveformNotMap && mapOk;
+}, 50);
@@ -0,0 +1,27 @@
+// Many clients connecting at once should all be accepted - some in the same idle pass
+
+var net = require("net");
+var COUNT = 40; // more than 32 sockets at once
+var answered = 0;
+var connections = 0;
+
+var server = net.createServer(function(c) {
+  connections++;
+  c.write("ok");
+  c.end();
+});
+server.listen(4447, {backlog:64, maxAccept:8});
+
+function connect() {
+  var client = net.connect({host:"127.0.0.1", port:4447}, function() {
+    client.on('data', function(data) {
+      if (data=="ok") answered++;
+      if (answered==COUNT) {
+        server.close();
+        result = connections==COUNT;
+      }
+    });
+  });
+}
+
+for (var i=0;i<COUNT;i++) connect();
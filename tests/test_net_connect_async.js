@@ -0,0 +1,44 @@
+// Client connects (and name lookups) shouldn't block - timers keep running and failures arrive as 'error' events
+
+var net = require("net");
+var results = [];
+var ticks = 0;
+var ticker = setInterval(function() { ticks++; }, 1);
+
+var server = net.createServer(function(c) {
+  c.write("ok");
+  c.end();
+});
+server.listen(4445);
+
+function done() {
+  clearInterval(ticker);
+  server.close();
+  console.log(results, ticks);
+  result = results.join(",")=="localhost:ok,localhost:ok,127.0.0.1:ok,refused" && ticks>0;
+}
+
+function get(host, next) {
+  var client = net.connect({host:host, port:4445}, function() {
+    client.on('data', function(data) {
+      results.push(host+":"+data);
+      next();
+    });
+  });
+}
+
+// the first lookup of 'localhost' happens on another thread, the second comes from the cache
+get("localhost", function() {
+  get("localhost", function() {
+    get("127.0.0.1", function() {
+      // nothing listening here - connect should fail without blocking
+      var c = net.connect({host:"127.0.0.1", port:4446}, function() {
+        results.push("connected?");
+      });
+      c.on('error', function(e) {
+        if (e.message=="connection refused") results.push("refused");
+        done();
+      });
+    });
+  });
+});
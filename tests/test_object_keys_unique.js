@@ -0,0 +1,15 @@
+// Object.keys / getOwnPropertyNames should list each key once, even when
+// an own property shadows a builtin
+var o = {};
+for (var i=0;i<100;i++) o["k"+i] = i;
+var keys = Object.keys(o);
+
+String.prototype.indexOf2 = 1;
+var oldIndexOf = String.prototype.indexOf;
+String.prototype.indexOf = function(x) { return oldIndexOf.call(this,x); };
+var names = Object.getOwnPropertyNames(String.prototype);
+var count = names.filter(function(n) { return n=="indexOf"; }).length;
+
+result = keys.length==100 && keys[0]=="k0" && keys[99]=="k99" &&
+         names.indexOf("indexOf2")>=0 && count==1 &&
+         Object.getOwnPropertyNames([1,2]).join()=="0,1,length";
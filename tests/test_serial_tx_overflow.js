@@ -0,0 +1,78 @@
+// Serial.setup's txOverflow option stops writes blocking when the output buffer is full.
+// Serial1 writes to a file here, so we can check what was actually sent.
+// Every byte written must either be sent or counted as dropped.
+
+var fs = require("fs");
+var FILE = "tests/serial_tx_overflow.tmp";
+
+function data(len) {
+  var s = "", i = 0;
+  while (s.length < len) s += (i++).toString(36) + ",";
+  return s.substr(0, len);
+}
+var big = data(4096);
+var small = data(1024); // fits in the transmit buffer + queue
+
+var threw = [];
+[{ txOverflow : "sometimes" }, { txOverflow : "queue", unknownOption : 1 }].forEach(function(opts) {
+  try {
+    Serial1.setup(9600, opts);
+  } catch (e) {
+    threw.push(true);
+  }
+});
+
+Serial1.setup(9600);
+var blockDropped = Serial1.getDropped();
+
+var results = [];
+var steps = [
+  ["dropNewest", big, function(sent, d) {
+    // the oldest data always gets sent
+    return d>0 && sent.length+d==big.length && sent.substr(0,200)==big.substr(0,200);
+  }],
+  ["dropOldest", big, function(sent, d) {
+    // the newest data always gets sent
+    return d>0 && sent.length+d==big.length && sent.substr(-200)==big.substr(-200);
+  }],
+  ["queue", small, function(sent, d) {
+    // nothing lost, and all in order
+    return d==0 && sent==small;
+  }],
+  ["queue", big, function(sent, d) {
+    return d>0 && sent.length+d==big.length && sent.substr(0,200)==big.substr(0,200);
+  }]
+];
+
+function next() {
+  var step = steps.shift();
+  if (!step) return done();
+  fs.writeFileSync(FILE, "");
+  Serial1.setup(9600, { txOverflow : step[0], path : FILE });
+  Serial1.write(step[1]);
+  var d = Serial1.getDropped();
+  // bad options mustn't reset the policy or the dropped count
+  try { Serial1.setup(9600, { txOverflow : "sometimes" }); } catch (e) {}
+  try { Serial1.setup(9600, { unknownOption : 1 }); } catch (e) {}
+  var kept = Serial1.getDropped()==d;
+  setTimeout(function() {
+    var sent = fs.readFileSync(FILE);
+    var r = kept && Serial1.getDropped()==d && step[2](sent, d);
+    console.log(step[0], step[1].length, "sent", sent.length, "dropped", d, r);
+    results.push(r);
+    next();
+  }, 300);
+}
+
+function done() {
+  // setup with no options uses the ones we saved before
+  Serial1.setup(9600);
+  var savedMode = Serial1._options.txOverflow;
+  // back to the default
+  Serial1.setup(9600, {});
+  fs.unlink(FILE);
+  result = threw.length==2 && blockDropped==0 && results.join(",")=="true,true,true,true" &&
+           savedMode=="queue" && Serial1.getDropped()==0;
+}
+
+next();
@@ -0,0 +1,31 @@
+// Template-style concatenation, where temporary strings get appended to in place
+
+function render(item) {
+  return "<li id=\"" + item.id + "\">" + item.name + " (" + item.count + ")</li>\n";
+}
+
+var items = [];
+for (var i=0;i<20;i++) items.push({ id : "item"+i, name : "Name number "+i, count : i*3 });
+
+var html = "<ul>\n";
+items.forEach(function(item) { html += render(item); });
+html += "</ul>";
+
+var parts = ["<ul>\n"];
+for (var i=0;i<20;i++)
+  parts.push("<li id=\"item",i,"\">Name number ",i," (",i*3,")</li>\n");
+parts.push("</ul>");
+var expected = parts.join("");
+
+// Make sure we never modify strings that are referenced elsewhere
+var a = "Hello";
+var b = a + " World";
+var c = b + "!";
+var d = 1 + "2" + 3;
+var s = "abcdefghijklmnopqrstuvwxyz";
+s += s;
+
+result = html == expected &&
+         a == "Hello" && b == "Hello World" && c == "Hello World!" &&
+         d == "123" &&
+         s == "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz";
@@ -0,0 +1,81 @@
+// switch statements with literal labels use a cached jump table - check they behave like the ones that don't
+function lit(x) {
+  var r = "";
+  switch (x) {
+    case 1: r += "a";
+    case "1": r += "b"; break;
+    case -2: r += "c"; break;
+    case 2.5: r += "d";
+    default: r += "e";
+    case 3: r += "f"; break;
+    case 1: r += "dup"; break;
+  }
+  return r;
+}
+var one = 1;
+function expr(x) {
+  var r = "";
+  switch (x) {
+    case one: r += "a";
+    case String(one): r += "b"; break;
+    case -one*2: r += "c"; break;
+    case 5/2: r += "d";
+    default: r += "e";
+    case one+2: r += "f"; break;
+  }
+  return r;
+}
+var inputs = [1, "1", -2, 2.5, 3, 4, "x", 1.0, undefined];
+var a = inputs.map(lit).join(), b = inputs.map(expr).join();
+
+// labels that start with a literal but are expressions
+function litExpr(x) {
+  switch (x) {
+    case 1*2: return "two";
+    case 1?5:6: return "five";
+    case -1+4: return "three";
+    case "a"+"b": return "ab";
+    case 7: return "seven";
+  }
+  return "other";
+}
+var litExprOk = litExpr(2)=="two" && litExpr(5)=="five" && litExpr(3)=="three" &&
+                litExpr("ab")=="ab" && litExpr(7)=="seven" && litExpr(1)=="other" && litExpr(6)=="other";
+
+// labels are evaluated in order, and only until one matches
+var evaluated = [];
+function lbl(n) { evaluated.push(n); return n; }
+switch (2) { case lbl(1): case lbl(2): case lbl(3): }
+
+function ret(x) { switch (x) { case 1: return "one"; case 2: return "two"; } return "other"; }
+
+// continue and break inside loops inside switches, and nested switches
+var s = "";
+for (var i=0;i<4;i++) {
+  switch (i) {
+    case 0: continue;
+    case 1: for (var j=0;j<5;j++) { if (j==2) break; s += j; } break;
+    case 2: switch (i*2) { case 4: s += "n"; break; default: s += "?"; } s += "m"; break;
+    default: s += "d";
+  }
+  s += ",";
+}
+
+// more switches than fit in the cache
+var many = "";
+for (var k=0;k<20;k++) many += "function sw"+k+"(x){switch(x){case "+k+":return 'y';default:return 'n';}}";
+eval(many);
+var manyOk = true;
+for (var pass=0;pass<2;pass++)
+  for (var k=0;k<20;k++)
+    if (eval("sw"+k)(k)!="y" || eval("sw"+k)(k+1)!="n") manyOk = false;
+
+// a switch that is skipped after it has been cached
+var skipped = 0;
+function maybe(go) { if (go) { switch (1) { case 1: skipped++; break; } } return skipped; }
+maybe(true); maybe(false); maybe(true);
+
+result = a=="ab,b,c,def,f,ef,ef,ab,ef" && a==b &&
+         evaluated.join()=="1,2" &&
+         ret(1)=="one" && ret(2)=="two" && ret(3)=="other" &&
+         s=="01,nm,d," && manyOk && skipped==2 && litExprOk;
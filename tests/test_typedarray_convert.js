@@ -0,0 +1,53 @@
+// Typed array conversion kernels (set/constructor/slice) must match element-by-element copying
+var types = [Uint8Array, Uint8ClampedArray, Int8Array, Uint16Array, Int16Array, Uint32Array, Int32Array, Float32Array, Float64Array];
+var values = [0,1,-1,127,128,255,256,-129,32767,-32769,65535,70000,2147483647,-2147483648,4294967295,1.5,-2.5,254.7,NaN];
+var results = [];
+
+function same(a,b) {
+  if (a.length!=b.length) return false;
+  for (var i=0;i<a.length;i++)
+    if (a[i]!==b[i] && !(isNaN(a[i]) && isNaN(b[i]))) return false;
+  return true;
+}
+
+[4, 64].forEach(function(n) { // small arrays may not be contiguous, so use the generic path
+  types.forEach(function(S) {
+    var src = new S(n);
+    for (var i=0;i<n;i++) src[i] = values[i%values.length];
+    types.forEach(function(D) {
+      var expected = new D(n);
+      for (var i=0;i<n;i++) expected[i] = src[i];
+      var a = new D(n);
+      a.set(src);
+      var b = new D(src);
+      var ok = same(a, expected) && same(b, expected);
+      if (!ok) console.log("Mismatch", S, D, n, a, expected);
+      results.push(ok);
+    });
+  });
+});
+
+// set with an offset, and overlapping copies
+var a = new Uint8Array(400);
+for (var i=0;i<400;i++) a[i]=i;
+a.set(new Uint8Array(a.buffer, 0, 300), 5);
+results.push(a[4]==4 && a[5]==0 && a[6]==1 && a[304]==(299&255) && a[305]==(305&255));
+var f = new Float32Array(20);
+f.set(new Float64Array([1.5,2.5,3.5]), 18);
+results.push(f[17]==0 && f[18]==1.5 && f[19]==2.5);
+
+// Uint8ClampedArray saturates
+var c = new Uint8ClampedArray(40);
+c.set(new Float64Array([1e10, Infinity, -Infinity, NaN, -5, 300, 12.7]));
+results.push(c[0]==255 && c[1]==255 && c[2]==0 && c[3]==0 && c[4]==0 && c[5]==255 && c[6]==12);
+
+// slice returns the same type
+var s = new Int16Array([1,-2,3,-4,5]).slice(1,-1);
+results.push(s instanceof Int16Array && s.length==3 && s[0]==-2 && s[2]==-4);
+results.push(new Float64Array(50).slice(-2).length==2 && new Uint8Array(5).slice(3,1).length==0);
+
+// map
+var m = new Int8Array([1,2,3]).map(function(v,i) { return v*100+i; });
+results.push(m instanceof Int8Array && m[0]==100 && m[1]==-55 && m[2]==46);
+
+result = results.every(function(x){return x;});
@@ -0,0 +1,5 @@
+// A '%' that isn't followed by two hex digits (before the end of the query string) is kept as-is
+var a = url.parse("/a?x=%&y=%4&z=%41&w=%zz",true).query;
+var b = url.parse("/a?q=%",true).query;
+var c = url.parse("/a?q=%4",true).query;
+result = a.x=="%" && a.y=="%4" && a.z=="A" && a.w=="%zz" && b.q=="%" && c.q=="%4";
@@ -0,0 +1,21 @@
+// digitalPulse and setTime on a target whose util timer runs in a thread
+var edges = [];
+setWatch(function(e) { edges.push(e.time); }, D3, {repeat:true, edge:"both"});
+var t = getTime();
+digitalPulse(D3, 1, [5,5,5]);
+var returnedAtOnce = (getTime()-t) < 0.004 && digitalRead(D3)==1;
+
+setTimeout(function() {
+  // edges can't be early, but the timer thread may get scheduled a little late
+  var widthsOk = edges.length==4;
+  for (var i=1;i<edges.length;i++) {
+    var t = (edges[i]-edges[0])*1000;
+    if (t<i*5-0.5 || t>i*5+10) widthsOk = false;
+  }
+  // setting the clock moves getTime(), and pulses still run afterwards
+  setTime(1000);
+  var clockSet = Math.abs(getTime()-1000) < 0.1;
+  digitalPulse(D3, 1, 5);
+  digitalPulse(D3, 1, 0); // wait for it to finish
+  result = returnedAtOnce && widthsOk && clockSet && edges.length==4 && digitalRead(D3)==0;
+}, 100);
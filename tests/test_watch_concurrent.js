@@ -0,0 +1,29 @@
+// More watches than the old fixed table held (32), with pin events pushed from the util timer
+// thread (digitalPulse) while the main thread is pushing its own (digitalWrite)
+var WATCHES = 40;
+var hitsA = [], hitsB = [];
+for (var i=0;i<WATCHES;i++) {
+  hitsA.push(0);
+  hitsB.push(0);
+  (function(n) {
+    setWatch(function(e) { hitsA[n]++; }, D10, {repeat:true, edge:"rising"});
+    setWatch(function(e) { hitsB[n]++; }, D11, {repeat:true, edge:"rising"});
+  })(i);
+}
+
+digitalWrite(D11,0);
+// 5 pulses on D11 from the timer thread, over ~10ms
+digitalPulse(D11, 1, [1,1,1,1,1,1,1,1,1]);
+// ...while we toggle D10 10 times over the same time
+for (var j=0;j<10;j++) {
+  var t = getTime()+0.001;
+  while (getTime()<t);
+  digitalWrite(D10,1);
+  digitalWrite(D10,0);
+}
+
+setTimeout(function() {
+  result = hitsA.every(function(h) { return h==10; }) &&
+           hitsB.every(function(h) { return h==5; });
+  clearWatch();
+}, 100);
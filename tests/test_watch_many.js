@@ -0,0 +1,21 @@
+// There's no fixed limit on the number of watches - the native table grows as needed,
+// even when a watch callback adds more watches while pin events are being handled
+
+var count = 0, other = 0, added = false;
+setWatch(function(e) {
+  if (added) return;
+  added = true;
+  for (var i=0;i<50;i++)
+    setWatch(function(e) { other++; }, D9, {repeat:true, edge:"rising"});
+}, D8, {repeat:true, edge:"rising"});
+for (var i=0;i<100;i++)
+  setWatch(function(e) { count++; }, D8, {repeat:true, edge:"rising"});
+
+digitalWrite(D8,1);
+setTimeout(function() {
+  digitalWrite(D9,1);
+  setTimeout(function() {
+    result = count==100 && other==50;
+    clearWatch();
+  }, 50);
+}, 50);
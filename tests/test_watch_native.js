@@ -0,0 +1,27 @@
+// setWatch driven by pin change events (on Linux, writing to a watched pin pushes an EXTI event)
+var events = [];
+setWatch(function(e) { events.push("r"+(e.state?1:0)); }, D5, {repeat:true, edge:"rising"});
+setWatch(function(e) { events.push("o"+(e.state?1:0)+(e.lastTime===undefined)); }, D5, false); // one-shot
+var id = setWatch(function(e) { events.push("c"); clearWatch(id); }, D5, {repeat:true}); // clears itself
+var debounced = [];
+setWatch(function(e) { debounced.push(e.state); }, D6, {repeat:true, edge:"both", debounce:20});
+var cancelled = false;
+var dId = setWatch(function(e) { cancelled = true; }, D7, {repeat:true, debounce:20});
+
+digitalWrite(D5,1);
+digitalWrite(D5,0);
+digitalWrite(D5,1);
+// bouncing pin - should only fire once it settles
+digitalWrite(D6,1);
+digitalWrite(D6,0);
+digitalWrite(D6,1);
+// debounce pending, but the watch is cleared before it fires
+digitalWrite(D7,1);
+clearWatch(dId);
+
+setTimeout(function() {
+  result = events.join(",")=="r1,o1true,c,r1" &&
+           debounced.length==1 && debounced[0]===true &&
+           !cancelled;
+  clearWatch();
+}, 100);